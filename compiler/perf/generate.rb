@@ -1,6 +1,8 @@
-OUT_H = 'messages.hpp'
-OUT_CPP = 'messages.cpp'
-OUT_CALL_CPP = 'messages_call.cpp'
+# generates NUM_MESSAGES random messages in two forms:
+# messages*.* with the per-arity macros and messages_v*.* with the variadic macros
+# both forms declare the same messages
+
+NUM_MESSAGES = (ARGV[0] || 1024).to_i
 
 MAX_ARITY = File.open('../../gen/arity').read.strip.to_i + 1
 
@@ -10,7 +12,7 @@ TYPES = [
   ['char', 42],
   ['size_t', 456],
   ['const char*', "some string"],
-  ['int*', 0],
+  ['int*', :nullptr], # a literal 0 would not be forwarded as a null pointer
   ['const std::string&', "test2"],
   ['std::string', "test asd"]]
 
@@ -33,10 +35,11 @@ HEAD = <<DATA
 DATA
 
 header = ''
+header_v = ''
 cpp = ''
 call_cpp = ''
 
-1024.times do |i|
+NUM_MESSAGES.times do |i|
   arity = rnd.rand(MAX_ARITY)
   const = rnd.rand(2) == 0 ? 'CONST_' : ''
   multi = rnd.rand(2) == 0 ? 'MULTICAST_' : ''
@@ -44,39 +47,53 @@ call_cpp = ''
 
   header += "DYNAMIX_#{const}#{multi}MESSAGE_#{arity}(#{ret}, message_#{i}"
   call_cpp += "    message_#{i}(o";
+  arg_types = []
 
   arity.times do |a|
     type = TYPES.sample(random: rnd)
     header += ", #{type[0]}, arg_#{a}"
-    call_cpp += ", #{type[1].inspect}"
+    call_cpp += ", #{type[1].is_a?(Symbol) ? type[1] : type[1].inspect}"
+    arg_types << type[0]
   end
 
   header += ");\n"
+  header_v += "DYNAMIX_#{const}#{multi}MESSAGE_V(message_#{i}, #{ret}(#{arg_types.join(', ')}));\n"
   call_cpp += ");\n";
 
   cpp += "DYNAMIX_DEFINE_MESSAGE(message_#{i});\n"
 end
 
-File.open(OUT_H, 'w') do |f|
-  f.write(HEAD)
-  f.puts '#pragma once'
-  f.puts '#include <dynamix/dynamix.hpp>'
-  f.puts
-  f.puts(header)
-end
+def write_files(suffix, includes, header, cpp, call_cpp)
+  out_h = "messages#{suffix}.hpp"
 
-File.open(OUT_CPP, 'w') do |f|
-  f.write(HEAD)
-  f.puts "#include \"#{OUT_H}\""
-  f.puts
-  f.puts(cpp)
-end
+  File.open(out_h, 'w') do |f|
+    f.write(HEAD)
+    f.puts '#pragma once'
+    includes.each { |inc| f.puts inc }
+    f.puts
+    f.puts(header)
+  end
 
-File.open(OUT_CALL_CPP, 'w') do |f|
-  f.write(HEAD)
-  f.puts "#include \"#{OUT_H}\""
-  f.puts
-  f.puts "void make_calls(dynamix::object& o) {\n"
-  f.puts(call_cpp)
-  f.puts "}\n"
+  File.open("messages#{suffix}.cpp", 'w') do |f|
+    f.write(HEAD)
+    f.puts "#include \"#{out_h}\""
+    f.puts
+    f.puts(cpp)
+  end
+
+  File.open("messages#{suffix}_call.cpp", 'w') do |f|
+    f.write(HEAD)
+    f.puts "#include \"#{out_h}\""
+    f.puts
+    f.puts "void make_calls(dynamix::object& o) {\n"
+    f.puts(call_cpp)
+    f.puts "}\n"
+  end
 end
+
+write_files('', ['#include <dynamix/dynamix.hpp>'], header, cpp, call_cpp)
+write_files('_v', [
+  '#define DYNAMIX_NO_MESSAGE_MACROS',
+  '#include <dynamix/dynamix.hpp>',
+  '#include <dynamix/declare_message_variadic.hpp>'
+  ], header_v, cpp, call_cpp)
@@ -0,0 +1,63 @@
+# measures the preprocessing and compilation time of message declarations
+# for the different message macro forms
+#
+# usage: ruby measure.rb [num_messages] [compiler flags]
+# the compiler is taken from the CXX environment variable (c++ by default)
+#
+# the files are generated by generate.rb with num_messages messages (1000 by default)
+# the time of a translation unit which includes the core DynaMix headers and no
+# messages is subtracted, so the numbers are only for the messages
+
+require 'benchmark'
+require 'tmpdir'
+
+NUM_MESSAGES = (ARGV[0] || 1000).to_i
+EXTRA_FLAGS = ARGV[1..-1].join(' ')
+CXX = ENV['CXX'] || 'c++'
+INCLUDE = File.expand_path('../../include', __dir__)
+REPEAT = 5
+
+Dir.chdir(__dir__)
+system("ruby generate.rb #{NUM_MESSAGES}") or abort 'generation failed'
+
+# name, header include source, calls source, defines
+FORMS = [
+  ['per-arity macros', 'messages_main.cpp', 'messages_call.cpp', ''],
+  ['legacy macros', 'messages_main.cpp', 'messages_call.cpp', '-DDYNAMIX_USE_LEGACY_MESSAGE_MACROS'],
+  ['variadic macros', 'messages_v_main.cpp', 'messages_v_call.cpp', ''],
+]
+
+def compile_time(source, flags)
+  cmd = "#{CXX} -std=c++11 -I#{INCLUDE} #{EXTRA_FLAGS} #{flags} #{source} -o #{File::NULL}"
+  # take the best of several runs to reduce noise
+  REPEAT.times.map do
+    Benchmark.realtime { system(cmd) or abort "failed: #{cmd}" }
+  end.min
+end
+
+Dir.mktmpdir do |dir|
+  # only the core headers and no messages
+  core = File.join(dir, 'core.cpp')
+  File.write(core, "#define DYNAMIX_NO_MESSAGE_MACROS\n#include <dynamix/dynamix.hpp>\nint main() { return 0; }\n")
+  core_pp = compile_time(core, '-E')
+  core_cc = compile_time(core, '-c')
+
+  puts "#{CXX} #{EXTRA_FLAGS}"
+  puts 'milliseconds per 1000 messages'
+  puts 'declaration: a translation unit which only includes the messages'
+  puts 'calls: the additional time for a translation unit which calls each message once'
+  puts
+  puts '| form | declaration preprocess | declaration compile | calls compile |'
+  puts '|------|-----------------------:|--------------------:|--------------:|'
+
+  scale = 1000.0 * 1000.0 / NUM_MESSAGES
+
+  FORMS.each do |name, main, calls, defines|
+    decl_pp = compile_time(main, "#{defines} -E")
+    decl_cc = compile_time(main, "#{defines} -c")
+    calls_cc = compile_time(calls, "#{defines} -c")
+
+    printf("| %s | %.0f | %.0f | %.0f |\n", name,
+      (decl_pp - core_pp) * scale, (decl_cc - core_cc) * scale, (calls_cc - decl_cc) * scale)
+  end
+end
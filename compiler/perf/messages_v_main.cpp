@@ -0,0 +1,6 @@
+#include "messages_v.hpp"
+
+int main()
+{
+    return 0;
+}
@@ -42,7 +42,10 @@ def params_for_arity(arity)
   return {
     :arity => 0, :args => '', :arg_types => '', :args_coma => '', :args_signature => '',
     :coma_args_signature => '',
-    :coma_args => '', :coma_arg_types => '', :fwd_args => '', :coma_fwd_args => ''
+    :coma_args => '', :coma_arg_types => '', :fwd_args => '', :coma_fwd_args => '',
+    :coma_caller_args_signature => '', :caller_fwd_args => '',
+    :coma_msg_caller_arg_types => '', :coma_msg_caller_args_signature => '', :msg_caller_fwd_args => '',
+    :coma_multicast_args_signature => ''
   } if arity == 0
 
   args = []
@@ -57,6 +60,15 @@ def params_for_arity(arity)
   args_coma = ', ' + arg_types.zip(args).flatten.join(', ')
   args_signature = arg_types.zip(args).map { |tuple| tuple.join(' ') }. join(', ')
   fwd_args = arg_types.zip(args).map { |type, arg| "std::forward<#{type}>(#{arg})" }. join(', ')
+
+  # the callers take the arguments as the message struct passes them (see caller_arg)
+  caller_types = arg_types.map { |type| "caller_arg<#{type}>" }
+  caller_args_signature = caller_types.zip(args).map { |tuple| tuple.join(' ') }. join(', ')
+  caller_fwd_args = caller_types.zip(args).map { |type, arg| "std::forward<#{type}>(#{arg})" }. join(', ')
+  msg_caller_types = caller_types.map { |type| "I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::#{type}" }
+  msg_caller_args_signature = msg_caller_types.zip(args).map { |tuple| tuple.join(' ') }. join(', ')
+  msg_caller_fwd_args = msg_caller_types.zip(args).map { |type, arg| "std::forward<#{type}>(#{arg})" }. join(', ')
+  multicast_args_signature = arg_types.zip(args).map { |type, arg| "::dynamix::internal::multicast_arg<#{type}> #{arg}" }. join(', ')
   args = args.join(', ')
   arg_types = arg_types.join(', ')
 
@@ -64,7 +76,11 @@ def params_for_arity(arity)
     :arity => arity, :args => args, :arg_types => arg_types, :args_coma => args_coma, :args_signature => args_signature,
     :coma_args_signature => ', ' + args_signature,
     :coma_args => ', ' + args, :coma_arg_types => ', ' + arg_types,
-    :fwd_args => fwd_args, :coma_fwd_args => ', ' + fwd_args
+    :fwd_args => fwd_args, :coma_fwd_args => ', ' + fwd_args,
+    :coma_caller_args_signature => ', ' + caller_args_signature, :caller_fwd_args => caller_fwd_args,
+    :coma_msg_caller_arg_types => ', ' + msg_caller_types.join(', '),
+    :coma_msg_caller_args_signature => ', ' + msg_caller_args_signature, :msg_caller_fwd_args => msg_caller_fwd_args,
+    :coma_multicast_args_signature => ', ' + multicast_args_signature
   }
 
 end
@@ -0,0 +1,175 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * A mixin allocator which picks the storage of each mixin by its live population.
+ */
+
+#include "config.hpp"
+#include "allocators.hpp"
+#include "mixin_id.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+#include <mutex>
+#endif
+
+namespace dynamix
+{
+
+/// A domain allocator which serves rare mixins from the heap and switches popular ones
+/// to pools of fixed size slots, and back when they become rare again.
+///
+/// Each mixin is watched separately: its live instances allocated by this allocator
+/// and its rate of allocations. Mixins start on the heap. A mixin is switched to a pool when
+/// its population or allocation rate reaches the thresholds of the policy and back to the heap
+/// when both drop below the lower ones. Instances stay where they were allocated
+/// (unless migrated with `migrate`), so a mixin may have instances in both storages.
+/// The pool of a mixin is released when it's on the heap and none of its instances are pooled.
+///
+/// It can be set to a domain (or globally) or to individual mixins as a feature:
+/// `DYNAMIX_DEFINE_MIXIN(enemy, allocator<adaptive_allocator>() & ...)`
+class DYNAMIX_API adaptive_allocator : public domain_allocator
+{
+public:
+    enum class strategy
+    {
+        heap,
+        pool,
+    };
+
+    struct policy
+    {
+        /// A mixin is switched to a pool when it has this many live instances...
+        size_t pool_population = 256;
+        /// ...or when it's allocated this many times per second (0 to ignore the rate)
+        size_t pool_allocation_rate = 10000;
+
+        /// A pooled mixin is switched to the heap when it has this many live instances or fewer
+        /// and its allocation rate is below half of the pool one
+        size_t heap_population = 32;
+
+        /// Number of slots in the first chunk of a pool. Each next one is twice as big.
+        size_t first_chunk_slots = 64;
+
+        /// The period over which the allocation rate is measured
+        std::chrono::milliseconds rate_window = std::chrono::milliseconds(1000);
+    };
+
+    /// A switch of a mixin from one strategy to the other
+    struct decision
+    {
+        mixin_id id;
+        strategy to;
+        size_t population; // live instances at the time
+        size_t allocation_rate; // per second, in the last full window
+    };
+
+    struct mixin_stats
+    {
+        strategy current = strategy::heap;
+        size_t population = 0; // live instances
+        size_t pooled = 0; // live instances in the pool
+        size_t pool_capacity = 0; // slots in the pool
+        size_t allocation_rate = 0; // per second, in the last full window
+        size_t num_switches = 0;
+    };
+
+    /// Number of decisions which are kept
+    static const size_t MAX_DECISIONS = 256;
+
+    adaptive_allocator();
+    explicit adaptive_allocator(const policy& p);
+    ~adaptive_allocator();
+
+    adaptive_allocator(const adaptive_allocator&) = delete;
+    adaptive_allocator& operator=(const adaptive_allocator&) = delete;
+
+    virtual char* alloc_mixin_data(size_t count, const object* obj) override;
+    virtual void dealloc_mixin_data(char* ptr, size_t count, const object* obj) override;
+    virtual std::pair<char*, size_t> alloc_mixin(const mixin_type_info& info, const object* obj) override;
+    virtual void dealloc_mixin(char* ptr, size_t mixin_offset, const mixin_type_info& info, const object* obj) override;
+
+    const policy& get_policy() const { return _policy; }
+
+    /// Current strategy of a mixin
+    strategy strategy_of(mixin_id id) const;
+
+    mixin_stats stats(mixin_id id) const;
+
+    /// The last decisions (up to `MAX_DECISIONS`), oldest first
+    std::vector<decision> decisions() const;
+
+#if DYNAMIX_OBJECT_REPLACE_MIXIN
+    /// Moves the mixins of an object which were allocated by this allocator, but not with the
+    /// current strategy of their mixin, to new buffers with their move constructors.
+    /// Mixins without a move constructor are left where they are.
+    /// Returns the number of moved mixins.
+    /// Like a mutation, it must not be called while other threads use the object.
+    size_t migrate(object& obj);
+#endif
+
+private:
+    struct chunk
+    {
+        char* memory;
+        size_t num_slots;
+    };
+
+    struct mixin_state
+    {
+        strategy current = strategy::heap;
+        size_t slot_size = 0;
+        size_t population = 0;
+        size_t pooled = 0;
+        size_t num_switches = 0;
+
+        // sorted by address
+        std::vector<chunk> chunks;
+        size_t pool_capacity = 0;
+        char* free_slots = nullptr; // a list through the first bytes of the free slots
+
+        size_t window_allocations = 0;
+        std::chrono::steady_clock::time_point window_start;
+        size_t allocation_rate = 0;
+    };
+
+    mixin_state& state_for(const mixin_type_info& info);
+    const mixin_state* find_state(mixin_id id) const;
+
+    void update_rate(mixin_state& state, std::chrono::steady_clock::time_point now);
+    void switch_to(mixin_id id, mixin_state& state, strategy s);
+
+    // allocate and deallocate buffers with the current strategy or the one they came from
+    // the population isn't updated by these
+    char* allocate(mixin_state& state);
+    void deallocate(mixin_state& state, char* ptr);
+
+    bool owns_slot(const mixin_state& state, const char* ptr) const;
+    void release_pool(mixin_state& state);
+
+    const policy _policy;
+
+    std::unique_ptr<mixin_state> _states[DYNAMIX_MAX_MIXINS];
+
+    std::deque<decision> _decisions;
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    mutable std::mutex _mutex;
+#endif
+};
+
+} // namespace dynamix
@@ -99,6 +99,13 @@ public:
     /// The default implementation calls the destructor.
     virtual void destroy_mixin(const mixin_type_info& info, void* ptr) noexcept;
 
+    /// Virtual function, which tells whether a buffer allocated for a mixin which
+    /// was removed from an object can be used for another mixin added by the same mutation,
+    /// with the same offset, instead of deallocating it and allocating a new one.
+    /// The buffer will then be deallocated as one of the second mixin.
+    /// The default implementation returns false.
+    virtual bool can_reuse_mixin_buffer(const mixin_type_info& freed, const mixin_type_info& needed) const;
+
 #if DYNAMIX_DEBUG
     // checks to see if an allocator is changed after it has already started allocating
     // it could be a serious bug to allocate from one and deallocate from another
@@ -263,6 +270,8 @@ public:
     virtual std::pair<char*, size_t> alloc_mixin(const mixin_type_info& info, const object* obj) override;
     /// \internal
     virtual void dealloc_mixin(char* ptr, size_t mixin_offset, const mixin_type_info& info, const object* obj) override;
+    /// \internal
+    virtual bool can_reuse_mixin_buffer(const mixin_type_info& freed, const mixin_type_info& needed) const override;
 };
 
 
@@ -0,0 +1,115 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Calling messages for objects which are being mutated in other threads.
+ * Only available when the library is built with `DYNAMIX_CONCURRENT_MUTATIONS`.
+ *
+ * A mutation publishes the new mixin data of an object (which has the object type
+ * in front of it) with a single atomic store. Readers load it once per message call,
+ * so they always see a consistent type and mixins. The replaced mixin data and the
+ * removed mixins are retired and destroyed when all readers which were active at the
+ * time of the retirement have finished (epoch based reclamation).
+ *
+ * Message calls are readers. Each one is in a `read_scope` and the outermost scope in
+ * a thread publishes the thread's epoch with a full fence. Code which calls many messages
+ * should open a `read_scope` of its own to pay for the fence only once.
+ *
+ * Not covered: copying into an object (it assigns the mixins in place), `replace_mixin`,
+ * `move_mixin` and `reallocate_mixins`, destroying an object, and garbage collecting type
+ * infos while readers may be using them.
+ */
+
+#include "config.hpp"
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dynamix
+{
+namespace internal
+{
+
+// a slot of a reader thread in the epoch based reclamation
+struct epoch_record
+{
+    // global epoch at the time the thread entered its outermost read scope
+    // zero while the thread isn't reading
+    std::atomic<uint64_t> epoch;
+
+    // depth of nested read scopes
+    uint32_t depth;
+};
+
+// gets a free record or creates a new one for the calling thread
+DYNAMIX_API epoch_record* acquire_epoch_record();
+
+// called when the thread enters its outermost read scope
+DYNAMIX_API void enter_epoch(epoch_record& record) noexcept;
+
+// each module gets its own thread local pointer, so this doesn't go through a call
+// (a thread may end up with several records, one per module, which is fine)
+inline epoch_record& this_thread_epoch_record()
+{
+    static thread_local epoch_record* record = nullptr;
+    if (!record)
+    {
+        record = acquire_epoch_record();
+    }
+    return *record;
+}
+
+} // namespace internal
+
+/// Marks the current thread as a reader of objects. Objects mutated by other
+/// threads while a read scope is alive won't have their retired mixins destroyed
+/// until it ends. Pointers to mixins obtained inside a read scope are only
+/// valid until its end.
+/// Scopes can be nested. Only the outermost one has a cost beyond a few loads.
+class read_scope
+{
+public:
+    read_scope()
+        : _record(internal::this_thread_epoch_record())
+    {
+        if (_record.depth++ == 0)
+        {
+            internal::enter_epoch(_record);
+        }
+    }
+
+    ~read_scope()
+    {
+        if (--_record.depth == 0)
+        {
+            _record.epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    read_scope(const read_scope&) = delete;
+    read_scope& operator=(const read_scope&) = delete;
+
+private:
+    internal::epoch_record& _record;
+};
+
+/// Destroys the retired mixins and mixin data which no reader can see anymore.
+/// Mutations do this automatically, so it only needs to be called to release
+/// memory when there are no mutations.
+/// Returns the number of retired items which are still waiting for readers
+/// (including the read scope of the calling thread, if any).
+DYNAMIX_API size_t reclaim();
+
+} // namespace dynamix
+
+#endif // DYNAMIX_CONCURRENT_MUTATIONS
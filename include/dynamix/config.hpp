@@ -83,6 +83,24 @@
 #   define DYNAMIX_MAX_MESSAGES 1024
 #endif
 
+// maximum number of facts (see declare_fact.hpp)
+// object types have a table of this many pointers (<word> * value)
+#if !defined(DYNAMIX_MAX_FACTS)
+#   define DYNAMIX_MAX_FACTS 64
+#endif
+
+// maximum number of interfaces (see interface.hpp)
+// object types have a table of this many pointers (<word> * value)
+#if !defined(DYNAMIX_MAX_INTERFACES)
+#   define DYNAMIX_MAX_INTERFACES 32
+#endif
+
+// maximum number of registered sibling links (see `requires_sibling`)
+// object types have a table of this many indices (4 * value)
+#if !defined(DYNAMIX_MAX_SIBLING_LINKS)
+#   define DYNAMIX_MAX_SIBLING_LINKS 64
+#endif
+
 // setting this to true will cause some functions to throw exceptions instead of asserting
 #if !defined(DYNAMIX_USE_EXCEPTIONS)
 #   define DYNAMIX_USE_EXCEPTIONS 1
@@ -100,11 +118,23 @@
 // safe.
 // HOWEVER
 // mutating the same object in multiple threads is never safe
-// mutating an object in one thread and calling messages for this object in another is never safe
+// mutating an object in one thread and calling messages for this object in another is not safe
+// unless DYNAMIX_CONCURRENT_MUTATIONS is enabled
 #if !defined(DYNAMIX_THREAD_SAFE_MUTATIONS)
 #   define DYNAMIX_THREAD_SAFE_MUTATIONS 1
 #endif
 
+// setting this to true will make it safe to call messages for an object in some threads while
+// it's being mutated in another (still only one thread can mutate an object at a time)
+// the mutation publishes the new type and mixins of the object with a single atomic store
+// and the removed mixins and the old mixin data are destroyed when no reader which could
+// have seen them is active (epoch based reclamation, see concurrent_mutations.hpp)
+// message calls get slightly slower and mutations have to do more work
+// this option changes the object layout, so it requires rebuilding the library
+#if !defined(DYNAMIX_CONCURRENT_MUTATIONS)
+#   define DYNAMIX_CONCURRENT_MUTATIONS 0
+#endif
+
 // setting this to true will enable the compilation of object::replace_mixin and object::move_mixin
 // they can be dangerous as clients which keep pointers to mixins within objects can have them
 // invalidated without a way to be notified about this
@@ -114,6 +144,87 @@
 #   define DYNAMIX_OBJECT_REPLACE_MIXIN 1
 #endif
 
+// setting this to true will make the library record events for mutation phases, call table
+// creation and mixin allocations when tracing is enabled at runtime (see trace.hpp)
+// when it's false the library has no tracing code on its mutation and allocation paths
+// this option requires rebuilding the library
+#if !defined(DYNAMIX_TRACE)
+#   define DYNAMIX_TRACE 0
+#endif
+
+// setting this to true will make the library record object creations, destructions, moves,
+// mutations and object type template applications when a workload recording is active (see workload.hpp)
+// when it's false the library has no recording code on these paths and only message calls
+// (see DYNAMIX_RECORD_MESSAGES) get recorded
+// this option requires rebuilding the library
+#if !defined(DYNAMIX_RECORD_WORKLOAD)
+#   define DYNAMIX_RECORD_WORKLOAD 0
+#endif
+
+// setting this to true will make message calls record (sampled) events in the trace layer
+// when it's enabled at runtime (see trace.hpp)
+// unlike the other options here, this one only affects the message callers which are
+// instantiated in client code, so it doesn't require rebuilding the library
+#if !defined(DYNAMIX_TRACE_MESSAGES)
+#   define DYNAMIX_TRACE_MESSAGES 0
+#endif
+
+// setting this to true will make message calls get recorded by the workload recorder
+// when a recording is active (see workload.hpp)
+// as with DYNAMIX_TRACE_MESSAGES this only affects code instantiated in client modules
+#if !defined(DYNAMIX_RECORD_MESSAGES)
+#   define DYNAMIX_RECORD_MESSAGES 0
+#endif
+
+// setting this to true enables the `double_buffered` mixin feature (see double_buffer.hpp)
+// and makes message calls use the read or the write instance of such mixins
+// when it's false the callers use the first instance of all mixins, as they don't have a second one
+// as with DYNAMIX_TRACE_MESSAGES this only affects code instantiated in client modules
+// so it must be enabled in all modules which call messages of double-buffered mixins
+#if !defined(DYNAMIX_DOUBLE_BUFFERED_MIXINS)
+#   define DYNAMIX_DOUBLE_BUFFERED_MIXINS 0
+#endif
+
+// setting this to true enables the `seqlocked` mixin feature (see seqlock.hpp)
+// and makes non-const message calls increment the sequence counters of such mixins
+// when it's false the callers don't look for sequence counters
+// as with DYNAMIX_TRACE_MESSAGES this only affects code instantiated in client modules
+// so it must be enabled in all modules which call non-const messages of seqlocked mixins
+#if !defined(DYNAMIX_SEQLOCKED_MIXINS)
+#   define DYNAMIX_SEQLOCKED_MIXINS 0
+#endif
+
+// setting this to true enables `memo` (see memo.hpp) and makes non-const message calls
+// invalidate the memoized results of their objects
+// as with DYNAMIX_TRACE_MESSAGES this only affects code instantiated in client modules
+// so it must be enabled in all modules which call non-const messages of objects with memos
+#if !defined(DYNAMIX_MEMOS)
+#   define DYNAMIX_MEMOS 0
+#endif
+
+// setting this to true will make message calls get the message id from a cache in the
+// calling module, instead of calling the feature getter of the message (which is not
+// inlinable and goes through the PLT for messages exported from shared libraries)
+// the cache is filled when the message is registered or on first use
+// it's not supported on Windows when DynaMix is a DLL, as the cache can't be shared between modules there
+// (see internal/message_id_cache.hpp)
+// as with DYNAMIX_TRACE_MESSAGES this only affects code instantiated in client modules
+#if !defined(DYNAMIX_INLINE_MESSAGE_IDS)
+#   define DYNAMIX_INLINE_MESSAGE_IDS 0
+#endif
+
+// setting this to true will make DYNAMIX_DEFINE_MIXIN only record the mixin in the domain
+// during static initialization; its features are parsed and it gets registered on first use
+// (a mutation or query with the mixin type, a lookup by name, or `preload`)
+// this speeds up the startup of programs which link many mixins but only use a few of them
+// the registration on first use is guarded by a mutex when DYNAMIX_THREAD_SAFE_MUTATIONS is enabled
+// and so are the lookups by name and the sibling requirements while there are unregistered lazy mixins
+// (registering mixins during static initialization must still not overlap with their use)
+// as with DYNAMIX_TRACE_MESSAGES this only affects code instantiated in client modules
+#if !defined(DYNAMIX_LAZY_MIXIN_REGISTRATION)
+#   define DYNAMIX_LAZY_MIXIN_REGISTRATION 0
+#endif
+
 // there is warning push/pop about this in the main header
 #if defined(_MSC_VER)
 // msvc complains that template classes don't have a dll interface (they shouldn't).
@@ -18,5 +18,7 @@
 #include "features.hpp"
 #include "declare_message_opt.hpp"
 #include "define_message.hpp"
+#include "declare_fact.hpp"
+#include "define_fact.hpp"
 #include "mutate.hpp"
 #include "dm_this.hpp"
@@ -0,0 +1,97 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Macros for declaring facts and functions for reading them.
+ *
+ * Facts are constant per-mixin values (max speed, armor class, render layer...)
+ * which are resolved into a table of the object type when the type is created.
+ * Reading a fact of an object is a lookup in its type info and touches no mixin memory.
+ *
+ * Like unicast messages, if several mixins of a type provide a fact, the one with the
+ * highest priority and then with the highest bid wins. Mixins with the same priority
+ * and bid lead to a `fact_clash` when the type is created.
+ */
+
+#include "config.hpp"
+#include "fact.hpp"
+#include "message_features.hpp"
+#include "object.hpp"
+#include "object_type_info.hpp"
+#include "internal/preprocessor.hpp"
+
+namespace dynamix
+{
+
+/// Used in the mixin's feature list to provide a fact with its value.
+/// The value is copied and stored for the mixin.
+/// `priority` and `bid` can be applied to the result.
+template <typename Fact>
+internal::fact_perks<Fact> fact(Fact*, typename Fact::value_type value)
+{
+    internal::fact_perks<Fact> fp;
+    fp.value = std::make_shared<const typename Fact::value_type>(std::move(value));
+    return fp;
+}
+
+/// Returns a pointer to the value of the fact for the object
+/// or null if none of its mixins provide it.
+template <typename Fact>
+const typename Fact::value_type* get_fact(const object& obj, const Fact*) noexcept
+{
+    const feature_id id = _dynamix_get_mixin_feature_fast(static_cast<Fact*>(nullptr)).id;
+    I_DYNAMIX_ASSERT(id != INVALID_FEATURE_ID);
+    return static_cast<const typename Fact::value_type*>(obj.type_info()._fact_table[id]);
+}
+
+/// Returns the value of the fact for the object or `def` if none of its mixins provide it.
+template <typename Fact>
+typename Fact::value_type get_fact(const object& obj, const Fact* f, typename Fact::value_type def)
+{
+    auto value = get_fact(obj, f);
+    return value ? *value : def;
+}
+
+/// Checks whether a mixin of the object provides the fact.
+template <typename Fact>
+bool has_fact(const object& obj, const Fact* f) noexcept
+{
+    return !!get_fact(obj, f);
+}
+
+} // namespace dynamix
+
+/// \internal
+#define I_DYNAMIX_FACT_STRUCT_NAME(fact_name) I_DYNAMIX_PP_CAT(dynamix_fact_, fact_name)
+/// \internal
+#define I_DYNAMIX_FACT_TAG(fact_name) I_DYNAMIX_PP_CAT(fact_name, _fact)
+
+/**
+ * Declares a fact of a type. The tag `<fact_name>_fact` is used to provide it in feature
+ * lists (`fact(<fact_name>_fact, value)`) and to read it (`get_fact(obj, <fact_name>_fact)`)
+ *
+ * The fact must be defined with `DYNAMIX_DEFINE_FACT` in a single compilation unit.
+ */
+#define DYNAMIX_EXPORTED_FACT(export, type, fact_name) \
+    struct export I_DYNAMIX_FACT_STRUCT_NAME(fact_name) : public ::dynamix::internal::fact_t \
+    { \
+        typedef type value_type; \
+        I_DYNAMIX_FACT_STRUCT_NAME(fact_name)() \
+            : ::dynamix::internal::fact_t(I_DYNAMIX_PP_STRINGIZE(fact_name), false) \
+        {} \
+    }; \
+    /* tag, getters and registrator, like the ones of messages */ \
+    extern export I_DYNAMIX_FACT_STRUCT_NAME(fact_name) * I_DYNAMIX_FACT_TAG(fact_name); \
+    extern export ::dynamix::feature& _dynamix_get_mixin_feature_safe(const I_DYNAMIX_FACT_STRUCT_NAME(fact_name)*); \
+    extern export const ::dynamix::feature& _dynamix_get_mixin_feature_fast(const I_DYNAMIX_FACT_STRUCT_NAME(fact_name)*); \
+    extern export void _dynamix_register_mixin_feature(const I_DYNAMIX_FACT_STRUCT_NAME(fact_name)*)
+
+/// Declares a fact which is not exported from a dynamic library.
+#define DYNAMIX_FACT(type, fact_name) DYNAMIX_EXPORTED_FACT(I_DYNAMIX_PP_EMPTY(), type, fact_name)
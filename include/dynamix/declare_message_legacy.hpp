@@ -7,8 +7,16 @@
 //
 #pragma once
 
+#include "config.hpp"
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+#   error "The legacy message macros don't support DYNAMIX_CONCURRENT_MUTATIONS"
+#endif
+
 #include "object.hpp"
 #include "exception.hpp"
+#include "double_buffer.hpp"
+#include "seqlock.hpp"
 #include "internal/mixin_data_in_object.hpp"
 #include "internal/message_macros.hpp"
 #include "gen/legacy_message_macros.ipp"
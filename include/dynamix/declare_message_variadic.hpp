@@ -0,0 +1,214 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Message declaration macros which take the message signature as a function type.
+ *
+ * Unlike the generated per-arity macros, these are a handful of small macros
+ * and the argument handling is done by variadic templates. Preprocessing them
+ * is much cheaper and the resulting dispatch code is the same: the message
+ * structs derive from the same callers as the ones declared by the other macros.
+ *
+ * Usage:
+ *
+ *     DYNAMIX_MESSAGE_V(set_name, void(const std::string&));
+ *     DYNAMIX_CONST_MULTICAST_MESSAGE_V(get_weight, float());
+ *     DYNAMIX_MESSAGE_V_OVERLOAD(scale_uniform, scale, void(float));
+ *     DYNAMIX_MESSAGE_V_OVERLOAD(scale_vector, scale, void(const vector3&));
+ *
+ * The messages are defined with `DYNAMIX_DEFINE_MESSAGE` as usual.
+ *
+ * Differences from the per-arity macros:
+ * - The message functions are templates which forward their arguments. Calls with
+ * arguments which are not convertible to the message signature are removed from
+ * overload resolution. Overloads are resolved by viability only, so calls which
+ * are viable for more than one overload are ambiguous. As with all forwarding
+ * functions, a literal `0` can't be used as a null pointer argument.
+ * - A multicast message with a concrete combinator is called with
+ * `dynamix::call_with_combinator(message_msg, obj, combinator, args...)`
+ * - Default message implementations are not supported.
+ */
+
+#include "object.hpp"
+#include "internal/mixin_data_in_object.hpp"
+#include "internal/message_callers.hpp"
+#include "internal/message_macros.hpp"
+
+#include <utility>
+
+namespace dynamix
+{
+namespace internal
+{
+
+// unpacks a function type into the arguments of a message caller struct
+template <template <typename, typename, typename, typename...> class Caller, typename Derived, typename Object, typename Signature>
+struct msg_sig_caller;
+
+template <template <typename, typename, typename, typename...> class Caller, typename Derived, typename Object, typename Ret, typename... Args>
+struct msg_sig_caller<Caller, Derived, Object, Ret(Args...)>
+{
+    using type = Caller<Derived, Object, Ret, Args...>;
+};
+
+// used to make a return type which depends on an expression (so it can be used for sfinae)
+template <typename Expr, typename Type>
+struct msg_sig_result
+{
+    using type = Type;
+};
+
+} // namespace internal
+
+/// Calls a multicast message declared with the signature macros with a concrete combinator.
+/// The first argument is the message tag (`<message>_msg`).
+template <typename Message, typename Object, typename Combinator, typename... Args>
+auto call_with_combinator(Message*, Object& obj, Combinator& combinator, Args&&... args)
+    -> decltype(Message::combinator_call(obj, combinator, std::forward<Args>(args)...))
+{
+    Message::combinator_call(obj, combinator, std::forward<Args>(args)...);
+}
+
+} // namespace dynamix
+
+/// \internal
+#define I_DYNAMIX_MESSAGE_V_DECL(export, message_name, method_name, constness, message_mechanism, ...) \
+    /* step 1: define the message struct */ \
+    struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::msg_sig_caller< ::dynamix::internal::I_DYNAMIX_MESSAGE_CALLER_STRUCT(message_mechanism), \
+        I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name), constness ::dynamix::object, __VA_ARGS__>::type \
+    { \
+        I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
+            : I_DYNAMIX_MESSAGE_CALLER_STRUCT(message_mechanism)(I_DYNAMIX_PP_STRINGIZE(message_name)) \
+        {} \
+        template <typename Mixin, typename Signature> \
+        struct caller_of; \
+        template <typename Mixin, typename Ret, typename... Args> \
+        struct caller_of<Mixin, Ret(Args...)> \
+        { \
+            static Ret call(void* _d_mixin, caller_arg<Args>... _d_args) \
+            { \
+                constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
+                return _d_m->method_name(std::forward<caller_arg<Args>>(_d_args)...); \
+            } \
+        }; \
+        template <typename Mixin> \
+        ::dynamix::internal::func_ptr get_caller_for() const \
+        { \
+            /* prevent the linker from optimizing away the caller function */ \
+            static caller_func the_caller = &caller_of<Mixin, __VA_ARGS__>::call; \
+            /* cast the caller to a void (*)() - safe according to the standard */ \
+            return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
+        } \
+    }; \
+    /* step 2: define a message tag, that will be used to identify the message in feature lists */ \
+    extern export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) * I_DYNAMIX_MESSAGE_TAG(message_name); \
+    /* step 3: declare the feature getter and manual registrator for the message */ \
+    extern export ::dynamix::feature& _dynamix_get_mixin_feature_safe(const I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)*); \
+    extern export const ::dynamix::feature& _dynamix_get_mixin_feature_fast(const I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)*); \
+    extern export void _dynamix_register_mixin_feature(const I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)*); \
+
+/// \internal
+#define I_DYNAMIX_MESSAGE_V_UNI(export, message_name, method_name, constness, ...) \
+    I_DYNAMIX_MESSAGE_V_DECL(export, message_name, method_name, constness, unicast, __VA_ARGS__) \
+    /* step 4: define the message functions -> the ones that will be called for the objects */ \
+    template <typename... _DArgs> \
+    auto method_name(constness ::dynamix::object& _d_obj, _DArgs&&... _d_args) \
+        -> decltype(I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(_d_obj, std::forward<_DArgs>(_d_args)...)) \
+    { \
+        return I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(_d_obj, std::forward<_DArgs>(_d_args)...); \
+    } \
+    /* also define a pointer function */ \
+    template <typename... _DArgs> \
+    auto method_name(constness ::dynamix::object* _d_obj, _DArgs&&... _d_args) \
+        -> decltype(I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(*_d_obj, std::forward<_DArgs>(_d_args)...)) \
+    { \
+        return I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(*_d_obj, std::forward<_DArgs>(_d_args)...); \
+    } \
+
+/// \internal
+#define I_DYNAMIX_MESSAGE_V_MULTI(export, message_name, method_name, constness, ...) \
+    I_DYNAMIX_MESSAGE_V_DECL(export, message_name, method_name, constness, multicast, __VA_ARGS__) \
+    /* step 4: define the message functions -> the ones that will be called for the objects */ \
+    /* function A: template combinator -> can be called on a single line */ \
+    template <template <typename> class Combinator, typename... _DArgs> \
+    auto method_name(constness ::dynamix::object& _d_obj, _DArgs&&... _d_args) \
+        -> typename ::dynamix::internal::msg_sig_result< \
+            decltype(I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(_d_obj, std::forward<_DArgs>(_d_args)...)), \
+            typename Combinator<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::return_type>::result_type>::type \
+    { \
+        Combinator<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::return_type> _d_combinator; \
+        I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::combinator_call(_d_obj, _d_combinator, std::forward<_DArgs>(_d_args)...); \
+        return _d_combinator.result(); \
+    } \
+    /* function B: no combinator */ \
+    template <typename... _DArgs> \
+    auto method_name(constness ::dynamix::object& _d_obj, _DArgs&&... _d_args) \
+        -> decltype(I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(_d_obj, std::forward<_DArgs>(_d_args)...)) \
+    { \
+        I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(_d_obj, std::forward<_DArgs>(_d_args)...); \
+    } \
+    /* also define a pointer function with no combinator */ \
+    template <typename... _DArgs> \
+    auto method_name(constness ::dynamix::object* _d_obj, _DArgs&&... _d_args) \
+        -> decltype(I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(*_d_obj, std::forward<_DArgs>(_d_args)...)) \
+    { \
+        I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::call(*_d_obj, std::forward<_DArgs>(_d_args)...); \
+    } \
+
+// the signature is the last argument and is taken as __VA_ARGS__
+// so that it can contain commas in template return types
+
+#define DYNAMIX_MESSAGE_V(message, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(I_DYNAMIX_PP_EMPTY(), message, message, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_CONST_MESSAGE_V(message, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(I_DYNAMIX_PP_EMPTY(), message, message, const, __VA_ARGS__)
+
+#define DYNAMIX_MULTICAST_MESSAGE_V(message, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(I_DYNAMIX_PP_EMPTY(), message, message, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_CONST_MULTICAST_MESSAGE_V(message, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(I_DYNAMIX_PP_EMPTY(), message, message, const, __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_MESSAGE_V(export, message, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(export, message, message, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_CONST_MESSAGE_V(export, message, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(export, message, message, const, __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_MULTICAST_MESSAGE_V(export, message, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(export, message, message, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_CONST_MULTICAST_MESSAGE_V(export, message, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(export, message, message, const, __VA_ARGS__)
+
+#define DYNAMIX_MESSAGE_V_OVERLOAD(message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(I_DYNAMIX_PP_EMPTY(), message_name, method_name, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_CONST_MESSAGE_V_OVERLOAD(message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(I_DYNAMIX_PP_EMPTY(), message_name, method_name, const, __VA_ARGS__)
+
+#define DYNAMIX_MULTICAST_MESSAGE_V_OVERLOAD(message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(I_DYNAMIX_PP_EMPTY(), message_name, method_name, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_CONST_MULTICAST_MESSAGE_V_OVERLOAD(message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(I_DYNAMIX_PP_EMPTY(), message_name, method_name, const, __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_MESSAGE_V_OVERLOAD(export, message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(export, message_name, method_name, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_CONST_MESSAGE_V_OVERLOAD(export, message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_UNI(export, message_name, method_name, const, __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_MULTICAST_MESSAGE_V_OVERLOAD(export, message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(export, message_name, method_name, I_DYNAMIX_PP_EMPTY(), __VA_ARGS__)
+
+#define DYNAMIX_EXPORTED_CONST_MULTICAST_MESSAGE_V_OVERLOAD(export, message_name, method_name, ...) \
+    I_DYNAMIX_MESSAGE_V_MULTI(export, message_name, method_name, const, __VA_ARGS__)
@@ -0,0 +1,74 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Macro for defining facts.
+ */
+
+#include "declare_fact.hpp"
+#include "domain.hpp"
+
+namespace dynamix
+{
+namespace internal
+{
+// registers facts in case no mixin provides them
+// and unregisters them when the module is unloaded (see message_registrator)
+template <typename Fact>
+struct fact_registrator
+{
+    fact_registrator()
+    {
+        _dynamix_register_mixin_feature(static_cast<Fact*>(nullptr));
+    }
+
+    ~fact_registrator()
+    {
+        internal::domain::safe_instance().
+            unregister_feature(static_cast<fact_t&>(_dynamix_get_mixin_feature_safe(static_cast<Fact*>(nullptr))));
+    }
+
+    static fact_registrator registrator;
+
+    int unused;
+};
+template <typename Fact>
+fact_registrator<Fact> fact_registrator<Fact>::registrator;
+
+} // namespace internal
+} // namespace dynamix
+
+/**
+* The macro for defining a fact.
+* Use it once per fact in a compilation unit (.cpp file)
+*/
+#define DYNAMIX_DEFINE_FACT(fact_name) \
+    /* create feature getters for the fact */ \
+    ::dynamix::feature& _dynamix_get_mixin_feature_safe(const I_DYNAMIX_FACT_STRUCT_NAME(fact_name)*) \
+    { \
+        return ::dynamix::internal::feature_instance<I_DYNAMIX_FACT_STRUCT_NAME(fact_name)>::the_feature_safe(); \
+    } \
+    const ::dynamix::feature& _dynamix_get_mixin_feature_fast(const I_DYNAMIX_FACT_STRUCT_NAME(fact_name)*) \
+    { \
+        return ::dynamix::internal::feature_instance<I_DYNAMIX_FACT_STRUCT_NAME(fact_name)>::the_feature_fast(); \
+    } \
+    /* create a feature registrator */ \
+    void _dynamix_register_mixin_feature(const I_DYNAMIX_FACT_STRUCT_NAME(fact_name)*) \
+    { \
+        ::dynamix::internal::domain::safe_instance(). \
+            register_feature(::dynamix::internal::feature_instance<I_DYNAMIX_FACT_STRUCT_NAME(fact_name)>::the_feature_safe()); \
+    } \
+    /* instantiate the registrator in case no mixin provides the fact */ \
+    inline void _dynamix_register_fact(I_DYNAMIX_FACT_STRUCT_NAME(fact_name)*) \
+    { \
+        ::dynamix::internal::fact_registrator<I_DYNAMIX_FACT_STRUCT_NAME(fact_name)>::registrator.unused = true; \
+    } \
+    /* provide a tag instance */ \
+    I_DYNAMIX_FACT_STRUCT_NAME(fact_name) * I_DYNAMIX_FACT_TAG(fact_name)
@@ -9,6 +9,7 @@
 
 #include "internal/preprocessor.hpp"
 #include "internal/message_macros.hpp"
+#include "internal/message_id_cache.hpp"
 #include "domain.hpp"
 
 namespace dynamix
@@ -23,12 +24,18 @@ struct message_registrator
     message_registrator()
     {
         _dynamix_register_mixin_feature(static_cast<Message*>(nullptr));
+#if DYNAMIX_INLINE_MESSAGE_IDS
+        message_id_cache<Message>::resolve();
+#endif
     }
 
     // defined in message_macros because it depends on domain.hpp
     // unregisteres the message
     ~message_registrator()
     {
+#if DYNAMIX_INLINE_MESSAGE_IDS
+        message_id_cache<Message>::reset();
+#endif
         internal::domain::safe_instance().
             unregister_feature(static_cast<message_t&>(_dynamix_get_mixin_feature_safe(static_cast<Message*>(nullptr))));
     }
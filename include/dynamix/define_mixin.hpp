@@ -36,11 +36,50 @@ struct mixin_type_info_instance
         return d;
     }
 
+    // the info of a registered mixin
+    // lazily registered mixins get registered here on first use
+    static mixin_type_info& registered_info()
+    {
+        auto& the_info = info();
+#if DYNAMIX_LAZY_MIXIN_REGISTRATION
+        if (!the_info.registered.load(std::memory_order_acquire))
+        {
+            domain::safe_instance().register_lazy_mixin(the_info);
+        }
+#endif
+        return the_info;
+    }
+
     // this static member registers the mixin in the domain
     // we need to reference it somewhere so as to call its constructor
     static mixin_type_info_instance registrator;
 
     mixin_type_info_instance()
+    {
+#if DYNAMIX_LAZY_MIXIN_REGISTRATION
+        // only record the mixin, so the domain can register it on first use
+        auto& the_info = info();
+        the_info.lazy_registrator = parse_and_register;
+        domain::safe_instance().add_lazy_mixin(the_info);
+#else
+        parse_and_register();
+#endif
+    }
+
+    ~mixin_type_info_instance()
+    {
+        auto& dom = domain::safe_instance();
+
+#if DYNAMIX_LAZY_MIXIN_REGISTRATION
+        dom.remove_lazy_mixin(info());
+        if (!info().registered) return; // never used
+#endif
+
+        // unregister the mixin from the domain
+        dom.unregister_mixin_type(info());
+    }
+
+    static void parse_and_register()
     {
         auto& the_info = info();
 
@@ -58,14 +97,6 @@ struct mixin_type_info_instance
         domain::safe_instance().register_mixin_type(the_info);
     }
 
-
-    ~mixin_type_info_instance()
-    {
-        // unregister the mixin from the domain
-        domain::safe_instance().unregister_mixin_type(info());
-    }
-
-
     // non-copyable
     mixin_type_info_instance(const mixin_type_info_instance&) = delete;
     mixin_type_info_instance& operator=(const mixin_type_info_instance&) = delete;
@@ -118,7 +149,7 @@ mixin_type_info_instance<Mixin> mixin_type_info_instance<Mixin>::registrator;
     /* create a function that will reference mixin_type_info_instance static registrator to guarantee its instantiation */ \
     inline void _dynamix_register_mixin(mixin_type*) { ::dynamix::internal::mixin_type_info_instance<mixin_type>::registrator.unused = true; } \
     /* create a mixin_type_info getter for this type */ \
-    ::dynamix::mixin_type_info& _dynamix_get_mixin_type_info(const mixin_type*) { return ::dynamix::internal::mixin_type_info_instance<mixin_type>::info(); } \
+    ::dynamix::mixin_type_info& _dynamix_get_mixin_type_info(const mixin_type*) { return ::dynamix::internal::mixin_type_info_instance<mixin_type>::registered_info(); } \
     /* create a features parsing function */ \
     /* features can be parsed multiple times by different parsers */ \
     template <typename FeaturesParser> \
@@ -12,11 +12,13 @@
 #include "mixin_type_info.hpp"
 #include "feature.hpp"
 #include "message.hpp"
+#include "fact.hpp"
 #include "mixin_collection.hpp" // for mixin_type_info_vector
 #include "internal/assert.hpp"
 
-#include <unordered_map>
+#include <atomic>
 #include <memory>
+#include <vector>
 #include <type_traits> // alignment of
 
 #if DYNAMIX_THREAD_SAFE_MUTATIONS
@@ -39,11 +41,13 @@ class object_type_mutation;
 class domain_allocator;
 class type_class;
 class object_type_info;
+class object_domain;
 
 namespace internal
 {
 
 struct message_t;
+struct fact_t;
 
 class DYNAMIX_API domain
 {
@@ -55,27 +59,33 @@ public:
     // no static variables, not safe to call globally
     static const domain& instance();
 
+    // the mutation rules and the type infos are in the object domains
+    // these work with the global one
     mutation_rule_id add_mutation_rule(std::shared_ptr<mutation_rule> rule);
     mutation_rule_id add_mutation_rule(mutation_rule* rule);
     std::shared_ptr<mutation_rule> remove_mutation_rule(mutation_rule_id id);
-    void apply_mutation_rules(object_type_mutation& mutation, const mixin_collection& source_mixins);
 
     size_t num_registered_mixins() const { return _num_registered_mixins; }
 
     void register_mixin_type(mixin_type_info& info);
     void unregister_mixin_type(const mixin_type_info& info);
 
+    // mixins which are registered on first use (see DYNAMIX_LAZY_MIXIN_REGISTRATION)
+    void add_lazy_mixin(mixin_type_info& info);
+    void remove_lazy_mixin(const mixin_type_info& info);
+    void register_lazy_mixin(mixin_type_info& info);
+    void register_all_lazy_mixins();
+
     // feature registration functions for the supported kinds of features
     void register_feature(message_t& m);
     void unregister_feature(const message_t& m);
+    void register_feature(fact_t& f);
+    void unregister_feature(const fact_t& f);
 
     // type class registration
     void register_type_class(type_class& t);
     void unregister_type_class(const type_class& t);
 
-    // creates a new type info if needed
-    const object_type_info* get_object_type_info(mixin_collection mixins);
-
     const mixin_type_info& mixin_info(mixin_id id) const
     {
         I_DYNAMIX_ASSERT(id != INVALID_MIXIN_ID);
@@ -99,14 +109,24 @@ public:
     // get mixin id by name string
     mixin_id get_mixin_id_by_name(const char* mixin_name) const;
 
-    // erases all type infos with zero objects
+    // number of sibling link ids (see `requires_sibling`) which have been used
+    // ids below it may be free if mixins have been unregistered
+    uint32_t num_sibling_links() const { return _num_sibling_links; }
+
+    // erases all type infos with zero objects in the global object domain
     void garbage_collect_type_infos();
 
+    // object domains other than the global one register themselves
+    // so that their type infos can be dropped when a mixin is unregistered
+    void register_object_domain(object_domain& od);
+    void unregister_object_domain(const object_domain& od);
+
 private:
     domain();
     ~domain();
 
     friend class dynamix::object_type_info;
+    friend class dynamix::object_domain;
     friend class object_mutator;
 
     // non-copyable
@@ -127,21 +147,56 @@ private:
     message_t* _messages[DYNAMIX_MAX_MESSAGES];
     size_t _num_registered_messages;
 
+    // changed when messages are registered or unregistered
+    // the call tables of types created before that aren't shared with new types (see object_domain)
+    uint32_t _messages_version = 0;
+
+    // sparse list of all facts (like the messages)
+    fact_t* _facts[DYNAMIX_MAX_FACTS];
+    size_t _num_registered_facts;
+
     // sparse list of all registered type classes
     // some elements might be nullptr
     // such elements have been registered from a loadable module (plugin)
     // and then unregistered when it was unloaded
     std::vector<type_class*> _type_classes;
 
-    typedef std::unordered_map<available_mixins_bitset, std::unique_ptr<object_type_info>> object_type_info_map;
-    object_type_info_map _object_type_infos;
+    // domain of the objects which are created without one
+    std::unique_ptr<object_domain> _global_object_domain;
+
+    // all object domains including the global one
+    std::vector<object_domain*> _object_domains;
+
+    // adds required siblings to mutations
+    // applied after all other mutation rules
+    void apply_sibling_requirements(object_type_mutation& mutation, const mixin_collection& source_mixins) const;
 
-    // mutation rules for this domain
-    std::vector<std::shared_ptr<mutation_rule>> _mutation_rules;
+    // registered mixins which have required siblings
+    std::vector<const mixin_type_info*> _mixins_with_siblings;
+
+    // link ids are reused after their mixin is unregistered
+    // type infos which contain the mixin are erased, and the others never read the ids of links
+    // of mixins which aren't in them, so they don't need to be rebuilt
+    bool _used_sibling_links[DYNAMIX_MAX_SIBLING_LINKS] = {};
+    uint32_t _num_sibling_links = 0;
+
+    // all lazily registered mixins, including the ones which have been registered
+    std::vector<mixin_type_info*> _lazy_mixins;
+
+    // lazily registered mixins which have not been registered yet
+    std::atomic<size_t> _num_unregistered_lazy_mixins = {0};
 
 #if DYNAMIX_THREAD_SAFE_MUTATIONS
-    std::mutex _object_type_infos_mutex;
-    std::mutex _mutation_rules_mutex;
+    // guards the type classes and the object domains
+    // it's locked after the type infos lock of an object domain (never before it)
+    std::mutex _registry_mutex;
+
+    // guards the lazy registration
+    // it's recursive since registering a mixin registers its required siblings
+    // a lazy registration may happen in any thread, so the lists of mixins which it changes
+    // (and which aren't indexed by the ids of mixins which are known to be registered)
+    // are only read with it locked while there are unregistered lazy mixins
+    mutable std::recursive_mutex _lazy_mixins_mutex;
 #endif
 
     // allocators
@@ -157,4 +212,17 @@ private:
 /// Sets an global allocator for all mixins and datas.
 void DYNAMIX_API set_global_allocator(domain_allocator* allocator);
 
+// registration functions
+
+/// Registers a mixin which is otherwise registered on first use (see `DYNAMIX_LAZY_MIXIN_REGISTRATION`)
+/// so that its first use doesn't pay for the registration. Does nothing for registered mixins.
+template <typename Mixin>
+void preload()
+{
+    _dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr));
+}
+
+/// Registers all mixins which are otherwise registered on first use.
+void DYNAMIX_API preload_all_mixins();
+
 } // namespace dynamix
@@ -0,0 +1,77 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Swapping of double-buffered mixins.
+ *
+ * Objects keep two instances of the mixins with the `double_buffered` feature.
+ * Const messages and const `get` use the read instance and non-const ones use the write
+ * instance. Thus a simulation step can call non-const messages for different objects
+ * in parallel, while they read each other's state with const messages.
+ *
+ * `swap_buffers` makes the write instances the read ones and vice versa for all objects
+ * at once. Nothing is copied: the read instance is chosen by the parity of a global epoch.
+ *
+ * After a swap the write instances have the state from two swaps ago. A step must either
+ * write the whole state of such a mixin or copy what it needs from the read instance.
+ *
+ * The feature requires DYNAMIX_DOUBLE_BUFFERED_MIXINS in all modules which call messages
+ * of such mixins. Without it the message callers don't check for a second instance.
+ */
+
+#include "config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace dynamix
+{
+
+namespace internal
+{
+// the second instances are read when it's odd
+extern DYNAMIX_API std::atomic<uint32_t> double_buffer_epoch;
+
+// returns the instance of a mixin which is used through an object (or a mixin) with the constness of T
+// const access uses the read instance and non-const access uses the write instance
+template <typename T>
+char* double_buffer_instance(const void* mixin, size_t double_buffer_offset) noexcept
+{
+    char* ret = reinterpret_cast<char*>(const_cast<void*>(mixin));
+    if (double_buffer_offset)
+    {
+        const size_t read_second = size_t(0) - (double_buffer_epoch.load(std::memory_order_relaxed) & 1);
+        ret += double_buffer_offset & (std::is_const<T>::value ? read_second : ~read_second);
+    }
+    return ret;
+}
+} // namespace internal
+
+// the instance of a mixin which is used by a message call through an object with the constness of Object
+// without double-buffered mixins it's the only instance, so the callers don't check the offset
+#if DYNAMIX_DOUBLE_BUFFERED_MIXINS
+#   define I_DYNAMIX_CALL_INSTANCE(Object, mixin, double_buffer_offset) \
+        ::dynamix::internal::double_buffer_instance<Object>(mixin, double_buffer_offset)
+#else
+#   define I_DYNAMIX_CALL_INSTANCE(Object, mixin, double_buffer_offset) \
+        reinterpret_cast<char*>(const_cast<void*>(mixin))
+#endif
+
+/// Swaps the read and write instances of all double-buffered mixins.
+/// No messages must be called for objects with such mixins during the swap.
+/// Memoized message results (see memo.hpp) from before the swap are not used after it.
+DYNAMIX_API void swap_buffers() noexcept;
+
+/// Number of swaps so far
+DYNAMIX_API uint32_t buffer_epoch() noexcept;
+
+} // namespace dynamix
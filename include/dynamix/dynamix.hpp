@@ -32,13 +32,18 @@
 #include "message.hpp"
 #include "declare_message_opt.hpp"
 #include "define_message.hpp"
+#include "declare_fact.hpp"
+#include "define_fact.hpp"
 #include "object.hpp"
+#include "object_domain.hpp"
 #include "mutate.hpp"
 #include "same_type_mutator.hpp"
 #include "object_type_template.hpp"
 #include "object_type_info.hpp"
+#include "sibling.hpp"
 #include "exception.hpp"
 #include "allocators.hpp"
+#include "concurrent_mutations.hpp"
 
 #if !defined(DYNAMIX_NO_DM_THIS)
 #   include "dm_this.hpp"
@@ -44,6 +44,10 @@ class DYNAMIX_API bad_message_call : public exception {};
 /// the same unicast message with the same priority
 class DYNAMIX_API unicast_clash : public exception {};
 
+/// Thrown when an object type is created which has mixins that provide
+/// the same fact with the same priority and bid
+class DYNAMIX_API fact_clash : public exception {};
+
 /// Thrown when a copy construction is performed from an object which has a
 /// non-copy-constructioble mixin
 class DYNAMIX_API bad_copy_construction : public exception {};
@@ -0,0 +1,64 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Defines fact related types for the feature list.
+ */
+
+#include "feature.hpp"
+
+#include <memory>
+
+namespace dynamix
+{
+
+namespace internal
+{
+
+// feature tag of facts (see message_feature_tag)
+struct DYNAMIX_API fact_feature_tag {};
+
+struct DYNAMIX_API fact_t : public feature
+{
+    /* the way facts identify themselves to feature parsers and the domain */
+    typedef fact_feature_tag feature_tag;
+
+protected:
+    fact_t(const char* name, bool is_private)
+        : feature(name, is_private)
+    {}
+};
+
+// a fact with its value for a concrete mixin
+struct DYNAMIX_API fact_for_mixin
+{
+    fact_t* fact;
+
+    // a copy of the value from the feature list
+    std::shared_ptr<const void> value;
+
+    // perks, same as for unicast messages
+    int bid;
+    int priority;
+};
+
+// templated so the type can be passed along with the perks
+// priority and bid from message_features.hpp can be applied to it
+template <typename Fact>
+struct fact_perks
+{
+    std::shared_ptr<const void> value;
+    int bid = 0;
+    int priority = 0;
+};
+
+} // namespace internal
+
+} // namespace dynamix
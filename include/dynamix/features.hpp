@@ -19,6 +19,8 @@
 namespace dynamix
 {
 
+class mixin_type_info;
+
 /// The type of the `empty` feature.
 struct DYNAMIX_API noop_feature_t {};
 
@@ -39,6 +41,13 @@ struct mixin_user_data_feature
 {
     uintptr_t user_data;
 };
+struct mixin_sibling_feature
+{
+    const mixin_type_info* sibling;
+};
+struct mixin_teardown_feature {};
+struct mixin_double_buffered_feature {};
+struct mixin_seqlocked_feature {};
 }
 
 /// Allows the mixin name to be set manually (instead of obtained by the class name)
@@ -52,4 +61,44 @@ inline internal::mixin_user_data_feature user_data(uintptr_t data)
     return {data};
 }
 
+/// Declares that the mixin requires another mixin in the same object.
+/// Mutations which add the mixin will also add the sibling, and mutations which
+/// try to remove the sibling while the mixin stays, won't remove it.
+/// The sibling can then be accessed with `dynamix::sibling` (in sibling.hpp)
+/// through a table which is built once per object type.
+template <typename Sibling>
+internal::mixin_sibling_feature requires_sibling()
+{
+    return {&_dynamix_get_mixin_type_info(static_cast<Sibling*>(nullptr))};
+}
+
+/// Declares that `teardown` must call the destructor of the mixin even when it skips
+/// destructors. Use it for mixins which own resources outside of the memory of the process.
+inline internal::mixin_teardown_feature destroy_on_teardown()
+{
+    return {};
+}
+
+#if DYNAMIX_DOUBLE_BUFFERED_MIXINS
+/// Declares that objects keep two instances of the mixin. Const messages and const `get`
+/// use the read instance, and non-const ones use the write instance.
+/// `swap_buffers` (in double_buffer.hpp) swaps the instances of all such mixins.
+/// Only available with DYNAMIX_DOUBLE_BUFFERED_MIXINS.
+inline internal::mixin_double_buffered_feature double_buffered()
+{
+    return {};
+}
+#endif
+
+#if DYNAMIX_SEQLOCKED_MIXINS
+/// Declares that the mixin has a sequence counter which non-const messages increment
+/// around their calls, so that other threads can read it consistently with
+/// `read_consistent` (in seqlock.hpp).
+/// Only available with DYNAMIX_SEQLOCKED_MIXINS.
+inline internal::mixin_seqlocked_feature seqlocked()
+{
+    return {};
+}
+#endif
+
 } // namespace dynamix
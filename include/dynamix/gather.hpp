@@ -0,0 +1,209 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Gathering pointers to mixins of many objects into arrays.
+ *
+ * Loops which use the same mixins of many objects can gather them once and then
+ * work with plain arrays of pointers. The mixins are resolved once per run of
+ * objects of the same type (instead of once per `object::get`) and the objects
+ * and their mixin data are prefetched ahead.
+ */
+
+#include "config.hpp"
+#include "object.hpp"
+#include "object_type_info.hpp"
+#include "mixin_type_info.hpp"
+#include "double_buffer.hpp"
+#include "internal/mixin_data_in_object.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
+namespace dynamix
+{
+
+/// What `gather` does with objects which don't have all of the mixins
+enum class gather_missing
+{
+    skip, ///< they're skipped, so the arrays only have the objects with all mixins
+    null, ///< null pointers are added for their missing mixins, so the arrays have all objects
+};
+
+namespace internal
+{
+
+inline void prefetch(const void* ptr) noexcept
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(ptr);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+    (void)ptr;
+#endif
+}
+
+// objects can be gathered from ranges of objects or of pointers to objects
+inline object* gather_object(object& obj) noexcept { return &obj; }
+inline const object* gather_object(const object& obj) noexcept { return &obj; }
+inline object* gather_object(object* obj) noexcept { return obj; }
+inline const object* gather_object(const object* obj) noexcept { return obj; }
+
+// number of objects ahead of the current one whose mixin data is prefetched
+// objects twice as far are prefetched too, so their type and mixin data are in the cache by then
+static const size_t gather_prefetch_distance = 8;
+
+template <typename Mixin, typename Object>
+Mixin* gathered_mixin(Object* obj, const mixin_data_in_object* data, uint32_t index, size_t double_buffer_offset) noexcept
+{
+    static_assert(std::is_const<Mixin>::value || !std::is_const<Object>::value,
+        "non-const mixins can't be gathered from const objects");
+    (void)obj;
+    const void* mixin = data[index].mixin();
+    if (!mixin) return nullptr;
+    return reinterpret_cast<Mixin*>(double_buffer_instance<Mixin>(mixin, double_buffer_offset));
+}
+
+template <typename Vector, typename... Vectors>
+size_t first_size(const Vector& first, const Vectors&...) noexcept
+{
+    return first.size();
+}
+
+} // namespace internal
+
+/**
+ * \brief gathers pointers to mixins of objects into arrays
+ *
+ * \param[in] objects a random access range of objects or of pointers to objects
+ * \param[in] missing what to do with objects which don't have all of the mixins
+ * \param[out] out an array per mixin, to which the pointers are appended
+ * (they must have the same size)
+ *
+ * \return The number of objects which have all of the mixins
+ *
+ * The arrays of const mixins get the read instances of double-buffered mixins
+ * (as does a const `object::get`). The pointers are valid until the objects are
+ * mutated. With concurrent mutations other threads must call this in a `read_scope`
+ * and only use the pointers in it.
+ *
+ * \par Example:
+ * \code
+ * std::vector<transform*> transforms;
+ * std::vector<const velocity*> velocities;
+ * dynamix::gather(objects, dynamix::gather_missing::skip, transforms, velocities);
+ * for (size_t i = 0; i < transforms.size(); ++i)
+ * {
+ *     transforms[i]->position += velocities[i]->value * dt;
+ * }
+ * \endcode
+ */
+template <typename Objects, typename... Mixins>
+size_t gather(Objects&& objects, gather_missing missing, std::vector<Mixins*>&... out)
+{
+    static_assert(sizeof...(Mixins) > 0, "there must be at least one mixin to gather");
+    static const size_t num_mixins = sizeof...(Mixins);
+    static const size_t distance = internal::gather_prefetch_distance;
+
+    const mixin_type_info* infos[num_mixins] = {
+        &_dynamix_get_mixin_type_info(static_cast<typename std::remove_const<Mixins>::type*>(nullptr))...
+    };
+
+    auto begin = std::begin(objects);
+    const size_t count = size_t(std::end(objects) - begin);
+
+    // the arrays are grown once and then shrunk to what was gathered
+    const size_t first = internal::first_size(out...);
+    int expand_resize[] = { (out.resize(first + count), 0)... };
+    (void)expand_resize;
+    size_t pos = first;
+
+    // the mixin indices of the current run of objects of the same type
+    const object_type_info* type = nullptr;
+    uint32_t indices[num_mixins] = {};
+    bool has_all = false;
+
+    size_t ret = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i + 2 * distance < count)
+        {
+            internal::prefetch(internal::gather_object(begin[i + 2 * distance]));
+        }
+        if (i + distance < count)
+        {
+#if DYNAMIX_CONCURRENT_MUTATIONS
+            internal::prefetch(internal::gather_object(begin[i + distance])->_published_mixin_data.load(std::memory_order_relaxed));
+#else
+            internal::prefetch(internal::gather_object(begin[i + distance])->_mixin_data);
+#endif
+        }
+
+        auto obj = internal::gather_object(begin[i]);
+#if DYNAMIX_CONCURRENT_MUTATIONS
+        const internal::mixin_data_in_object* data = obj->_published_mixin_data.load(std::memory_order_acquire);
+        const object_type_info* obj_type = object_type_info::of_mixin_data(data);
+#else
+        const internal::mixin_data_in_object* data = obj->_mixin_data;
+        const object_type_info* obj_type = obj->_type_info;
+#endif
+
+        if (obj_type != type)
+        {
+            type = obj_type;
+            has_all = true;
+            for (size_t m = 0; m < num_mixins; ++m)
+            {
+                // the null mixin data index for missing mixins
+                indices[m] = type->mixin_index(infos[m]->id);
+                has_all = has_all && indices[m] != object_type_info::NULL_MIXIN_DATA_INDEX;
+            }
+        }
+
+        if (has_all)
+        {
+            ++ret;
+        }
+        else if (missing == gather_missing::skip)
+        {
+            continue;
+        }
+
+        size_t m = 0;
+        int expand_add[] = { (out[pos] = internal::gathered_mixin<Mixins>(obj, data, indices[m],
+            infos[m]->double_buffer_offset), ++m, 0)... };
+        (void)expand_add;
+        ++pos;
+    }
+
+    int expand_shrink[] = { (out.resize(pos), 0)... };
+    (void)expand_shrink;
+
+    return ret;
+}
+
+/// Gathers pointers to mixins of the objects which have all of them.
+/// (See the overload with `gather_missing` for details.)
+template <typename Objects, typename... Mixins>
+size_t gather(Objects&& objects, std::vector<Mixins*>&... out)
+{
+    return gather(std::forward<Objects>(objects), gather_missing::skip, out...);
+}
+
+} // namespace dynamix
@@ -93,6 +93,7 @@
             reinterpret_cast<::dynamix::internal::func_ptr>(&DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)::caller), \
             ::std::numeric_limits<int>::min(), \
             ::std::numeric_limits<int>::min(), \
+            false, \
         }; \
         msg.default_impl_data = &default_impl; \
     } \
@@ -156,15 +157,15 @@
 
 #define DYNAMIX_DEFINE_MESSAGE_1_WITH_DEFAULT_IMPL(return_type, message_name , arg0_type, a0) \
     /* check for correct type */ \
-    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , arg0_type)>::value, \
+    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>)>::value, \
         "The default implementation must have the same signature as the message."); \
     /* standard message definition */ \
     struct DYNAMIX_DEFAULT_IMPL_STRUCT(message_name) \
     { \
         return_type impl(arg0_type a0); \
-        static return_type caller(void* self , arg0_type a0) \
+        static return_type caller(void* self , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type> a0) \
         { \
-            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<arg0_type>(a0)); \
+            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>>(a0)); \
         } \
     }; \
     /* create feature getters for the message */ \
@@ -188,6 +189,7 @@
             reinterpret_cast<::dynamix::internal::func_ptr>(&DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)::caller), \
             ::std::numeric_limits<int>::min(), \
             ::std::numeric_limits<int>::min(), \
+            false, \
         }; \
         msg.default_impl_data = &default_impl; \
     } \
@@ -251,15 +253,15 @@
 
 #define DYNAMIX_DEFINE_MESSAGE_2_WITH_DEFAULT_IMPL(return_type, message_name , arg0_type, a0, arg1_type, a1) \
     /* check for correct type */ \
-    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , arg0_type, arg1_type)>::value, \
+    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>)>::value, \
         "The default implementation must have the same signature as the message."); \
     /* standard message definition */ \
     struct DYNAMIX_DEFAULT_IMPL_STRUCT(message_name) \
     { \
         return_type impl(arg0_type a0, arg1_type a1); \
-        static return_type caller(void* self , arg0_type a0, arg1_type a1) \
+        static return_type caller(void* self , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type> a0, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type> a1) \
         { \
-            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1)); \
+            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>>(a0), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>>(a1)); \
         } \
     }; \
     /* create feature getters for the message */ \
@@ -283,6 +285,7 @@
             reinterpret_cast<::dynamix::internal::func_ptr>(&DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)::caller), \
             ::std::numeric_limits<int>::min(), \
             ::std::numeric_limits<int>::min(), \
+            false, \
         }; \
         msg.default_impl_data = &default_impl; \
     } \
@@ -346,15 +349,15 @@
 
 #define DYNAMIX_DEFINE_MESSAGE_3_WITH_DEFAULT_IMPL(return_type, message_name , arg0_type, a0, arg1_type, a1, arg2_type, a2) \
     /* check for correct type */ \
-    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , arg0_type, arg1_type, arg2_type)>::value, \
+    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>)>::value, \
         "The default implementation must have the same signature as the message."); \
     /* standard message definition */ \
     struct DYNAMIX_DEFAULT_IMPL_STRUCT(message_name) \
     { \
         return_type impl(arg0_type a0, arg1_type a1, arg2_type a2); \
-        static return_type caller(void* self , arg0_type a0, arg1_type a1, arg2_type a2) \
+        static return_type caller(void* self , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type> a0, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type> a1, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type> a2) \
         { \
-            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2)); \
+            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>>(a0), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>>(a1), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>>(a2)); \
         } \
     }; \
     /* create feature getters for the message */ \
@@ -378,6 +381,7 @@
             reinterpret_cast<::dynamix::internal::func_ptr>(&DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)::caller), \
             ::std::numeric_limits<int>::min(), \
             ::std::numeric_limits<int>::min(), \
+            false, \
         }; \
         msg.default_impl_data = &default_impl; \
     } \
@@ -441,15 +445,15 @@
 
 #define DYNAMIX_DEFINE_MESSAGE_4_WITH_DEFAULT_IMPL(return_type, message_name , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3) \
     /* check for correct type */ \
-    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , arg0_type, arg1_type, arg2_type, arg3_type)>::value, \
+    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type>)>::value, \
         "The default implementation must have the same signature as the message."); \
     /* standard message definition */ \
     struct DYNAMIX_DEFAULT_IMPL_STRUCT(message_name) \
     { \
         return_type impl(arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3); \
-        static return_type caller(void* self , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) \
+        static return_type caller(void* self , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type> a0, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type> a1, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type> a2, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type> a3) \
         { \
-            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3)); \
+            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>>(a0), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>>(a1), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>>(a2), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type>>(a3)); \
         } \
     }; \
     /* create feature getters for the message */ \
@@ -473,6 +477,7 @@
             reinterpret_cast<::dynamix::internal::func_ptr>(&DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)::caller), \
             ::std::numeric_limits<int>::min(), \
             ::std::numeric_limits<int>::min(), \
+            false, \
         }; \
         msg.default_impl_data = &default_impl; \
     } \
@@ -536,15 +541,15 @@
 
 #define DYNAMIX_DEFINE_MESSAGE_5_WITH_DEFAULT_IMPL(return_type, message_name , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4) \
     /* check for correct type */ \
-    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , arg0_type, arg1_type, arg2_type, arg3_type, arg4_type)>::value, \
+    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg4_type>)>::value, \
         "The default implementation must have the same signature as the message."); \
     /* standard message definition */ \
     struct DYNAMIX_DEFAULT_IMPL_STRUCT(message_name) \
     { \
         return_type impl(arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4); \
-        static return_type caller(void* self , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) \
+        static return_type caller(void* self , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type> a0, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type> a1, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type> a2, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type> a3, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg4_type> a4) \
         { \
-            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4)); \
+            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>>(a0), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>>(a1), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>>(a2), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type>>(a3), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg4_type>>(a4)); \
         } \
     }; \
     /* create feature getters for the message */ \
@@ -568,6 +573,7 @@
             reinterpret_cast<::dynamix::internal::func_ptr>(&DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)::caller), \
             ::std::numeric_limits<int>::min(), \
             ::std::numeric_limits<int>::min(), \
+            false, \
         }; \
         msg.default_impl_data = &default_impl; \
     } \
@@ -631,15 +637,15 @@
 
 #define DYNAMIX_DEFINE_MESSAGE_6_WITH_DEFAULT_IMPL(return_type, message_name , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4, arg5_type, a5) \
     /* check for correct type */ \
-    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , arg0_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type)>::value, \
+    static_assert(std::is_same<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func, return_type(*)(void* , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg4_type>, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg5_type>)>::value, \
         "The default implementation must have the same signature as the message."); \
     /* standard message definition */ \
     struct DYNAMIX_DEFAULT_IMPL_STRUCT(message_name) \
     { \
         return_type impl(arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5); \
-        static return_type caller(void* self , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) \
+        static return_type caller(void* self , I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type> a0, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type> a1, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type> a2, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type> a3, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg4_type> a4, I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg5_type> a5) \
         { \
-            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4), std::forward<arg5_type>(a5)); \
+            return reinterpret_cast<DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)*>(self)->impl(std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg0_type>>(a0), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg1_type>>(a1), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg2_type>>(a2), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg3_type>>(a3), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg4_type>>(a4), std::forward<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_arg<arg5_type>>(a5)); \
         } \
     }; \
     /* create feature getters for the message */ \
@@ -663,6 +669,7 @@
             reinterpret_cast<::dynamix::internal::func_ptr>(&DYNAMIX_DEFAULT_IMPL_STRUCT(message_name)::caller), \
             ::std::numeric_limits<int>::min(), \
             ::std::numeric_limits<int>::min(), \
+            false, \
         }; \
         msg.default_impl_data = &default_impl; \
     } \
@@ -16,6 +16,7 @@
     struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::message_t \
     { \
         typedef return_type (*caller_func)(void* ); \
+        template <typename T> using caller_arg = T; \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
             : ::dynamix::internal::message_t(I_DYNAMIX_PP_STRINGIZE(message_name), message_mechanism, false) \
         {} \
@@ -53,10 +54,11 @@
         const ::dynamix::object_type_info::call_table_message& _d_msg = _d_call_entry.top_bid_message; \
         DYNAMIX_MSG_THROW_UNLESS(!!_d_msg, ::dynamix::bad_message_call); \
         /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-        char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+        char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
         /* forward unicast arguments since some of them might be rvalue references */ \
+        I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
         return _d_func(_d_mixin_data ); \
     }\
     /* also define a pointer function */ \
@@ -85,10 +87,11 @@
             const ::dynamix::object_type_info::call_table_message& _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             if(!_d_combinator.add_result(_d_func(_d_mixin_data ))) \
             { \
                 return; \
@@ -119,10 +122,11 @@
             const ::dynamix::object_type_info::call_table_message&  _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             _d_func(_d_mixin_data ); \
         } \
     } \
@@ -140,6 +144,7 @@
     struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::message_t \
     { \
         typedef return_type (*caller_func)(void* , arg0_type); \
+        template <typename T> using caller_arg = T; \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
             : ::dynamix::internal::message_t(I_DYNAMIX_PP_STRINGIZE(message_name), message_mechanism, false) \
         {} \
@@ -177,10 +182,11 @@
         const ::dynamix::object_type_info::call_table_message& _d_msg = _d_call_entry.top_bid_message; \
         DYNAMIX_MSG_THROW_UNLESS(!!_d_msg, ::dynamix::bad_message_call); \
         /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-        char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+        char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
         /* forward unicast arguments since some of them might be rvalue references */ \
+        I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
         return _d_func(_d_mixin_data , std::forward<arg0_type>(a0)); \
     }\
     /* also define a pointer function */ \
@@ -209,10 +215,11 @@
             const ::dynamix::object_type_info::call_table_message& _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             if(!_d_combinator.add_result(_d_func(_d_mixin_data , a0))) \
             { \
                 return; \
@@ -243,10 +250,11 @@
             const ::dynamix::object_type_info::call_table_message&  _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             _d_func(_d_mixin_data , a0); \
         } \
     } \
@@ -264,6 +272,7 @@
     struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::message_t \
     { \
         typedef return_type (*caller_func)(void* , arg0_type, arg1_type); \
+        template <typename T> using caller_arg = T; \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
             : ::dynamix::internal::message_t(I_DYNAMIX_PP_STRINGIZE(message_name), message_mechanism, false) \
         {} \
@@ -301,10 +310,11 @@
         const ::dynamix::object_type_info::call_table_message& _d_msg = _d_call_entry.top_bid_message; \
         DYNAMIX_MSG_THROW_UNLESS(!!_d_msg, ::dynamix::bad_message_call); \
         /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-        char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+        char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
         /* forward unicast arguments since some of them might be rvalue references */ \
+        I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
         return _d_func(_d_mixin_data , std::forward<arg0_type>(a0), std::forward<arg1_type>(a1)); \
     }\
     /* also define a pointer function */ \
@@ -333,10 +343,11 @@
             const ::dynamix::object_type_info::call_table_message& _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             if(!_d_combinator.add_result(_d_func(_d_mixin_data , a0, a1))) \
             { \
                 return; \
@@ -367,10 +378,11 @@
             const ::dynamix::object_type_info::call_table_message&  _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             _d_func(_d_mixin_data , a0, a1); \
         } \
     } \
@@ -388,6 +400,7 @@
     struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::message_t \
     { \
         typedef return_type (*caller_func)(void* , arg0_type, arg1_type, arg2_type); \
+        template <typename T> using caller_arg = T; \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
             : ::dynamix::internal::message_t(I_DYNAMIX_PP_STRINGIZE(message_name), message_mechanism, false) \
         {} \
@@ -425,10 +438,11 @@
         const ::dynamix::object_type_info::call_table_message& _d_msg = _d_call_entry.top_bid_message; \
         DYNAMIX_MSG_THROW_UNLESS(!!_d_msg, ::dynamix::bad_message_call); \
         /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-        char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+        char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
         /* forward unicast arguments since some of them might be rvalue references */ \
+        I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
         return _d_func(_d_mixin_data , std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2)); \
     }\
     /* also define a pointer function */ \
@@ -457,10 +471,11 @@
             const ::dynamix::object_type_info::call_table_message& _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             if(!_d_combinator.add_result(_d_func(_d_mixin_data , a0, a1, a2))) \
             { \
                 return; \
@@ -491,10 +506,11 @@
             const ::dynamix::object_type_info::call_table_message&  _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             _d_func(_d_mixin_data , a0, a1, a2); \
         } \
     } \
@@ -512,6 +528,7 @@
     struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::message_t \
     { \
         typedef return_type (*caller_func)(void* , arg0_type, arg1_type, arg2_type, arg3_type); \
+        template <typename T> using caller_arg = T; \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
             : ::dynamix::internal::message_t(I_DYNAMIX_PP_STRINGIZE(message_name), message_mechanism, false) \
         {} \
@@ -549,10 +566,11 @@
         const ::dynamix::object_type_info::call_table_message& _d_msg = _d_call_entry.top_bid_message; \
         DYNAMIX_MSG_THROW_UNLESS(!!_d_msg, ::dynamix::bad_message_call); \
         /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-        char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+        char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
         /* forward unicast arguments since some of them might be rvalue references */ \
+        I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
         return _d_func(_d_mixin_data , std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3)); \
     }\
     /* also define a pointer function */ \
@@ -581,10 +599,11 @@
             const ::dynamix::object_type_info::call_table_message& _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             if(!_d_combinator.add_result(_d_func(_d_mixin_data , a0, a1, a2, a3))) \
             { \
                 return; \
@@ -615,10 +634,11 @@
             const ::dynamix::object_type_info::call_table_message&  _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             _d_func(_d_mixin_data , a0, a1, a2, a3); \
         } \
     } \
@@ -636,6 +656,7 @@
     struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::message_t \
     { \
         typedef return_type (*caller_func)(void* , arg0_type, arg1_type, arg2_type, arg3_type, arg4_type); \
+        template <typename T> using caller_arg = T; \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
             : ::dynamix::internal::message_t(I_DYNAMIX_PP_STRINGIZE(message_name), message_mechanism, false) \
         {} \
@@ -673,10 +694,11 @@
         const ::dynamix::object_type_info::call_table_message& _d_msg = _d_call_entry.top_bid_message; \
         DYNAMIX_MSG_THROW_UNLESS(!!_d_msg, ::dynamix::bad_message_call); \
         /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-        char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+        char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
         /* forward unicast arguments since some of them might be rvalue references */ \
+        I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
         return _d_func(_d_mixin_data , std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4)); \
     }\
     /* also define a pointer function */ \
@@ -705,10 +727,11 @@
             const ::dynamix::object_type_info::call_table_message& _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             if(!_d_combinator.add_result(_d_func(_d_mixin_data , a0, a1, a2, a3, a4))) \
             { \
                 return; \
@@ -739,10 +762,11 @@
             const ::dynamix::object_type_info::call_table_message&  _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             _d_func(_d_mixin_data , a0, a1, a2, a3, a4); \
         } \
     } \
@@ -760,6 +784,7 @@
     struct export I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name) : public ::dynamix::internal::message_t \
     { \
         typedef return_type (*caller_func)(void* , arg0_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type); \
+        template <typename T> using caller_arg = T; \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)() \
             : ::dynamix::internal::message_t(I_DYNAMIX_PP_STRINGIZE(message_name), message_mechanism, false) \
         {} \
@@ -797,10 +822,11 @@
         const ::dynamix::object_type_info::call_table_message& _d_msg = _d_call_entry.top_bid_message; \
         DYNAMIX_MSG_THROW_UNLESS(!!_d_msg, ::dynamix::bad_message_call); \
         /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-        char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+        char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
         /* forward unicast arguments since some of them might be rvalue references */ \
+        I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
         return _d_func(_d_mixin_data , std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4), std::forward<arg5_type>(a5)); \
     }\
     /* also define a pointer function */ \
@@ -829,10 +855,11 @@
             const ::dynamix::object_type_info::call_table_message& _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             if(!_d_combinator.add_result(_d_func(_d_mixin_data , a0, a1, a2, a3, a4, a5))) \
             { \
                 return; \
@@ -863,10 +890,11 @@
             const ::dynamix::object_type_info::call_table_message&  _d_msg = *_d_iter; \
             I_DYNAMIX_ASSERT(!!_d_msg); \
             /* unfortunately we can't assert(_d_msg.data->message == &_d_self); since the data might come from a different module */ \
-            char* _d_mixin_data = reinterpret_cast<char*>(const_cast<void*>(_d_obj._mixin_data[_d_msg.mixin_index].mixin())); \
+            char* _d_mixin_data = I_DYNAMIX_CALL_INSTANCE(constness ::dynamix::object, _d_obj._mixin_data[_d_msg.mixin_index].mixin(), _d_msg.double_buffer_offset); \
             I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func _d_func = \
                 reinterpret_cast<I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::caller_func>(_d_msg.caller); \
             /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
+            I_DYNAMIX_CALL_SEQLOCK(constness ::dynamix::object, _d_obj._type_info, _d_obj._mixin_data, _d_msg.mixin_index); \
             _d_func(_d_mixin_data , a0, a1, a2, a3, a4, a5); \
         } \
     } \
@@ -52,7 +52,7 @@
     export return_type method_name(constness ::dynamix::object* _d_obj ); \
 
 #define I_DYNAMIX_MESSAGE0_MULTI(export, message_name, method_name, return_type, constness ) \
-    I_DYNAMIX_MESSAGE0_DECL(export, message_name, method_name, return_type, constness, unicast ) \
+    I_DYNAMIX_MESSAGE0_DECL(export, message_name, method_name, return_type, constness, multicast ) \
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
@@ -121,10 +121,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -150,7 +150,7 @@
     export return_type method_name(constness ::dynamix::object* _d_obj , arg0_type a0); \
 
 #define I_DYNAMIX_MESSAGE1_MULTI(export, message_name, method_name, return_type, constness , arg0_type, a0) \
-    I_DYNAMIX_MESSAGE1_DECL(export, message_name, method_name, return_type, constness, unicast , arg0_type, a0) \
+    I_DYNAMIX_MESSAGE1_DECL(export, message_name, method_name, return_type, constness, multicast , arg0_type, a0) \
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
@@ -167,9 +167,9 @@
         static_assert(dependent_always_false, "Sadly split message macros don't support combinator calls"); \
     } \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0); \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0); \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0);
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0);
 
 #else
 
@@ -191,13 +191,13 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* sadly combinator calls cannot work with split message macros */ \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0) \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0); \
     } \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0) \
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0); \
@@ -219,10 +219,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -248,7 +248,7 @@
     export return_type method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1); \
 
 #define I_DYNAMIX_MESSAGE2_MULTI(export, message_name, method_name, return_type, constness , arg0_type, a0, arg1_type, a1) \
-    I_DYNAMIX_MESSAGE2_DECL(export, message_name, method_name, return_type, constness, unicast , arg0_type, a0, arg1_type, a1) \
+    I_DYNAMIX_MESSAGE2_DECL(export, message_name, method_name, return_type, constness, multicast , arg0_type, a0, arg1_type, a1) \
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
@@ -265,9 +265,9 @@
         static_assert(dependent_always_false, "Sadly split message macros don't support combinator calls"); \
     } \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1); \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1); \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1);
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1);
 
 #else
 
@@ -289,13 +289,13 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* sadly combinator calls cannot work with split message macros */ \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1) \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1); \
     } \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1) \
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1); \
@@ -317,10 +317,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -346,7 +346,7 @@
     export return_type method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2); \
 
 #define I_DYNAMIX_MESSAGE3_MULTI(export, message_name, method_name, return_type, constness , arg0_type, a0, arg1_type, a1, arg2_type, a2) \
-    I_DYNAMIX_MESSAGE3_DECL(export, message_name, method_name, return_type, constness, unicast , arg0_type, a0, arg1_type, a1, arg2_type, a2) \
+    I_DYNAMIX_MESSAGE3_DECL(export, message_name, method_name, return_type, constness, multicast , arg0_type, a0, arg1_type, a1, arg2_type, a2) \
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
@@ -363,9 +363,9 @@
         static_assert(dependent_always_false, "Sadly split message macros don't support combinator calls"); \
     } \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2); \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2); \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2);
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2);
 
 #else
 
@@ -387,13 +387,13 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* sadly combinator calls cannot work with split message macros */ \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2) \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2); \
     } \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2) \
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2); \
@@ -415,10 +415,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2, caller_arg<arg3_type> a3) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2), std::forward<caller_arg<arg3_type>>(a3)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -444,7 +444,7 @@
     export return_type method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3); \
 
 #define I_DYNAMIX_MESSAGE4_MULTI(export, message_name, method_name, return_type, constness , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3) \
-    I_DYNAMIX_MESSAGE4_DECL(export, message_name, method_name, return_type, constness, unicast , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3) \
+    I_DYNAMIX_MESSAGE4_DECL(export, message_name, method_name, return_type, constness, multicast , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3) \
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
@@ -461,9 +461,9 @@
         static_assert(dependent_always_false, "Sadly split message macros don't support combinator calls"); \
     } \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3); \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3); \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3);
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3);
 
 #else
 
@@ -485,13 +485,13 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* sadly combinator calls cannot work with split message macros */ \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2, a3); \
     } \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) \
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2, a3); \
@@ -513,10 +513,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2, caller_arg<arg3_type> a3, caller_arg<arg4_type> a4) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2), std::forward<caller_arg<arg3_type>>(a3), std::forward<caller_arg<arg4_type>>(a4)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -542,7 +542,7 @@
     export return_type method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4); \
 
 #define I_DYNAMIX_MESSAGE5_MULTI(export, message_name, method_name, return_type, constness , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4) \
-    I_DYNAMIX_MESSAGE5_DECL(export, message_name, method_name, return_type, constness, unicast , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4) \
+    I_DYNAMIX_MESSAGE5_DECL(export, message_name, method_name, return_type, constness, multicast , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4) \
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
@@ -559,9 +559,9 @@
         static_assert(dependent_always_false, "Sadly split message macros don't support combinator calls"); \
     } \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4); \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4); \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4);
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4);
 
 #else
 
@@ -583,13 +583,13 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* sadly combinator calls cannot work with split message macros */ \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2, a3, a4); \
     } \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) \
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2, a3, a4); \
@@ -611,10 +611,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2, caller_arg<arg3_type> a3, caller_arg<arg4_type> a4, caller_arg<arg5_type> a5) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4), std::forward<arg5_type>(a5)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2), std::forward<caller_arg<arg3_type>>(a3), std::forward<caller_arg<arg4_type>>(a4), std::forward<caller_arg<arg5_type>>(a5)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -640,7 +640,7 @@
     export return_type method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5); \
 
 #define I_DYNAMIX_MESSAGE6_MULTI(export, message_name, method_name, return_type, constness , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4, arg5_type, a5) \
-    I_DYNAMIX_MESSAGE6_DECL(export, message_name, method_name, return_type, constness, unicast , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4, arg5_type, a5) \
+    I_DYNAMIX_MESSAGE6_DECL(export, message_name, method_name, return_type, constness, multicast , arg0_type, a0, arg1_type, a1, arg2_type, a2, arg3_type, a3, arg4_type, a4, arg5_type, a5) \
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
@@ -657,9 +657,9 @@
         static_assert(dependent_always_false, "Sadly split message macros don't support combinator calls"); \
     } \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5); \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5); \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5);
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5);
 
 #else
 
@@ -681,13 +681,13 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* sadly combinator calls cannot work with split message macros */ \
     /* function C: no combinator */ \
-    export void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) \
+    export void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2, a3, a4, a5); \
     } \
     /* also define a pointer function with no combinator */ \
-    export void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) \
+    export void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2, a3, a4, a5); \
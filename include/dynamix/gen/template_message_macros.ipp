@@ -102,10 +102,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -139,14 +139,14 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
-    void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, Combinator& _d_combinator) \
+    void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, Combinator& _d_combinator) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_combinator_call(_d_obj, _d_combinator , a0); \
     } \
     /* function B: template combinator -> can be called on a single line */ \
     template <template <typename> class Combinator> \
-    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , arg0_type a0) \
+    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0) \
     { \
         Combinator<return_type> _d_combinator; \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
@@ -154,13 +154,13 @@
         return _d_combinator.result(); \
     } \
     /* function C: no combinator */ \
-    inline void method_name(constness ::dynamix::object& _d_obj , arg0_type a0) \
+    inline void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0); \
     } \
     /* also define a pointer function with no combinator */ \
-    inline void method_name(constness ::dynamix::object* _d_obj , arg0_type a0) \
+    inline void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0); \
@@ -181,10 +181,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -218,14 +218,14 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
-    void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, Combinator& _d_combinator) \
+    void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, Combinator& _d_combinator) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_combinator_call(_d_obj, _d_combinator , a0, a1); \
     } \
     /* function B: template combinator -> can be called on a single line */ \
     template <template <typename> class Combinator> \
-    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1) \
+    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1) \
     { \
         Combinator<return_type> _d_combinator; \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
@@ -233,13 +233,13 @@
         return _d_combinator.result(); \
     } \
     /* function C: no combinator */ \
-    inline void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1) \
+    inline void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1); \
     } \
     /* also define a pointer function with no combinator */ \
-    inline void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1) \
+    inline void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1); \
@@ -260,10 +260,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -297,14 +297,14 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
-    void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, Combinator& _d_combinator) \
+    void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, Combinator& _d_combinator) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_combinator_call(_d_obj, _d_combinator , a0, a1, a2); \
     } \
     /* function B: template combinator -> can be called on a single line */ \
     template <template <typename> class Combinator> \
-    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2) \
+    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2) \
     { \
         Combinator<return_type> _d_combinator; \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
@@ -312,13 +312,13 @@
         return _d_combinator.result(); \
     } \
     /* function C: no combinator */ \
-    inline void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2) \
+    inline void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2); \
     } \
     /* also define a pointer function with no combinator */ \
-    inline void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2) \
+    inline void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2); \
@@ -339,10 +339,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2, caller_arg<arg3_type> a3) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2), std::forward<caller_arg<arg3_type>>(a3)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -376,14 +376,14 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
-    void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, Combinator& _d_combinator) \
+    void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, Combinator& _d_combinator) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_combinator_call(_d_obj, _d_combinator , a0, a1, a2, a3); \
     } \
     /* function B: template combinator -> can be called on a single line */ \
     template <template <typename> class Combinator> \
-    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) \
+    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3) \
     { \
         Combinator<return_type> _d_combinator; \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
@@ -391,13 +391,13 @@
         return _d_combinator.result(); \
     } \
     /* function C: no combinator */ \
-    inline void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) \
+    inline void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2, a3); \
     } \
     /* also define a pointer function with no combinator */ \
-    inline void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3) \
+    inline void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2, a3); \
@@ -418,10 +418,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2, caller_arg<arg3_type> a3, caller_arg<arg4_type> a4) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2), std::forward<caller_arg<arg3_type>>(a3), std::forward<caller_arg<arg4_type>>(a4)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -455,14 +455,14 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
-    void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, Combinator& _d_combinator) \
+    void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, Combinator& _d_combinator) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_combinator_call(_d_obj, _d_combinator , a0, a1, a2, a3, a4); \
     } \
     /* function B: template combinator -> can be called on a single line */ \
     template <template <typename> class Combinator> \
-    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) \
+    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4) \
     { \
         Combinator<return_type> _d_combinator; \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
@@ -470,13 +470,13 @@
         return _d_combinator.result(); \
     } \
     /* function C: no combinator */ \
-    inline void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) \
+    inline void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2, a3, a4); \
     } \
     /* also define a pointer function with no combinator */ \
-    inline void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) \
+    inline void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2, a3, a4); \
@@ -497,10 +497,10 @@
         ::dynamix::internal::func_ptr get_caller_for() const \
         { \
             /* prevent the linker from optimizing away the caller function */ \
-            static caller_func the_caller = [](void* _d_mixin , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) -> return_type \
+            static caller_func the_caller = [](void* _d_mixin , caller_arg<arg0_type> a0, caller_arg<arg1_type> a1, caller_arg<arg2_type> a2, caller_arg<arg3_type> a3, caller_arg<arg4_type> a4, caller_arg<arg5_type> a5) -> return_type \
             { \
                 constness Mixin* _d_m = reinterpret_cast<Mixin*>(_d_mixin); \
-                return _d_m->method_name(std::forward<arg0_type>(a0), std::forward<arg1_type>(a1), std::forward<arg2_type>(a2), std::forward<arg3_type>(a3), std::forward<arg4_type>(a4), std::forward<arg5_type>(a5)); \
+                return _d_m->method_name(std::forward<caller_arg<arg0_type>>(a0), std::forward<caller_arg<arg1_type>>(a1), std::forward<caller_arg<arg2_type>>(a2), std::forward<caller_arg<arg3_type>>(a3), std::forward<caller_arg<arg4_type>>(a4), std::forward<caller_arg<arg5_type>>(a5)); \
             }; \
             /* cast the caller to a void (*)() - safe according to the standard */ \
             return reinterpret_cast< ::dynamix::internal::func_ptr>(the_caller); \
@@ -534,14 +534,14 @@
     /* step 4: define the message functions -> the one that will be called for the objects */ \
     /* function A: concrete combinator */ \
     template <typename Combinator> \
-    void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, Combinator& _d_combinator) \
+    void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5, Combinator& _d_combinator) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_combinator_call(_d_obj, _d_combinator , a0, a1, a2, a3, a4, a5); \
     } \
     /* function B: template combinator -> can be called on a single line */ \
     template <template <typename> class Combinator> \
-    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) \
+    typename Combinator<return_type>::result_type method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5) \
     { \
         Combinator<return_type> _d_combinator; \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
@@ -549,13 +549,13 @@
         return _d_combinator.result(); \
     } \
     /* function C: no combinator */ \
-    inline void method_name(constness ::dynamix::object& _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) \
+    inline void method_name(constness ::dynamix::object& _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5) \
     { \
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(_d_obj , a0, a1, a2, a3, a4, a5); \
     } \
     /* also define a pointer function with no combinator */ \
-    inline void method_name(constness ::dynamix::object* _d_obj , arg0_type a0, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) \
+    inline void method_name(constness ::dynamix::object* _d_obj , ::dynamix::internal::multicast_arg<arg0_type> a0, ::dynamix::internal::multicast_arg<arg1_type> a1, ::dynamix::internal::multicast_arg<arg2_type> a2, ::dynamix::internal::multicast_arg<arg3_type> a3, ::dynamix::internal::multicast_arg<arg4_type> a4, ::dynamix::internal::multicast_arg<arg5_type> a5) \
     {\
         /* not forwarded arguments. We DO want an error if some of them are rvalue references */ \
         I_DYNAMIX_MESSAGE_STRUCT_NAME(message_name)::make_call(*_d_obj , a0, a1, a2, a3, a4, a5); \
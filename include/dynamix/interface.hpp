@@ -0,0 +1,146 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * A view of an object as a set of unicast messages.
+ *
+ * An interface is a list of unicast messages:
+ * `typedef dynamix::interface<decltype(draw_msg), decltype(get_layer_msg)> renderable;`
+ *
+ * For each object type the messages of an interface are resolved once, on first use,
+ * and the result is cached in the type. A view of an object as the interface
+ * (`renderable r(obj);`) points to this table, so its calls (`r.call(draw_msg)`)
+ * skip the lookup of the message in the call table of the type.
+ * This makes them a cheap alternative to adapter classes with virtual methods
+ * which call messages.
+ *
+ * A view is valid until its object is mutated or destroyed.
+ *
+ * `call` calls the messages through their message structs, which the legacy message
+ * macros don't provide, so it's not available with DYNAMIX_USE_LEGACY_MESSAGE_MACROS.
+ */
+
+#include "config.hpp"
+#include "object.hpp"
+#include "object_type_info.hpp"
+#include "exception.hpp"
+#include "internal/message_callers.hpp"
+#include "internal/assert.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace dynamix
+{
+
+namespace internal
+{
+// returns a new id for an interface, called once per interface type
+DYNAMIX_API uint32_t new_interface_id();
+
+// resolves the messages of an interface in a type and caches the result in it
+DYNAMIX_API const object_type_info::call_table_message* make_interface_table(
+    const object_type_info& type, uint32_t interface_id, const feature_id* messages, size_t num_messages);
+
+// index of a message in the list of messages of an interface
+template <typename Message, typename... Messages>
+struct interface_message_index;
+
+template <typename Message, typename... Messages>
+struct interface_message_index<Message, Message, Messages...> : std::integral_constant<size_t, 0> {};
+
+template <typename Message, typename Other, typename... Messages>
+struct interface_message_index<Message, Other, Messages...>
+    : std::integral_constant<size_t, 1 + interface_message_index<Message, Messages...>::value> {};
+} // namespace internal
+
+/// A view of an object as a set of unicast messages (see interface.hpp).
+/// The messages are either their types or the types of their tags (`decltype(draw_msg)`).
+template <typename... Messages>
+class interface
+{
+public:
+    explicit interface(object& obj)
+        : _obj(&obj)
+        , _type(obj._type_info)
+    {
+        _table = _type->_interface_tables[id()].load(std::memory_order_acquire);
+        if (!_table)
+        {
+            const feature_id messages[] = {
+                _dynamix_get_mixin_feature_safe(static_cast<typename std::remove_pointer<Messages>::type*>(nullptr)).id...
+            };
+            _table = internal::make_interface_table(*_type, id(), messages, sizeof...(Messages));
+        }
+    }
+
+    object& get_object() const { return *_obj; }
+
+    /// Checks whether the object implements all messages of the interface
+    /// (either by its mixins or with default implementations)
+    bool implemented() const noexcept
+    {
+        for (size_t i = 0; i < sizeof...(Messages); ++i)
+        {
+            if (!_table[i]) return false;
+        }
+        return true;
+    }
+
+    /// Checks whether the object implements a message of the interface
+    template <typename Message>
+    bool implements(Message*) const noexcept
+    {
+        return !!_table[internal::interface_message_index<Message*, tag<Messages>...>::value];
+    }
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    /// Calls a message of the interface
+    template <typename Message, typename... Args>
+    typename Message::return_type call(Message*, Args&&... args) const
+    {
+        typedef typename std::remove_pointer<
+            decltype(internal::message_object_of(&Message::make_call))>::type message_object;
+
+        I_DYNAMIX_ASSERT_MSG(_obj->_type_info == _type, "the object was mutated after the interface view was made");
+
+        const auto& msg = _table[internal::interface_message_index<Message*, tag<Messages>...>::value];
+        DYNAMIX_MSG_THROW_UNLESS(!!msg, bad_message_call);
+
+        message_object& obj = *_obj;
+        internal::invalidate_memos_on_call(obj);
+
+        char* mixin_data = I_DYNAMIX_CALL_INSTANCE(message_object,
+            _obj->_mixin_data[msg.mixin_index].mixin(), msg.double_buffer_offset);
+        auto func = reinterpret_cast<typename Message::caller_func>(msg.caller);
+
+        I_DYNAMIX_CALL_SEQLOCK(message_object, _type, _obj->_mixin_data, msg.mixin_index);
+        return func(mixin_data, std::forward<Args>(args)...);
+    }
+#endif
+
+    static uint32_t id()
+    {
+        static const uint32_t the_id = internal::new_interface_id();
+        return the_id;
+    }
+
+private:
+    // messages given as the message types are made pointers, like their tags
+    template <typename Message>
+    using tag = typename std::add_pointer<typename std::remove_pointer<Message>::type>::type;
+
+    object* _obj;
+    const object_type_info* _type;
+    const object_type_info::call_table_message* _table;
+};
+
+} // namespace dynamix
@@ -18,6 +18,7 @@
 #include "../features.hpp"
 #include "../object_type_info.hpp"
 #include "../message_features.hpp"
+#include "../fact.hpp"
 
 namespace dynamix
 {
@@ -50,6 +51,14 @@ public:
         return operator&(static_cast<Message*>(nullptr));
     }
 
+    template <typename Fact>
+    feature_parser_phase_1& operator & (const fact_perks<Fact>&)
+    {
+        // facts are only provided with a value, so there is nothing to count
+        _dynamix_register_mixin_feature(static_cast<Fact*>(nullptr));
+        return *this;
+    }
+
     feature_parser_phase_1& operator & (mixin_allocator& allocator)
     {
         info.allocator = &allocator;
@@ -68,6 +77,31 @@ public:
         return *this;
     }
 
+    feature_parser_phase_1& operator & (mixin_sibling_feature s)
+    {
+        // the link id is set when the mixin is registered
+        info.required_siblings.push_back({s.sibling, ~uint32_t(0)});
+        return *this;
+    }
+
+    feature_parser_phase_1& operator & (mixin_teardown_feature)
+    {
+        info.destroy_on_teardown = true;
+        return *this;
+    }
+
+    feature_parser_phase_1& operator & (mixin_double_buffered_feature)
+    {
+        info.double_buffered = true;
+        return *this;
+    }
+
+    feature_parser_phase_1& operator & (mixin_seqlocked_feature)
+    {
+        info.seqlocked = true;
+        return *this;
+    }
+
     feature_parser_phase_1& operator & (const noop_feature_t*) { return *this; }
 
     // counters
@@ -104,7 +138,7 @@ public:
     feature_parser_phase_2& operator & (message_perks<Message> mp)
     {
         Message& msg = get_registered_feature<Message>();
-        parse_message(msg, mp.bid, mp.priority, msg.template get_caller_for<Mixin>());
+        parse_message(msg, mp.bid, mp.priority, mp.pure, msg.template get_caller_for<Mixin>());
         return *this;
     }
 
@@ -112,7 +146,15 @@ public:
     feature_parser_phase_2& operator & (message_perks_and_caller<Message> mp)
     {
         Message& msg = get_registered_feature<Message>();
-        parse_message(msg, mp.bid, mp.priority, mp.caller);
+        parse_message(msg, mp.bid, mp.priority, mp.pure, mp.caller);
+        return *this;
+    }
+
+    template <typename Fact>
+    feature_parser_phase_2& operator & (fact_perks<Fact> fp)
+    {
+        Fact& f = get_registered_feature<Fact>();
+        parse_fact(f, std::move(fp.value), fp.bid, fp.priority);
         return *this;
     }
 
@@ -120,6 +162,10 @@ public:
     feature_parser_phase_2& operator & (mixin_allocator&) { return *this; }
     feature_parser_phase_2& operator & (mixin_name_feature) { return *this; }
     feature_parser_phase_2& operator & (mixin_user_data_feature) { return *this; }
+    feature_parser_phase_2& operator & (mixin_sibling_feature) { return *this; }
+    feature_parser_phase_2& operator & (mixin_teardown_feature) { return *this; }
+    feature_parser_phase_2& operator & (mixin_double_buffered_feature) { return *this; }
+    feature_parser_phase_2& operator & (mixin_seqlocked_feature) { return *this; }
 
     feature_parser_phase_2& operator & (const noop_feature_t*) { return *this; }
 
@@ -135,10 +181,10 @@ private:
     template <typename Message>
     void parse_feature(Message& msg, const message_feature_tag&)
     {
-        parse_message(msg, 0, 0, msg.template get_caller_for<Mixin>());
+        parse_message(msg, 0, 0, false, msg.template get_caller_for<Mixin>());
     }
 
-    void parse_message(message_t& msg, int bid, int priority, func_ptr caller)
+    void parse_message(message_t& msg, int bid, int priority, bool pure, func_ptr caller)
     {
 #if DYNAMIX_DEBUG
         // check for duplicate entries
@@ -154,6 +200,19 @@ private:
         mfm.caller = caller;
         mfm.bid = bid;
         mfm.priority = priority;
+        mfm.pure = pure;
+    }
+
+    void parse_fact(fact_t& f, std::shared_ptr<const void> value, int bid, int priority)
+    {
+#if DYNAMIX_DEBUG
+        // check for duplicate entries
+        for (const fact_for_mixin& fact_info : info.fact_infos)
+        {
+            I_DYNAMIX_ASSERT(fact_info.fact != &f); // duplicate fact. You have "fact(x_fact, a) & ... & fact(x_fact, b)"
+        }
+#endif
+        info.fact_infos.push_back({&f, std::move(value), bid, priority});
     }
 
     mixin_type_info& info;
@@ -11,20 +11,122 @@
 #include "../message.hpp"
 #include "../exception.hpp"
 #include "../object_type_info.hpp"
+#include "../double_buffer.hpp"
+#include "../seqlock.hpp"
+#include "mixin_data_in_object.hpp"
+#include "message_id_cache.hpp"
 #include "assert.hpp"
 
+#include <type_traits>
+
+#if DYNAMIX_TRACE_MESSAGES
+#   include "../trace.hpp"
+#   define I_DYNAMIX_TRACE_MESSAGE(msg) ::dynamix::trace::message_scope _dynamix_trace_scope(msg.name)
+#else
+#   define I_DYNAMIX_TRACE_MESSAGE(msg)
+#endif
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+#   include "../concurrent_mutations.hpp"
+#endif
+
+#if DYNAMIX_RECORD_MESSAGES
+#   include "../workload.hpp"
+#   define I_DYNAMIX_RECORD_MESSAGE(obj, msg, arg_types) \
+        static const uint32_t _dynamix_arg_sizes[] = { 0, uint32_t(sizeof(arg_types))... }; \
+        ::dynamix::internal::record_message_call(obj, msg, _dynamix_arg_sizes + 1, uint32_t(sizeof...(arg_types)))
+#else
+#   define I_DYNAMIX_RECORD_MESSAGE(obj, msg, arg_types)
+#endif
+
 namespace dynamix
 {
+class object;
+
+// drops the memoized message results of an object (see memo.hpp)
+DYNAMIX_API void invalidate_memos(const object& obj) noexcept;
+
 namespace internal
 {
 
+#if DYNAMIX_INLINE_MESSAGE_IDS
+// the feature is only obtained when it's needed by the asserts or the other hooks
+#   define I_DYNAMIX_MESSAGE_SELF(Message) \
+        const ::dynamix::feature_id _dynamix_msg_id = ::dynamix::internal::message_id_cache<Message>::get()
+#   define I_DYNAMIX_MESSAGE_FEATURE(Message) _dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr))
+#   define I_DYNAMIX_MESSAGE_ID _dynamix_msg_id
+#else
+#   define I_DYNAMIX_MESSAGE_SELF(Message) \
+        const ::dynamix::feature& _dynamix_msg_self = _dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr))
+#   define I_DYNAMIX_MESSAGE_FEATURE(Message) _dynamix_msg_self
+#   define I_DYNAMIX_MESSAGE_ID _dynamix_msg_self.id
+#endif
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+// the type and the mixin data come from a single load of the published mixin data
+// so they're consistent even if the object is being mutated in another thread
+#   define I_DYNAMIX_OBJECT_STATE(obj) \
+        ::dynamix::read_scope _dynamix_read_scope; \
+        ::dynamix::internal::mixin_data_in_object* const _dynamix_mixin_data = \
+            obj._published_mixin_data.load(std::memory_order_acquire); \
+        const ::dynamix::object_type_info* const _dynamix_type_info = \
+            ::dynamix::object_type_info::of_mixin_data(_dynamix_mixin_data)
+#else
+#   define I_DYNAMIX_OBJECT_STATE(obj) \
+        ::dynamix::internal::mixin_data_in_object* const _dynamix_mixin_data = obj._mixin_data; \
+        const ::dynamix::object_type_info* const _dynamix_type_info = obj._type_info
+#endif
+
 // defines calling function
 template <typename Ret, typename... Args>
 struct msg_caller
 {
     using caller_func = Ret (*)(void*, Args...);
+    using return_type = Ret;
 };
 
+// multicast messages pass the arguments which are declared by value as const references
+// from the message function through the callers of all implementers
+// thus they're never copied on the way and methods which take them by value copy them once each
+// scalars are still passed by value
+template <typename T>
+struct multicast_arg_traits
+{
+    using type = typename std::conditional<std::is_scalar<T>::value, T, const T&>::type;
+};
+template <typename T>
+struct multicast_arg_traits<T&>
+{
+    using type = T&;
+};
+template <typename T>
+struct multicast_arg_traits<T&&>
+{
+    using type = T&&;
+};
+template <typename T>
+using multicast_arg = typename multicast_arg_traits<T>::type;
+
+// non-const messages may change the state of the mixins,
+// so they invalidate the memoized results of pure messages of the object
+// without DYNAMIX_MEMOS this is empty and the calls don't touch the memos at all
+template <typename Object>
+void invalidate_memos_on_call(Object& obj) noexcept
+{
+#if DYNAMIX_MEMOS
+    if (!std::is_const<Object>::value)
+    {
+        invalidate_memos(obj);
+    }
+#else
+    (void)obj;
+#endif
+}
+
+// deduces the object type (with its constness) of a message from its make_call
+template <typename Ret, typename Object, typename... Args>
+Object* message_object_of(Ret (*)(Object&, Args...));
+
 // instead of adding the multi and unicast calls in the same struct, we split it in two
 // thus multicast messages, won't also instantiate and compile the unicast call and vice-versa
 
@@ -39,14 +141,22 @@ struct msg_unicast : public message_t, public msg_caller<Ret, Args...>
         : message_t(message_name, message_t::unicast, false)
     {}
 
+    // type of an argument of the callers of the message
+    template <typename T>
+    using caller_arg = T;
+
     static Ret make_call(Object& obj, Args&&... args)
     {
-        const ::dynamix::feature& self = _dynamix_get_mixin_feature_fast(static_cast<Derived*>(nullptr));
-        I_DYNAMIX_ASSERT(static_cast<const message_t&>(self).mechanism
+        I_DYNAMIX_MESSAGE_SELF(Derived);
+        I_DYNAMIX_ASSERT(static_cast<const message_t&>(I_DYNAMIX_MESSAGE_FEATURE(Derived)).mechanism
             == message_t::unicast);
+        I_DYNAMIX_TRACE_MESSAGE(I_DYNAMIX_MESSAGE_FEATURE(Derived));
+        I_DYNAMIX_RECORD_MESSAGE(obj, I_DYNAMIX_MESSAGE_FEATURE(Derived), Args);
+        invalidate_memos_on_call(obj);
 
+        I_DYNAMIX_OBJECT_STATE(obj);
         const object_type_info::call_table_entry& call_entry =
-            obj._type_info->_call_table[self.id];
+            _dynamix_type_info->_call_table[I_DYNAMIX_MESSAGE_ID];
 
         const object_type_info::call_table_message& msg = call_entry.top_bid_message;
         DYNAMIX_MSG_THROW_UNLESS(!!msg, ::dynamix::bad_message_call);
@@ -54,12 +164,20 @@ struct msg_unicast : public message_t, public msg_caller<Ret, Args...>
         // unfortunately we can't assert(msg_data.data->message == &self); since the data might come from a different module
 
         // skipping several function calls, which greatly improves build time
-        char* mixin_data = reinterpret_cast<char*>(const_cast<void*>(obj._mixin_data[msg.mixin_index].mixin()));
+        char* mixin_data = I_DYNAMIX_CALL_INSTANCE(Object, _dynamix_mixin_data[msg.mixin_index].mixin(), msg.double_buffer_offset);
 
         auto func = reinterpret_cast<typename msg_caller<Ret, Args...>::caller_func>(msg.caller);
 
+        I_DYNAMIX_CALL_SEQLOCK(Object, _dynamix_type_info, _dynamix_mixin_data, msg.mixin_index);
         return func(mixin_data, std::forward<Args>(args)...);
     }
+
+    // by-value entry point for the variadic message functions
+    // (see declare_message_variadic.hpp)
+    static Ret call(Object& obj, Args... args)
+    {
+        return make_call(obj, std::forward<Args>(args)...);
+    }
 };
 
 // caller struct instantiated by message macros
@@ -67,21 +185,31 @@ struct msg_unicast : public message_t, public msg_caller<Ret, Args...>
 // Object - dynamix::object but having the appropriate constness
 // Ret and Args - message signature
 template <typename Derived, typename Object, typename Ret, typename... Args>
-struct msg_multicast : public message_t, public msg_caller<Ret, Args...>
+struct msg_multicast : public message_t, public msg_caller<Ret, multicast_arg<Args>...>
 {
     msg_multicast(const char* message_name)
         : message_t(message_name, message_t::multicast, false)
     {}
 
+    // type of an argument of the callers of the message
+    template <typename T>
+    using caller_arg = multicast_arg<T>;
+
+    using caller_func = typename msg_caller<Ret, multicast_arg<Args>...>::caller_func;
+
     template <typename Combinator>
-    static void make_combinator_call(Object& obj, Combinator& combinator, Args&... args)
+    static void make_combinator_call(Object& obj, Combinator& combinator, multicast_arg<Args>... args)
     {
-        const ::dynamix::feature& self = _dynamix_get_mixin_feature_fast(static_cast<Derived*>(nullptr));
-        I_DYNAMIX_ASSERT(static_cast<const message_t&>(self).mechanism
+        I_DYNAMIX_MESSAGE_SELF(Derived);
+        I_DYNAMIX_ASSERT(static_cast<const message_t&>(I_DYNAMIX_MESSAGE_FEATURE(Derived)).mechanism
             == message_t::multicast);
+        I_DYNAMIX_TRACE_MESSAGE(I_DYNAMIX_MESSAGE_FEATURE(Derived));
+        I_DYNAMIX_RECORD_MESSAGE(obj, I_DYNAMIX_MESSAGE_FEATURE(Derived), Args);
+        invalidate_memos_on_call(obj);
 
+        I_DYNAMIX_OBJECT_STATE(obj);
         const object_type_info::call_table_entry& call_entry =
-            obj._type_info->_call_table[self.id];
+            _dynamix_type_info->_call_table[I_DYNAMIX_MESSAGE_ID];
 
         auto begin = call_entry.begin;
         auto end = call_entry.end;
@@ -97,10 +225,11 @@ struct msg_multicast : public message_t, public msg_caller<Ret, Args...>
             // unfortunately we can't assert(msg_data->message == &self); since the data might come from a different module
 
             // skipping several function calls, which greatly improves build time
-            char* mixin_data = reinterpret_cast<char*>(const_cast<void*>(obj._mixin_data[msg.mixin_index].mixin()));
+            char* mixin_data = I_DYNAMIX_CALL_INSTANCE(Object, _dynamix_mixin_data[msg.mixin_index].mixin(), msg.double_buffer_offset);
 
-            auto func = reinterpret_cast<typename msg_caller<Ret, Args...>::caller_func>(msg.caller);
+            auto func = reinterpret_cast<caller_func>(msg.caller);
 
+            I_DYNAMIX_CALL_SEQLOCK(Object, _dynamix_type_info, _dynamix_mixin_data, msg.mixin_index);
             if (!combinator.add_result(func(mixin_data, args...)))
             {
                 return;
@@ -117,14 +246,18 @@ struct msg_multicast : public message_t, public msg_caller<Ret, Args...>
     //     constexpr bool add_result(R&& r) const { return true; }
     // };
     // with c++17 we would be able to add if constexpr(is_same(void, Ret)) to make it work
-    static void make_call(Object& obj, Args&... args)
+    static void make_call(Object& obj, multicast_arg<Args>... args)
     {
-        const ::dynamix::feature& self = _dynamix_get_mixin_feature_fast(static_cast<Derived*>(nullptr));
-        I_DYNAMIX_ASSERT(static_cast<const message_t&>(self).mechanism
+        I_DYNAMIX_MESSAGE_SELF(Derived);
+        I_DYNAMIX_ASSERT(static_cast<const message_t&>(I_DYNAMIX_MESSAGE_FEATURE(Derived)).mechanism
             == message_t::multicast);
+        I_DYNAMIX_TRACE_MESSAGE(I_DYNAMIX_MESSAGE_FEATURE(Derived));
+        I_DYNAMIX_RECORD_MESSAGE(obj, I_DYNAMIX_MESSAGE_FEATURE(Derived), Args);
+        invalidate_memos_on_call(obj);
 
+        I_DYNAMIX_OBJECT_STATE(obj);
         const object_type_info::call_table_entry& call_entry =
-            obj._type_info->_call_table[self.id];
+            _dynamix_type_info->_call_table[I_DYNAMIX_MESSAGE_ID];
 
         auto begin = call_entry.begin;
         auto end = call_entry.end;
@@ -139,13 +272,27 @@ struct msg_multicast : public message_t, public msg_caller<Ret, Args...>
             // unfortunately we can't assert(msg_data->message == &self); since the data might come from a different module
 
             // skipping several function calls, which greatly improves build time
-            char* mixin_data = reinterpret_cast<char*>(const_cast<void*>(obj._mixin_data[msg.mixin_index].mixin()));
+            char* mixin_data = I_DYNAMIX_CALL_INSTANCE(Object, _dynamix_mixin_data[msg.mixin_index].mixin(), msg.double_buffer_offset);
 
-            auto func = reinterpret_cast<typename msg_caller<Ret, Args...>::caller_func>(msg.caller);
+            auto func = reinterpret_cast<caller_func>(msg.caller);
 
+            I_DYNAMIX_CALL_SEQLOCK(Object, _dynamix_type_info, _dynamix_mixin_data, msg.mixin_index);
             func(mixin_data, args...);
         }
     }
+
+    // entry points for the variadic message functions
+    // (see declare_message_variadic.hpp)
+    static void call(Object& obj, multicast_arg<Args>... args)
+    {
+        make_call(obj, args...);
+    }
+
+    template <typename Combinator>
+    static void combinator_call(Object& obj, Combinator& combinator, multicast_arg<Args>... args)
+    {
+        make_combinator_call(obj, combinator, args...);
+    }
 };
 } // namespace internal
 } // namespace dynamix
@@ -0,0 +1,77 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+#include "../config.hpp"
+
+#if DYNAMIX_INLINE_MESSAGE_IDS
+
+#if defined(_WIN32) && defined(DYNAMIX_DYNLIB)
+#   error "DYNAMIX_INLINE_MESSAGE_IDS is not supported when DynaMix is a DLL, as template statics are not shared between modules on Windows"
+#endif
+
+#include "../feature.hpp"
+
+#include <atomic>
+
+#if defined(DYNAMIX_DYNLIB)
+#   define I_DYNAMIX_MESSAGE_ID_CACHE_VISIBILITY DYNAMIX_SYMBOL_EXPORT
+#else
+#   define I_DYNAMIX_MESSAGE_ID_CACHE_VISIBILITY
+#endif
+
+namespace dynamix
+{
+namespace internal
+{
+
+// cache of the id of a message in the calling code
+// relaxed atomic loads compile to plain loads, so getting the id is a single load
+// which the optimizer can see
+//
+// the cache is filled and reset by the registrator of the message
+// (see define_message.hpp), so it must be shared by all modules, or modules without the
+// definition of the message would keep a stale id after a plugin which defines it is reloaded
+// template statics with default visibility are merged by the dynamic linker on ELF platforms
+// (thus the explicit visibility for exported messages in modules built with a hidden one), but they're not on
+// Windows, where this option is refused for DynaMix as a DLL
+template <typename Message>
+struct I_DYNAMIX_MESSAGE_ID_CACHE_VISIBILITY message_id_cache
+{
+    static std::atomic<feature_id> id;
+
+    static feature_id get() noexcept
+    {
+        feature_id ret = id.load(std::memory_order_relaxed);
+        if (ret == INVALID_FEATURE_ID)
+        {
+            ret = resolve();
+        }
+        return ret;
+    }
+
+    // uses the safe getter as it's also called from the message registrator
+    static feature_id resolve() noexcept
+    {
+        feature_id ret = _dynamix_get_mixin_feature_safe(static_cast<Message*>(nullptr)).id;
+        id.store(ret, std::memory_order_relaxed);
+        return ret;
+    }
+
+    static void reset() noexcept
+    {
+        id.store(INVALID_FEATURE_ID, std::memory_order_relaxed);
+    }
+};
+template <typename Message>
+std::atomic<feature_id> message_id_cache<Message>::id = {INVALID_FEATURE_ID};
+
+} // namespace internal
+} // namespace dynamix
+
+#endif
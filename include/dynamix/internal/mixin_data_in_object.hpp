@@ -30,12 +30,18 @@ public:
         _mixin = buffer + mixin_offset;
     }
 
-    void set_object(object* o)
+    // double-buffered mixins also have the object in front of their second instance
+    void set_object(object* o, size_t double_buffer_offset = 0)
     {
         I_DYNAMIX_ASSERT(o);
         I_DYNAMIX_ASSERT(_buffer);
         object** data_as_objec_ptr = reinterpret_cast<object**>(_mixin - sizeof(object*));
         *data_as_objec_ptr = o;
+        if (double_buffer_offset)
+        {
+            data_as_objec_ptr = reinterpret_cast<object**>(_mixin + double_buffer_offset - sizeof(object*));
+            *data_as_objec_ptr = o;
+        }
     }
 
     void clear()
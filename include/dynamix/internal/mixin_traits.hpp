@@ -19,6 +19,8 @@
 
 namespace dynamix
 {
+class object;
+
 namespace internal
 {
 
@@ -122,18 +124,109 @@ typename std::enable_if<!std::is_move_assignable<Mixin>::value,
     return nullptr;
 }
 
+// double-buffered mixins (see the `double_buffered` feature) have two instances in their memory
+// the second one is after the first one with room for the owning object in front of it
+template <typename Mixin>
+struct double_buffer_layout
+{
+    static constexpr size_t alignment = std::alignment_of<Mixin>::value > std::alignment_of<object*>::value ?
+        std::alignment_of<Mixin>::value : std::alignment_of<object*>::value;
+
+    // offset of the second instance from the first one
+    static constexpr size_t offset = (sizeof(Mixin) + sizeof(object*) + alignment - 1) / alignment * alignment;
+
+    static void* second(void* first) { return reinterpret_cast<char*>(first) + offset; }
+    static const void* second(const void* first) { return reinterpret_cast<const char*>(first) + offset; }
+};
+
+template <typename Mixin>
+void call_double_buffered_constructor(void* memory)
+{
+    new (memory) Mixin;
+    new (double_buffer_layout<Mixin>::second(memory)) Mixin;
+}
+
+template <typename Mixin>
+void call_double_buffered_destructor(void* memory)
+{
+    reinterpret_cast<Mixin*>(memory)->~Mixin();
+    reinterpret_cast<Mixin*>(double_buffer_layout<Mixin>::second(memory))->~Mixin();
+}
+
+// apply a proc of a single instance to both instances
+// the proc is obtained from its getter, so the wrappers are only instantiated for procs which exist
+template <typename Mixin, mixin_type_info::mixin_copy_proc (*Get)()>
+void call_double_buffered_copy_proc(void* memory, const void* source)
+{
+    auto proc = Get();
+    proc(memory, source);
+    proc(double_buffer_layout<Mixin>::second(memory), double_buffer_layout<Mixin>::second(source));
+}
+
+template <typename Mixin, mixin_type_info::mixin_move_proc (*Get)()>
+void call_double_buffered_move_proc(void* memory, void* source)
+{
+    auto proc = Get();
+    proc(memory, source);
+    proc(double_buffer_layout<Mixin>::second(memory), double_buffer_layout<Mixin>::second(source));
+}
+
+template <typename Mixin>
+void set_double_buffered_traits_to_info(mixin_type_info& info)
+{
+    typedef double_buffer_layout<Mixin> layout;
+    info.double_buffer_offset = layout::offset;
+    info.size = layout::offset + sizeof(Mixin);
+    info.alignment = layout::alignment;
+    info.constructor = &call_double_buffered_constructor<Mixin>;
+    info.destructor = &call_double_buffered_destructor<Mixin>;
+    info.trivially_destructible = std::is_trivially_destructible<Mixin>::value;
+    if (get_mixin_copy_constructor<Mixin>())
+        info.copy_constructor = &call_double_buffered_copy_proc<Mixin, get_mixin_copy_constructor<Mixin>>;
+    if (get_mixin_copy_assignment<Mixin>())
+        info.copy_assignment = &call_double_buffered_copy_proc<Mixin, get_mixin_copy_assignment<Mixin>>;
+    if (get_mixin_move_constructor<Mixin>())
+        info.move_constructor = &call_double_buffered_move_proc<Mixin, get_mixin_move_constructor<Mixin>>;
+    if (get_mixin_move_assignment<Mixin>())
+        info.move_assignment = &call_double_buffered_move_proc<Mixin, get_mixin_move_assignment<Mixin>>;
+}
+
+// seqlocked mixins (see the `seqlocked` feature) have a sequence counter after them
+// (after both instances of double-buffered mixins)
+template <typename Mixin>
+void set_seqlocked_traits_to_info(mixin_type_info& info)
+{
+    typedef std::atomic<uint32_t> counter;
+    const size_t counter_alignment = std::alignment_of<counter>::value;
+    const size_t mixin_size = info.double_buffered ?
+        double_buffer_layout<Mixin>::offset + sizeof(Mixin) : sizeof(Mixin);
+
+    info.seqlock_offset = (mixin_size + counter_alignment - 1) / counter_alignment * counter_alignment;
+    info.size = info.seqlock_offset + sizeof(counter);
+    if (info.alignment < counter_alignment) info.alignment = counter_alignment;
+}
+
 // set a meaningful default value to any traits which are not already set
 template <typename Mixin>
 void set_missing_traits_to_info(mixin_type_info& info)
 {
+    if (info.double_buffered) set_double_buffered_traits_to_info<Mixin>(info);
+    if (info.seqlocked) set_seqlocked_traits_to_info<Mixin>(info);
+
     if (!info.size) info.size = sizeof(Mixin);
     if (!info.alignment) info.alignment = std::alignment_of<Mixin>::value;
     if (!info.constructor) info.constructor = &call_mixin_constructor<Mixin>;
-    if (!info.destructor) info.destructor = &call_mixin_destructor<Mixin>;
+    if (!info.destructor)
+    {
+        info.destructor = &call_mixin_destructor<Mixin>;
+        info.trivially_destructible = std::is_trivially_destructible<Mixin>::value;
+    }
     if (!info.copy_constructor) info.copy_constructor = get_mixin_copy_constructor<Mixin>();
     if (!info.copy_assignment) info.copy_assignment = get_mixin_copy_assignment<Mixin>();
     if (!info.move_constructor) info.move_constructor = get_mixin_move_constructor<Mixin>();
     if (!info.move_assignment) info.move_assignment = get_mixin_move_assignment<Mixin>();
+    info.trivially_copy_assignable = std::is_trivially_copy_assignable<Mixin>::value;
+    info.trivially_move_assignable = std::is_trivially_move_assignable<Mixin>::value;
 
     if (!info.name)
     {
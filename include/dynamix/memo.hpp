@@ -0,0 +1,221 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Memoized results of pure const messages.
+ *
+ * Mixins mark their implementations of const messages with no arguments as pure
+ * functions of their state with the `pure` perk (`pure(get_bounds_msg)`).
+ * Then `memo(obj, get_bounds_msg)` (or `memo<combinators::sum>(obj, get_mass_msg)` for
+ * multicasts) calls the message once and returns the stored result on subsequent calls.
+ *
+ * The results of an object are invalidated by:
+ * * Any non-const message call to the object from modules compiled with DYNAMIX_MEMOS
+ * * Any mutation of the object
+ * * `invalidate_memos` and `invalidate_memo`
+ * * `swap_buffers` (see double_buffer.hpp)
+ *
+ * If an implementer of the message in the object's type is not marked as pure,
+ * the message is called every time.
+ *
+ * The results are stored in a table in the domain of the object which is created on the
+ * first `memo` call for it. Objects don't pay for memos and only the ones in domains which
+ * have memos are looked up in the tables when they're mutated or destroyed.
+ * The memos of an object must only be used from the thread which mutates it.
+ *
+ * `memo` is only available with DYNAMIX_MEMOS, which makes non-const message calls
+ * invalidate the results. It calls the messages through their message structs, which
+ * the legacy message macros don't provide, so it's not available with
+ * DYNAMIX_USE_LEGACY_MESSAGE_MACROS either.
+ */
+
+#include "config.hpp"
+#include "feature.hpp"
+#include "object.hpp"
+#include "double_buffer.hpp"
+#include "internal/message_callers.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dynamix
+{
+
+namespace internal
+{
+
+// per-object table of memoized message results
+// the tables are kept in the domains of the objects (see object_domain)
+struct DYNAMIX_API memo_table
+{
+    struct entry
+    {
+        feature_id message;
+
+        // identifies the combinator of multicast results (null for unicasts)
+        const void* key;
+
+        // the entry is valid if it's the same as the generation of the table
+        size_t generation;
+
+        // the results of double-buffered mixins change when the buffers are swapped
+        // (see double_buffer.hpp)
+        uint32_t buffer_epoch;
+
+        std::shared_ptr<void> value;
+    };
+
+    // incremented on invalidation, so that no entries are freed
+    // and their values are reused by the next calls
+    size_t generation = 0;
+
+    // few per object, so a linear search is fine
+    std::vector<entry> entries;
+
+    const entry* find_valid(feature_id message, const void* key) const noexcept
+    {
+        for (auto& e : entries)
+        {
+            if (e.message == message && e.key == key)
+            {
+                return e.generation == generation
+                    && e.buffer_epoch == double_buffer_epoch.load(std::memory_order_relaxed) ? &e : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    const T& store(feature_id message, const void* key, T&& value)
+    {
+        typedef typename std::decay<T>::type value_type;
+        for (auto& e : entries)
+        {
+            if (e.message == message && e.key == key)
+            {
+                e.generation = generation;
+                e.buffer_epoch = double_buffer_epoch.load(std::memory_order_relaxed);
+                auto& stored = *static_cast<value_type*>(e.value.get());
+                stored = std::forward<T>(value);
+                return stored;
+            }
+        }
+
+        entries.push_back({message, key, generation, double_buffer_epoch.load(std::memory_order_relaxed),
+            std::make_shared<value_type>(std::forward<T>(value))});
+        return *static_cast<const value_type*>(entries.back().value.get());
+    }
+};
+
+// identifies a combinator type in the memo table
+template <typename Combinator>
+struct memo_key
+{
+    static const char id;
+};
+template <typename Combinator>
+const char memo_key<Combinator>::id = 0;
+
+// the memo table of the object or null if it has none
+DYNAMIX_API memo_table* find_memo_table(const object& obj) noexcept;
+
+// creates the memo table of the object if needed
+DYNAMIX_API memo_table& get_memo_table(const object& obj);
+
+// erases the memo table of the object
+DYNAMIX_API void drop_memos(const object& obj) noexcept;
+
+// gives the memo table of an object to another one (dropping the table of the target)
+DYNAMIX_API void move_memos(const object& to, const object& from) noexcept;
+
+// checks whether all mixins of the object's type which would be called by the message are pure
+DYNAMIX_API bool is_pure_message(const object& obj, feature_id id) noexcept;
+
+DYNAMIX_API void invalidate_memo(const object& obj, feature_id id) noexcept;
+
+} // namespace internal
+
+#if DYNAMIX_MEMOS && !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+/// Calls a pure const unicast message with no arguments and stores its result for the object.
+/// Subsequent calls return the stored result until it's invalidated.
+template <typename Message>
+typename std::decay<typename Message::return_type>::type memo(const object& obj, Message*)
+{
+    typedef typename Message::return_type return_type;
+    static_assert(!std::is_void<return_type>::value, "only messages which return values can be memoized");
+    static_assert(std::is_same<decltype(&Message::make_call), return_type (*)(const object&)>::value,
+        "only const unicast messages with no arguments can be memoized");
+
+    const feature_id id = _dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr)).id;
+
+    if (auto table = internal::find_memo_table(obj))
+    {
+        if (auto e = table->find_valid(id, nullptr))
+        {
+            return *static_cast<const typename std::decay<return_type>::type*>(e->value.get());
+        }
+    }
+
+    if (!internal::is_pure_message(obj, id))
+    {
+        return Message::make_call(obj);
+    }
+
+    return internal::get_memo_table(obj).store(id, nullptr, Message::make_call(obj));
+}
+
+/// Calls a pure const multicast message with no arguments with a combinator
+/// and stores the combined result for the object.
+/// Subsequent calls with the same combinator return the stored result until it's invalidated.
+template <template <typename> class Combinator, typename Message>
+typename std::decay<typename Combinator<typename Message::return_type>::result_type>::type
+    memo(const object& obj, Message*)
+{
+    typedef Combinator<typename Message::return_type> combinator_type;
+    typedef typename std::decay<typename combinator_type::result_type>::type value_type;
+    static_assert(std::is_same<decltype(&Message::template make_combinator_call<combinator_type>),
+        void (*)(const object&, combinator_type&)>::value,
+        "only const multicast messages with no arguments can be memoized with a combinator");
+
+    const feature_id id = _dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr)).id;
+    const void* key = &internal::memo_key<combinator_type>::id;
+
+    if (auto table = internal::find_memo_table(obj))
+    {
+        if (auto e = table->find_valid(id, key))
+        {
+            return *static_cast<const value_type*>(e->value.get());
+        }
+    }
+
+    combinator_type combinator;
+    Message::make_combinator_call(obj, combinator);
+
+    if (!internal::is_pure_message(obj, id))
+    {
+        return combinator.result();
+    }
+
+    return internal::get_memo_table(obj).store(id, key, combinator.result());
+}
+#endif
+
+/// Invalidates the stored results of a message for the object.
+template <typename Message>
+void invalidate_memo(const object& obj, Message*) noexcept
+{
+    internal::invalidate_memo(obj, _dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr)).id);
+}
+
+// `invalidate_memos(const object&)` which invalidates all stored results of an object
+// is declared in internal/message_callers.hpp, as the message calls use it
+
+} // namespace dynamix
@@ -0,0 +1,112 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Arena memory (optionally backed by huge pages) and a domain allocator which uses it.
+ */
+
+#include "config.hpp"
+#include "allocators.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+#include <mutex>
+#endif
+
+namespace dynamix
+{
+
+/// Allocates memory from big blocks, so that it's contiguous and fewer pages (and TLB entries)
+/// are used. Individual allocations are never freed. All memory is released at once.
+///
+/// With huge pages the blocks are rounded up to the huge page size and are advised
+/// to be backed by transparent huge pages. This is only supported on Linux and
+/// ignored elsewhere.
+///
+/// The arena is not thread safe.
+class DYNAMIX_API memory_arena
+{
+public:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    explicit memory_arena(size_t block_size = HUGE_PAGE_SIZE, bool huge_pages = false);
+    ~memory_arena();
+
+    memory_arena(const memory_arena&) = delete;
+    memory_arena& operator=(const memory_arena&) = delete;
+
+    /// Returns memory with the given alignment (which must be a power of two).
+    /// Allocations bigger than the block size get a block of their own.
+    void* allocate(size_t size, size_t alignment = sizeof(void*));
+
+    /// Releases all memory of the arena.
+    void release();
+
+    bool uses_huge_pages() const { return _huge_pages; }
+
+    /// Number of allocated blocks
+    size_t num_blocks() const { return _blocks.size(); }
+
+    /// Total size of the allocated blocks
+    size_t reserved_size() const;
+
+private:
+    struct block
+    {
+        char* memory;
+        size_t size;
+    };
+
+    char* alloc_block(size_t size);
+    void free_block(const block& b);
+
+    std::vector<block> _blocks;
+
+    // free space in the last block
+    char* _pos = nullptr;
+    char* _end = nullptr;
+
+    const size_t _block_size;
+    const bool _huge_pages;
+};
+
+/// A domain allocator which allocates the mixins and mixin data from a memory arena.
+///
+/// Deallocation does nothing. The memory is released when the allocator is destroyed
+/// or reset. It's suitable for objects which live until a world is unloaded and are
+/// then removed with `teardown` without releasing their memory.
+class DYNAMIX_API arena_allocator : public domain_allocator
+{
+public:
+    explicit arena_allocator(size_t block_size = memory_arena::HUGE_PAGE_SIZE, bool huge_pages = false);
+
+    virtual char* alloc_mixin_data(size_t count, const object* obj) override;
+    virtual void dealloc_mixin_data(char* ptr, size_t count, const object* obj) override;
+    virtual std::pair<char*, size_t> alloc_mixin(const mixin_type_info& info, const object* obj) override;
+    virtual void dealloc_mixin(char* ptr, size_t mixin_offset, const mixin_type_info& info, const object* obj) override;
+    virtual bool can_reuse_mixin_buffer(const mixin_type_info& freed, const mixin_type_info& needed) const override;
+
+    /// Releases all memory. No objects may have mixins or mixin data from it.
+    void reset();
+
+    const memory_arena& arena() const { return _arena; }
+
+private:
+    memory_arena _arena;
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::mutex _mutex;
+#endif
+};
+
+} // namespace dynamix
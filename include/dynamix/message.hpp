@@ -71,6 +71,9 @@ struct DYNAMIX_API message_for_mixin
     // message perks
     int bid;
     int priority;
+
+    // the mixin's method is a pure function of its state (see memo.hpp)
+    bool pure;
 };
 
 // check if a class has a method set_num_results
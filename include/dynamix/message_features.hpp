@@ -21,6 +21,7 @@ struct message_perks
 {
     int bid = 0;
     int priority = 0;
+    bool pure = false;
 };
 
 // used for custom callers
@@ -49,7 +50,19 @@ internal::message_perks<Message> bid(int b, Message*)
     return mp;
 }
 
+// marks the mixin's implementation of a const message as a pure function of the mixin's state
+// so its results can be memoized per object (see memo.hpp)
+template <typename Message>
+internal::message_perks<Message> pure(Message*)
+{
+    internal::message_perks<Message> mp;
+    mp.pure = true;
+    return mp;
+}
+
 // bind a `void* self` function to the message
+// for multicast messages the arguments which are declared by value (except scalars)
+// are taken by const reference (see internal::multicast_arg)
 template <typename Message>
 internal::message_perks_and_caller<Message> bind(Message*, typename Message::caller_func caller)
 {
@@ -107,4 +120,11 @@ Perks<Message> bid(int b, Perks<Message> perks)
     return perks;
 }
 
+template <typename Message, template <typename> class Perks>
+Perks<Message> pure(Perks<Message> perks)
+{
+    perks.pure = true;
+    return perks;
+}
+
 } // namespace dynamix
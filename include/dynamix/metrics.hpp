@@ -41,6 +41,12 @@ struct metric
         return *this;
     }
 
+    metric& operator-=(size_t n)
+    {
+        value.fetch_sub(n, std::memory_order_relaxed);
+        return *this;
+    }
+
     mutable std::atomic<size_t> value;
 };
 }
@@ -17,8 +17,10 @@
 #include "config.hpp"
 #include "mixin_id.hpp"
 #include "message.hpp"
+#include "fact.hpp"
 #include "metrics.hpp"
 
+#include <atomic>
 #include <utility>
 #include <vector>
 #include <cstdint>
@@ -31,6 +33,21 @@ class mixin_allocator;
 // TODO: inline when on C++17
 static constexpr mixin_id INVALID_MIXIN_ID = ~mixin_id(0);
 
+class mixin_type_info;
+
+namespace internal
+{
+// a sibling mixin required by a mixin
+struct sibling_link
+{
+    const mixin_type_info* sibling;
+
+    // domain-wide unique id of the link
+    // used as an index in the sibling tables of object type infos
+    uint32_t id;
+};
+}
+
 /**
 * Mixin type info. Contains a the mixin type information, features and traits.
 */
@@ -71,6 +88,28 @@ public:
     /// Procedure which calls the destructor of a mixin. Never null.
     mixin_destructor_proc destructor = 0;
 
+    /// Whether the destructor of the mixin is trivial. Teardown doesn't destroy such mixins.
+    bool trivially_destructible = false;
+
+    /// Whether teardown must destroy the mixin even when it skips destructors
+    /// (provided by the `destroy_on_teardown` feature).
+    bool destroy_on_teardown = false;
+
+    /// Whether objects keep two instances of the mixin: one which const access reads
+    /// and one which non-const access writes (provided by the `double_buffered` feature).
+    bool double_buffered = false;
+
+    /// Offset of the second instance of a double-buffered mixin from the first one.
+    /// Zero for other mixins.
+    size_t double_buffer_offset = 0;
+
+    /// Whether the mixin has a sequence counter for consistent reads from other threads
+    /// (provided by the `seqlocked` feature, see seqlock.hpp).
+    bool seqlocked = false;
+
+    /// Offset of the sequence counter of a seqlocked mixin from the mixin. Zero for other mixins.
+    size_t seqlock_offset = 0;
+
     /// Procedutre which calls the copy-constructor of a mixin.
     /// Might be left null for mixins which aren't copy-constructible
     mixin_copy_proc copy_constructor = 0;
@@ -87,12 +126,32 @@ public:
     /// Might be left null for mixin which aren't move-constructible
     mixin_move_proc move_assignment = 0;
 
+    /// Whether the copy and move assignments of the mixin are trivial.
+    /// Copying and moving the matching mixins of objects copies the bytes of such mixins.
+    bool trivially_copy_assignable = false;
+    bool trivially_move_assignable = false;
+
     /// All the message infos for the messages this mixin supports
     std::vector<internal::message_for_mixin> message_infos;
 
+    /// All the facts this mixin provides with their values
+    std::vector<internal::fact_for_mixin> fact_infos;
+
     /// User data associated with this type info
     uintptr_t user_data = 0;
 
+    /// Siblings required by this mixin (provided by the `requires_sibling` feature).
+    /// Mutations will add them to objects which have this mixin.
+    std::vector<internal::sibling_link> required_siblings;
+
+    /// Set for mixins which are registered on first use (see `DYNAMIX_LAZY_MIXIN_REGISTRATION`)
+    /// until they are registered. It parses the mixin features and registers the mixin.
+    void (*lazy_registrator)() = nullptr;
+
+    /// Whether the mixin is registered in the domain.
+    /// Unlike the id, it can be checked while the mixin is being registered in another thread.
+    std::atomic<bool> registered = {false};
+
 #if DYNAMIX_USE_TYPEID && defined(__GNUC__)
     // boolean which shows whether the name in the mixin type info was obtained
     // by cxa demangle and should be freed
@@ -0,0 +1,85 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Batched notifications for type changes of objects.
+ *
+ * When enabled, every type change of an object (mutations, type templates,
+ * copies, moves, clears and destruction) including the ones caused by mutation
+ * rules and required siblings is pushed to a buffer of the thread which performs it.
+ * Nothing is locked on the mutation path.
+ *
+ * The events are delivered in batches to all subscribers by `dispatch`. It is
+ * meant to be called once per frame (or any other period) so external indices
+ * of objects can be updated incrementally.
+ */
+
+#include "config.hpp"
+#include "mixin_collection.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace dynamix
+{
+
+class object;
+class object_type_info;
+
+/// A type change of an object.
+///
+/// The object and the types are only identified by their addresses. The object
+/// may have been destroyed and the types may have been garbage collected
+/// before the event is dispatched.
+struct mutation_event
+{
+    const object* obj;
+    const object_type_info* old_type; ///< null type info if the object was empty
+    const object_type_info* new_type; ///< null type info if the object became empty
+    internal::available_mixins_bitset added; ///< ids of the added mixins
+    internal::available_mixins_bitset removed; ///< ids of the removed mixins
+};
+
+namespace mutation_events
+{
+
+/// Starts pushing events to the buffers.
+DYNAMIX_API void enable();
+
+/// Stops pushing events. Events which are already in the buffers are still dispatched.
+DYNAMIX_API void disable();
+
+/// Returns whether events are pushed.
+DYNAMIX_API bool is_enabled() noexcept;
+
+/// The events are in the order in which they happened in each thread.
+/// Events from different threads are not ordered relative to each other.
+using subscriber = std::function<void(const std::vector<mutation_event>&)>;
+using subscriber_id = size_t;
+
+/// Adds a subscriber which will be called with every dispatched batch.
+/// Returns an id by which it can be removed.
+DYNAMIX_API subscriber_id add_subscriber(subscriber s);
+
+/// Removes a subscriber. Must not be called from a subscriber.
+DYNAMIX_API void remove_subscriber(subscriber_id id);
+
+/// Collects the events pushed by all threads since the last dispatch and calls all
+/// subscribers with them. Returns the number of events.
+///
+/// Can be called while other threads are mutating objects. An event of a mutation
+/// which is in progress will be in this or the next batch.
+/// Subscribers are called in the dispatching thread and must not dispatch or add subscribers.
+DYNAMIX_API size_t dispatch();
+
+} // namespace mutation_events
+
+} // namespace dynamix
@@ -16,6 +16,10 @@
 #include "config.hpp"
 #include "exception.hpp"
 #include "object.hpp"
+#include "object_type_info.hpp"
+#include "double_buffer.hpp"
+#include "seqlock.hpp"
+#include "internal/mixin_data_in_object.hpp"
 
 namespace dynamix
 {
@@ -27,8 +31,16 @@ auto call_next_bidder(Mixin* mixin, Message* message, Args&&... args)
     const mixin_type_info& mixin_info = _dynamix_get_mixin_type_info(mixin);
     auto& msg = static_cast<const internal::message_t&>(_dynamix_get_mixin_feature_fast(message));
     const object* obj = object_of(mixin);
-    const object_type_info::call_table_entry& entry = obj->_type_info->_call_table[msg.id];
-    const uint32_t mixin_index = obj->_type_info->_mixin_indices[mixin_info.id];
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // called from a message, so we're in a read scope
+    const internal::mixin_data_in_object* mixin_datas = obj->_published_mixin_data.load(std::memory_order_acquire);
+    const object_type_info* type_info = object_type_info::of_mixin_data(mixin_datas);
+#else
+    const internal::mixin_data_in_object* mixin_datas = obj->_mixin_data;
+    const object_type_info* type_info = obj->_type_info;
+#endif
+    const object_type_info::call_table_entry& entry = type_info->_call_table[msg.id];
+    const uint32_t mixin_index = type_info->_mixin_indices[mixin_info.id];
 
     DYNAMIX_MSG_THROW_UNLESS(entry.top_bid_message, bad_message_call);
 
@@ -44,8 +56,9 @@ auto call_next_bidder(Mixin* mixin, Message* message, Args&&... args)
 
         // for unicasts the next message for mixin (pointed by ptr) must be the one
         // we want to execute (with the next bid)
-        auto data = reinterpret_cast<char*>(const_cast<void*>(obj->_mixin_data[ptr->mixin_index].mixin()));
+        auto data = I_DYNAMIX_CALL_INSTANCE(Mixin, mixin_datas[ptr->mixin_index].mixin(), ptr->double_buffer_offset);
         auto func = reinterpret_cast<typename Message::caller_func>(ptr->caller);
+        I_DYNAMIX_CALL_SEQLOCK(Mixin, type_info, mixin_datas, ptr->mixin_index);
         return func(data, std::forward<Args>(args)...);
     }
     else
@@ -77,8 +90,9 @@ auto call_next_bidder(Mixin* mixin, Message* message, Args&&... args)
         // execute the bid chain
         for (;;)
         {
-            auto data = reinterpret_cast<char*>(const_cast<void*>(obj->_mixin_data[ptr->mixin_index].mixin()));
+            auto data = I_DYNAMIX_CALL_INSTANCE(Mixin, mixin_datas[ptr->mixin_index].mixin(), ptr->double_buffer_offset);
             auto func = reinterpret_cast<typename Message::caller_func>(ptr->caller);
+            I_DYNAMIX_CALL_SEQLOCK(Mixin, type_info, mixin_datas, ptr->mixin_index);
             ++ptr;
             // check next message data
             if (!(*ptr) || ptr->data->bid != bid)
@@ -102,8 +116,13 @@ bool has_next_bidder(Mixin* mixin, Message* message)
     const mixin_type_info& mixin_info = _dynamix_get_mixin_type_info(mixin);
     auto& msg = static_cast<const internal::message_t&>(_dynamix_get_mixin_feature_fast(message));
     const object* obj = object_of(mixin);
-    const object_type_info::call_table_entry& entry = obj->_type_info->_call_table[msg.id];
-    const uint32_t mixin_index = obj->_type_info->_mixin_indices[mixin_info.id];
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    const object_type_info* type_info = object_type_info::of_mixin_data(obj->_published_mixin_data.load(std::memory_order_acquire));
+#else
+    const object_type_info* type_info = obj->_type_info;
+#endif
+    const object_type_info::call_table_entry& entry = type_info->_call_table[msg.id];
+    const uint32_t mixin_index = type_info->_mixin_indices[mixin_info.id];
 
     if (!entry.top_bid_message) return false;
 
@@ -11,6 +11,10 @@
 #include "internal/assert.hpp"
 #include "mixin_type_info.hpp"
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+#   include <atomic>
+#endif
+
 namespace dynamix
 {
 
@@ -19,11 +23,13 @@ namespace internal
 class mixin_data_in_object;
 struct message_t;
 struct message_feature_tag;
+struct fact_feature_tag;
 } // namespace internal
 
 class object_type_info;
 class object_type_template;
 class object_allocator;
+class object_domain;
 class type_class;
 
 /// The main object class.
@@ -35,7 +41,10 @@ public:
 
     /// Constructs an object with an object allocator
     explicit object(object_allocator* allocator);
+    /// Constructs an empty object in a specific object domain, with an optional object allocator
+    explicit object(object_domain& domain, object_allocator* allocator = nullptr);
     /// Constructs an object from a specific type template.
+    /// The object is in the domain of the template.
     explicit object(const object_type_template& type_template, object_allocator* allocator = nullptr);
 
     ~object();
@@ -74,6 +83,7 @@ public:
     /// Will destroy mixins that don't exist in source.
     /// It will not, however, match asssignment operators for different mixin types
     /// which have such defined between them.
+    /// The object stays in its domain.
     void copy_from(const object& o);
 
     /// Assignment of mixins that exist in both objects.
@@ -197,6 +207,9 @@ public:
     /// Returns the allcator associated with this object (may be `nullptr`)
     object_allocator* allocator() const { return _allocator; }
 
+    /// Returns the object domain of this object
+    object_domain& domain() const { return *_domain; }
+
     /// Reorganizes the mixins for the new type.
     /// Destroys all mixins removed and construct all new ones
     void change_type(const object_type_info* new_type);
@@ -238,6 +251,20 @@ _dynamix_internal:
     // thus each mixin can get its own object
     internal::mixin_data_in_object* _mixin_data;
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // the mixin data which readers in other threads see
+    // it has the object type in front of it (see object_type_info::of_mixin_data)
+    // the two above are only used by the mutating thread
+    std::atomic<internal::mixin_data_in_object*> _published_mixin_data;
+#endif
+
+    // used by teardown (see teardown.hpp)
+    // neither of these updates the mixin and type metrics
+    // destroys the mixins which the teardown needs to destroy
+    void teardown_destroy_mixins(bool call_destructors) noexcept;
+    // optionally deallocates the mixins and the mixin data and makes the object empty
+    void teardown_release(bool release_memory) noexcept;
+
 private:
     void* internal_get_mixin(mixin_id id);
     const void* internal_get_mixin(mixin_id id) const;
@@ -262,19 +289,29 @@ private:
     // can only be performed on empty objects
     void usurp(object&& o) noexcept;
 
-    // allocates memory and
+    // allocates memory (unless a buffer from the mixin's allocator is provided) and
     // constructs mixin with optional source to copy from
     // will return false if source is provided but no copy constructor exists
-    bool make_mixin(const mixin_type_info& mixin_info, const void* source);
+    bool make_mixin(const mixin_type_info& mixin_info, const void* source, char* buffer = nullptr, size_t mixin_offset = 0);
 
     // destroys mixin and deallocates memory
     void delete_mixin(const mixin_type_info& mixin_info);
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // destroys the mixin and deallocates its memory when no readers can see it
+    // must be called after the new mixin data has been published
+    void retire_mixin(const mixin_type_info& mixin_info, internal::mixin_data_in_object& data);
+#endif
+
     bool internal_implements(feature_id id, const internal::message_feature_tag&) const;
+    bool internal_implements(feature_id id, const internal::fact_feature_tag&) const;
 
     // optional allocator for this object
     object_allocator* _allocator = nullptr;
 
+    // the domain which provides type infos, mutation rules, and the default allocator
+    object_domain* _domain;
+
     // virtual mixin for default message implementation
     // used only so as to not have a null pointer cast to the appropriate type for default implementations
     // which could be treated as an error in some debuggers
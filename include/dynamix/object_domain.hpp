@@ -0,0 +1,206 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Independent sets of object types, mutation rules and allocators.
+ */
+
+#include "config.hpp"
+#include "mutation_rule_id.hpp"
+#include "mixin_collection.hpp"
+#include "feature.hpp"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+#include <mutex>
+#endif
+
+namespace dynamix
+{
+
+class object;
+class mutation_rule;
+class object_type_mutation;
+class object_type_info;
+class mixin_type_info;
+class mixin_allocator;
+class domain_allocator;
+class memory_arena;
+
+namespace internal
+{
+class domain;
+struct shared_call_table;
+struct memo_table;
+}
+
+/// An object domain has its own cache of object types, mutation rules,
+/// allocator and locks. Objects are bound to a domain when they are constructed
+/// (by default to the global one) and are only mutated with the rules of
+/// their domain. Mixins, messages and type classes are registered once and are
+/// shared by all domains.
+///
+/// Separate domains don't contend on locks when objects in them are mutated
+/// concurrently, and their mutation rules don't affect each other.
+///
+/// A domain must outlive all objects, type templates and mutators bound to it.
+/// Moved and copy-constructed objects take the domain of the source. Copy
+/// assignment keeps the domain of the target.
+class DYNAMIX_API object_domain
+{
+public:
+    object_domain();
+    ~object_domain();
+
+    object_domain(const object_domain&) = delete;
+    object_domain& operator=(const object_domain&) = delete;
+
+    /// The domain of objects which are constructed without one.
+    /// The global mutation rule and allocator functions work with it.
+    static object_domain& global();
+
+    /// Adds a mutation rule to the domain via a shared pointer.
+    /// Returns the mutation rule id by which it can be removed.
+    ///
+    /// Does *not* perform a topological sort of the rules.
+    /// It is the user's responsibility to add the mutation rules in the appropriate order.
+    mutation_rule_id add_mutation_rule(std::shared_ptr<mutation_rule> rule);
+
+    /// Removes a mutation rule from the domain.
+    /// Returns a shared pointer to the mutation rule which was removed.
+    std::shared_ptr<mutation_rule> remove_mutation_rule(mutation_rule_id id);
+
+    /// Sets the allocator for the mixin data of objects in the domain and for
+    /// the mixins which don't have an allocator of their own.
+    /// Must be called before any objects in the domain are mutated.
+    void set_allocator(domain_allocator* allocator);
+
+    /// The allocator for the mixin data of the objects in the domain.
+    domain_allocator* allocator() const;
+
+    /// The allocator for a mixin in an object of the domain (unless the object has its own).
+    mixin_allocator* mixin_allocator_for(const mixin_type_info& info) const;
+
+    /// Erases all object types which have no objects.
+    void garbage_collect_type_infos();
+
+    /// Number of object types created in the domain.
+    size_t num_type_infos() const;
+
+    /// Makes the domain allocate its object types from an arena. The types
+    /// and their call tables are then contiguous and the call tables are cache-line aligned.
+    /// (Types which differ only by mixins which don't implement messages share a call table.)
+    /// Optionally the arena is backed by huge pages (see `memory_arena`).
+    /// The memory of garbage collected types is only released when the domain is destroyed.
+    /// Must be called before any types are created in the domain.
+    void use_type_info_arena(bool huge_pages = false);
+
+    /// The object types in the domain which have a mixin.
+    /// They're listed from an index, without going through all types.
+    std::vector<const object_type_info*> types_with_mixin(mixin_id id) const;
+    std::vector<const object_type_info*> types_with_mixin(const mixin_type_info& info) const;
+    template <typename Mixin>
+    std::vector<const object_type_info*> types_with() const
+    {
+        return types_with_mixin(_dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr)));
+    }
+
+    /// The object types in the domain in which a message is implemented by a mixin.
+    /// Types which only have the default implementation of the message are not listed.
+    std::vector<const object_type_info*> types_implementing_message(feature_id id) const;
+    template <typename Message>
+    std::vector<const object_type_info*> types_implementing(const Message*) const
+    {
+        return types_implementing_message(_dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr)).id);
+    }
+
+_dynamix_internal:
+    void apply_mutation_rules(object_type_mutation& mutation, const mixin_collection& source_mixins);
+
+    // creates a new type info if needed
+    const object_type_info* get_object_type_info(mixin_collection mixins);
+
+    // memoized message results of the objects in the domain (see memo.hpp)
+    // they're kept here, so that objects don't pay for them, and objects are only
+    // looked up in the map when they're mutated or destroyed if the domain has any
+    std::atomic<bool> _has_memos = {false};
+    std::unordered_map<const object*, std::unique_ptr<internal::memo_table>> _memos;
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::mutex _memos_mutex;
+#endif
+
+private:
+    friend class internal::domain;
+
+    // the global domain is owned by the internal domain and doesn't register itself in it
+    struct global_tag {};
+    explicit object_domain(global_tag);
+
+    // erases all type infos which have this mixin
+    void drop_type_infos(mixin_id id);
+
+    // allocates a type info with new or from the arena
+    object_type_info* new_object_type_info();
+
+    // sets the call table of a new type info
+    // it's shared with the types which have the same mixins implementing messages
+    // throws unicast_clash if a new table can't be filled
+    void set_call_table(object_type_info& type);
+    // called when a type info is destroyed
+    void release_call_table(object_type_info& type);
+
+    // add and remove types from the indices below
+    void index_type_info(const object_type_info* type);
+    // the types must be sorted by address
+    void unindex_type_infos(const std::vector<const object_type_info*>& types);
+    void erase_type_infos(const std::vector<const object_type_info*>& types);
+
+    // null if the type infos are allocated with new
+    // declared before them, so that it's destroyed after them
+    std::unique_ptr<memory_arena> _type_info_arena;
+
+    // destroys the type infos and frees them unless they're from an arena
+    struct type_info_deleter
+    {
+        void operator()(object_type_info* type) const;
+    };
+    typedef std::unique_ptr<object_type_info, type_info_deleter> object_type_info_ptr;
+
+    typedef std::unordered_map<internal::available_mixins_bitset, object_type_info_ptr> object_type_info_map;
+    object_type_info_map _object_type_infos;
+
+    // call tables which can be shared by new types
+    // indexed by the mixins which implement messages
+    std::unordered_map<internal::available_mixins_bitset, internal::shared_call_table*> _call_tables;
+
+    // the type infos which have a mixin or implement a message by a mixin
+    // indexed by mixin and message id respectively (sized on first use)
+    typedef std::vector<std::vector<const object_type_info*>> type_info_index;
+    type_info_index _type_infos_by_mixin;
+    type_info_index _type_infos_by_message;
+
+    std::vector<std::shared_ptr<mutation_rule>> _mutation_rules;
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    mutable std::mutex _object_type_infos_mutex;
+    std::mutex _mutation_rules_mutex;
+#endif
+
+    // null if it uses the global allocator
+    domain_allocator* _allocator = nullptr;
+
+    const bool _is_global;
+};
+
+} // namespace dynamix
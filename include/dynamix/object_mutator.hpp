@@ -23,6 +23,7 @@ namespace dynamix
 
 class object;
 class object_type_info;
+class object_domain;
 
 namespace internal
 {
@@ -31,7 +32,7 @@ class DYNAMIX_API object_mutator
 {
 public:
     object_mutator();
-    object_mutator(const mixin_collection* source_mixins);
+    object_mutator(const mixin_collection* source_mixins, object_domain* domain = nullptr);
 
     // non-copyable
     object_mutator(const object_mutator&) = delete;
@@ -79,6 +80,7 @@ protected:
     object_type_mutation _mutation;
     const mixin_collection* _source_mixins = nullptr; // mixins the object being mutated
     const object_type_info* _target_type_info = nullptr; // new type info of the object
+    object_domain* _domain = nullptr; // domain of the objects being mutated
 
     bool _is_created = false;
 };
@@ -16,9 +16,11 @@
 #include "config.hpp"
 #include "mixin_collection.hpp"
 #include "message.hpp"
+#include "fact.hpp"
 #include "internal/assert.hpp"
 #include "type_class_id.hpp"
 
+#include <atomic>
 #include <memory>
 #include <cstdint>
 
@@ -31,10 +33,13 @@ namespace dynamix
 class type_class;
 class object_mutator;
 class object;
+class object_domain;
+class memory_arena;
 
 namespace internal
 {
 class mixin_data_in_object;
+struct shared_call_table;
 } // namespace internal
 
 class DYNAMIX_API object_type_info : private mixin_collection
@@ -54,6 +59,22 @@ public:
     internal::mixin_data_in_object* alloc_mixin_data(const object* obj) const;
     void dealloc_mixin_data(internal::mixin_data_in_object* data, const object* obj) const;
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // in this mode the mixin data arrays have their type in front
+    // thus readers can get both with a single atomic load (see concurrent_mutations.hpp)
+    static const object_type_info* of_mixin_data(const internal::mixin_data_in_object* data)
+    {
+        return reinterpret_cast<const object_type_info* const*>(data)[-1];
+    }
+
+    // mixin data of empty objects (with the null type in front)
+    static internal::mixin_data_in_object* null_mixin_data();
+
+    // the mixin data is deallocated when no readers can see it
+    // must be called after the object has published its new mixin data
+    void retire_mixin_data(internal::mixin_data_in_object* data, const object* obj) const;
+#endif
+
     /// Checks if the type implements a feature.
     template <typename Feature>
     bool implements(const Feature*) const noexcept
@@ -144,6 +165,7 @@ _dynamix_internal:
     struct call_table_message
     {
         uint32_t mixin_index; // index of mixin within the _compact_mixins vector
+        uint32_t double_buffer_offset; // of the second instance of double-buffered mixins, 0 for the others
         internal::func_ptr caller;
         const internal::message_for_mixin* data;
 
@@ -151,12 +173,13 @@ _dynamix_internal:
         void reset()
         {
             mixin_index = ~0u;
+            double_buffer_offset = 0;
             caller = nullptr;
             data = nullptr;
         }
     };
 
-    call_table_message make_call_table_message(mixin_id id, const internal::message_for_mixin& data) const;
+    call_table_message make_call_table_message(const mixin_type_info& info, const internal::message_for_mixin& data) const;
 
     struct call_table_entry
     {
@@ -181,16 +204,46 @@ _dynamix_internal:
         call_table_message* end;
     };
 
-    // a single buffer for all dynamically allocated message pointers to minimize allocations
-    std::unique_ptr<call_table_message[]> _message_data_buffer;
-    call_table_entry _call_table[DYNAMIX_MAX_MESSAGES];
+    // the entries of the call table shared by the types in the domain which have the same
+    // mixins implementing messages (see internal::shared_call_table)
+    // all zeroes for the null type info
+    const call_table_entry* _call_table;
+    internal::shared_call_table* _shared_call_table = nullptr;
+
+    // values of the facts provided by the type's mixins, or null (see declare_fact.hpp)
+    // they point to the values in the mixin type infos
+    const void* _fact_table[DYNAMIX_MAX_FACTS];
+
+    // resolved messages of interfaces, built on first use (see interface.hpp)
+    // indexed by the interface id
+    mutable std::atomic<const call_table_message*> _interface_tables[DYNAMIX_MAX_INTERFACES];
+
+    // whether non-const message calls need to check for seqlocked mixins (see seqlock.hpp)
+    bool _has_seqlocked_mixins = false;
+
+    // if set, the type info and its message data buffer are allocated from this arena
+    // and their memory is not freed when the type info is destroyed
+    memory_arena* _arena = nullptr;
+
+    // indices in the object::_mixin_data of required siblings (see `requires_sibling`)
+    // indexed by the sibling link id
+    // zero (the null mixin index) for links of mixins which are not in the type
+    uint32_t _sibling_indices[DYNAMIX_MAX_SIBLING_LINKS];
 
     // number of living objects with this type info
     mutable metric num_objects = {size_t(0)};
 
+    // the object domain which created this type info (null for the null type info)
+    object_domain* _domain = nullptr;
+
     // this should be called after the mixins have been initialized
+    // and the type has an empty shared call table
     void fill_call_table();
 
+    // this should be called after the mixins have been initialized
+    // throws fact_clash if the top fact provider can't be determined
+    void fill_fact_table();
+
     bool internal_implements(feature_id id, const internal::message_feature_tag&) const
     {
         return implements_message(id);
@@ -212,9 +265,45 @@ _dynamix_internal:
 
     size_t message_num_implementers(feature_id id) const;
 
+    // facts have no default values, so they're always provided by a mixin
+    bool internal_implements(feature_id id, const internal::fact_feature_tag&) const
+    {
+        return !!_fact_table[id];
+    }
+
+    bool internal_implements_by_mixin(feature_id id, const internal::fact_feature_tag&) const
+    {
+        return !!_fact_table[id];
+    }
+
+    size_t internal_num_implementers(feature_id id, const internal::fact_feature_tag&) const;
+
     // contains all registered type class ids which were match this type info
     // thus if a type class is registerd it will be faster to check whether it matches an info
     std::vector<type_class_id> _matching_type_classes;
 };
 
+namespace internal
+{
+// the call table of types which differ only by mixins which don't implement messages
+// in types the mixins which implement messages are first in the mixin data of objects
+// (see object_domain::get_object_type_info), so the mixin indices in the table are valid for all of them
+struct shared_call_table
+{
+    object_type_info::call_table_entry entries[DYNAMIX_MAX_MESSAGES];
+
+    // a single buffer for all dynamically allocated message pointers to minimize allocations
+    object_type_info::call_table_message* message_data_buffer;
+
+    // the mixins which implement messages
+    available_mixins_bitset implementers;
+
+    // the registered messages when the table was filled (see domain::_messages_version)
+    uint32_t messages_version;
+
+    // number of types which use the table
+    size_t num_types;
+};
+} // namespace internal
+
 } // namespace dynamix
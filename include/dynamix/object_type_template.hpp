@@ -9,6 +9,7 @@
 
 #include "config.hpp"
 #include "object_mutator.hpp"
+#include "object_domain.hpp"
 
 namespace dynamix
 {
@@ -21,7 +22,8 @@ namespace dynamix
 class DYNAMIX_API object_type_template : private internal::object_mutator
 {
 public:
-    object_type_template();
+    /// The objects created from the template are in the given domain
+    explicit object_type_template(object_domain& domain = object_domain::global());
 
     using internal::object_mutator::add;
     // does the actual creation of the type template
@@ -30,6 +32,8 @@ public:
 
     // hiding the parent function, not using it
     void apply_to(object& o) const;
+
+    object_domain& domain() const { return *_domain; }
 };
 
 } // namespace dynamix
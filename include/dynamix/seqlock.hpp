@@ -0,0 +1,188 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Consistent reads of mixins from threads other than the one which writes them.
+ *
+ * Mixins with the `seqlocked` feature have a sequence counter after them in their memory.
+ * Non-const messages and `write_consistent` increment it before and after they access
+ * the mixin, so it's odd while the mixin is being written.
+ *
+ * `read_consistent<transform>(obj, fn)` calls `fn` with the mixin and calls it again
+ * while the mixin was being written during the call. Readers never block the writer.
+ *
+ * A mixin may only be written from one thread. The reading function may be called with
+ * a torn state which is then discarded, so it should only copy values from the mixin.
+ * It must not follow pointers from it or change anything but its own output.
+ * The object must not be mutated while it's being read.
+ *
+ * The feature requires DYNAMIX_SEQLOCKED_MIXINS in all modules which call non-const
+ * messages of such mixins. Without it the message callers don't touch the counters.
+ */
+
+#include "config.hpp"
+#include "object.hpp"
+#include "object_type_info.hpp"
+#include "mixin_type_info.hpp"
+#include "internal/mixin_data_in_object.hpp"
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+#   include "concurrent_mutations.hpp"
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace dynamix
+{
+
+namespace internal
+{
+typedef std::atomic<uint32_t> seqlock_counter;
+
+inline seqlock_counter* seqlock_of(const void* mixin, size_t seqlock_offset) noexcept
+{
+    return reinterpret_cast<seqlock_counter*>(reinterpret_cast<char*>(const_cast<void*>(mixin)) + seqlock_offset);
+}
+
+// the counter is after the first instance of double-buffered mixins
+inline seqlock_counter* seqlock_of(const object& obj, const mixin_type_info& info) noexcept
+{
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    const mixin_data_in_object* data = obj._published_mixin_data.load(std::memory_order_acquire);
+    const object_type_info* type = object_type_info::of_mixin_data(data);
+#else
+    const mixin_data_in_object* data = obj._mixin_data;
+    const object_type_info* type = obj._type_info;
+#endif
+    return seqlock_of(data[type->mixin_index(info.id)].mixin(), info.seqlock_offset);
+}
+
+// called when a seqlocked mixin is placed in a new buffer
+inline void init_seqlock(void* mixin, size_t seqlock_offset) noexcept
+{
+    if (seqlock_offset)
+    {
+        new (seqlock_of(mixin, seqlock_offset)) seqlock_counter(0);
+    }
+}
+
+// the counter of a mixin which is called through an object with the constness of Object
+// const calls don't write, so they have none
+template <typename Object>
+seqlock_counter* seqlock_for_call(const object_type_info* type, const mixin_data_in_object* data, uint32_t mixin_index) noexcept
+{
+    if (std::is_const<Object>::value || !type->_has_seqlocked_mixins) return nullptr;
+
+    // default message implementations aren't mixins
+    if (mixin_index < object_type_info::MIXIN_INDEX_OFFSET) return nullptr;
+
+    const size_t offset = type->_compact_mixins[mixin_index - object_type_info::MIXIN_INDEX_OFFSET]->seqlock_offset;
+    return offset ? seqlock_of(data[mixin_index].mixin(), offset) : nullptr;
+}
+
+// makes the counter odd while the mixin is being written
+// nested scopes of the same mixin (a message calling another one) leave it to the outermost one
+class seqlock_write_scope
+{
+public:
+    explicit seqlock_write_scope(seqlock_counter* counter) noexcept
+        : _counter(counter)
+    {
+        if (!_counter) return;
+
+        // there is only one writer, so no read-modify-write is needed
+        _seq = _counter->load(std::memory_order_relaxed);
+        if (_seq & 1)
+        {
+            _counter = nullptr;
+            return;
+        }
+
+        _counter->store(_seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    ~seqlock_write_scope()
+    {
+        if (_counter)
+        {
+            _counter->store(_seq + 2, std::memory_order_release);
+        }
+    }
+
+    seqlock_write_scope(const seqlock_write_scope&) = delete;
+    seqlock_write_scope& operator=(const seqlock_write_scope&) = delete;
+
+private:
+    seqlock_counter* _counter;
+    uint32_t _seq = 0;
+};
+} // namespace internal
+
+// the write scope of the sequence counter of a mixin for a message call through an object
+// with the constness of Object
+// without seqlocked mixins the callers don't look for counters at all
+#if DYNAMIX_SEQLOCKED_MIXINS
+#   define I_DYNAMIX_CALL_SEQLOCK(Object, type, data, mixin_index) \
+        ::dynamix::internal::seqlock_write_scope _dynamix_seqlock(::dynamix::internal::seqlock_for_call<Object>(type, data, mixin_index))
+#else
+#   define I_DYNAMIX_CALL_SEQLOCK(Object, type, data, mixin_index)
+#endif
+
+/// Calls `fn` with a const reference to the mixin of the object until the mixin
+/// wasn't written during the call. Returns false if the object doesn't have the mixin.
+/// The mixin must have the `seqlocked` feature.
+template <typename Mixin, typename Func>
+bool read_consistent(const object& obj, Func&& fn)
+{
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    read_scope scope;
+#endif
+    const Mixin* mixin = obj.get<Mixin>();
+    if (!mixin) return false;
+
+    const auto& info = _dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr));
+    I_DYNAMIX_ASSERT_MSG(info.seqlock_offset, "read_consistent needs a seqlocked mixin");
+    const internal::seqlock_counter& counter = *internal::seqlock_of(obj, info);
+
+    for (;;)
+    {
+        const uint32_t seq = counter.load(std::memory_order_acquire);
+        if (seq & 1) continue; // being written
+
+        fn(*mixin);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (counter.load(std::memory_order_relaxed) == seq) return true;
+    }
+}
+
+/// Calls `fn` with a reference to the mixin of the object, so that concurrent
+/// `read_consistent` calls see either the state before or after it.
+/// Returns false if the object doesn't have the mixin.
+/// The mixin must have the `seqlocked` feature.
+template <typename Mixin, typename Func>
+bool write_consistent(object& obj, Func&& fn)
+{
+    Mixin* mixin = obj.get<Mixin>();
+    if (!mixin) return false;
+
+    const auto& info = _dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr));
+    I_DYNAMIX_ASSERT_MSG(info.seqlock_offset, "write_consistent needs a seqlocked mixin");
+
+    internal::seqlock_write_scope scope(internal::seqlock_of(obj, info));
+    fn(*mixin);
+    return true;
+}
+
+} // namespace dynamix
@@ -0,0 +1,130 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Access to required sibling mixins.
+ */
+
+#include "config.hpp"
+#include "object.hpp"
+#include "object_of.hpp"
+#include "object_type_info.hpp"
+#include "mixin_type_info.hpp"
+#include "double_buffer.hpp"
+#include "internal/mixin_data_in_object.hpp"
+#include "internal/assert.hpp"
+
+namespace dynamix
+{
+namespace internal
+{
+
+inline uint32_t find_sibling_link(const mixin_type_info& mixin, const mixin_type_info& sibling)
+{
+    for (auto& link : mixin.required_siblings)
+    {
+        if (link.sibling == &sibling) return link.id;
+    }
+
+    I_DYNAMIX_ASSERT_MSG(false, "mixin doesn't require this sibling");
+    return ~uint32_t(0);
+}
+
+// what a mixin needs to get to a sibling, cached for each mixin-sibling pair
+// so getting the sibling doesn't call into the translation units of the mixins
+struct sibling_link_data
+{
+    uint32_t id;
+    size_t double_buffer_offset;
+};
+
+// the data is cached by the first call, when the mixin is registered
+// link ids are reused after unregistering, so the cache is valid until the mixin is unregistered
+// with multiple modules, it's shared by all of them on ELF platforms and is per module on Windows,
+// so sibling must not be called from other modules for mixins of a plugin which has been reloaded
+template <typename Mixin, typename Sibling>
+struct sibling_link_cache
+{
+    static const sibling_link_data& get()
+    {
+        static const sibling_link_data data = {
+            find_sibling_link(
+                _dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr)),
+                _dynamix_get_mixin_type_info(static_cast<Sibling*>(nullptr))),
+            _dynamix_get_mixin_type_info(static_cast<Sibling*>(nullptr)).double_buffer_offset,
+        };
+        return data;
+    }
+};
+
+} // namespace internal
+
+/**
+ * \brief gets a required sibling of a mixin
+ *
+ * \param[in] self the address of the mixin (typically `this`)
+ *
+ * \return A pointer to the sibling mixin in the same object
+ *
+ * The sibling must be declared with the `requires_sibling` feature of the mixin.
+ * Its index is resolved once per object type and the link to it is cached
+ * for each mixin-sibling pair, so unlike `object::get`, this doesn't go through
+ * the mixin id nor call a function.
+ *
+ * \par Example:
+ * \code
+ * DYNAMIX_DEFINE_MIXIN(physics, update_msg & requires_sibling<transform>());
+ *
+ * void physics::update()
+ * {
+ *     dynamix::sibling<transform>(this)->move(velocity);
+ * }
+ * \endcode
+ */
+template <typename Sibling, typename Mixin>
+Sibling* sibling(Mixin* self) noexcept
+{
+    object* obj = object_of(self);
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // called from the mixin, so the caller should be in a read scope
+    internal::mixin_data_in_object* mixin_datas = obj->_published_mixin_data.load(std::memory_order_acquire);
+    const object_type_info* type_info = object_type_info::of_mixin_data(mixin_datas);
+#else
+    internal::mixin_data_in_object* mixin_datas = obj->_mixin_data;
+    const object_type_info* type_info = obj->_type_info;
+#endif
+    const internal::sibling_link_data& link = internal::sibling_link_cache<Mixin, Sibling>::get();
+    uint32_t index = type_info->_sibling_indices[link.id];
+    return reinterpret_cast<Sibling*>(internal::double_buffer_instance<Mixin>(mixin_datas[index].mixin(),
+        link.double_buffer_offset));
+}
+
+/**
+ * \copydoc sibling()
+ */
+template <typename Sibling, typename Mixin>
+const Sibling* sibling(const Mixin* self) noexcept
+{
+    const object* obj = object_of(self);
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // called from the mixin, so the caller should be in a read scope
+    internal::mixin_data_in_object* mixin_datas = obj->_published_mixin_data.load(std::memory_order_acquire);
+    const object_type_info* type_info = object_type_info::of_mixin_data(mixin_datas);
+#else
+    internal::mixin_data_in_object* mixin_datas = obj->_mixin_data;
+    const object_type_info* type_info = obj->_type_info;
+#endif
+    const internal::sibling_link_data& link = internal::sibling_link_cache<Mixin, Sibling>::get();
+    uint32_t index = type_info->_sibling_indices[link.id];
+    return reinterpret_cast<const Sibling*>(internal::double_buffer_instance<const Mixin>(mixin_datas[index].mixin(),
+        link.double_buffer_offset));
+}
+
+} // namespace dynamix
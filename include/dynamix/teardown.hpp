@@ -0,0 +1,59 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Bulk teardown of objects.
+ */
+
+#include "config.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace dynamix
+{
+
+class object;
+
+/// Options of a teardown
+struct teardown_options
+{
+    /// Whether the mixins which are not trivially destructible are destroyed.
+    /// If false, only the mixins with the `destroy_on_teardown` feature are.
+    bool call_destructors = true;
+
+    /// Whether the mixins and the mixin data of the objects are deallocated by their allocators.
+    /// Set it to false if the memory comes from arenas which are released as a whole afterwards.
+    bool release_memory = true;
+
+    /// If set, the mixins are destroyed through it, so that it can be done in parallel
+    /// (say with a job system). It must call `task(i)` for each `i` in `[0, num_tasks)`
+    /// and return when all calls are complete.
+    /// Everything else, including deallocation, is done in the calling thread.
+    std::function<void(size_t num_tasks, const std::function<void(size_t)>& task)> parallel_for;
+
+    /// Number of tasks for `parallel_for`
+    size_t num_tasks = 8;
+};
+
+/// Makes many objects empty at once, say at shutdown or when a world is unloaded.
+/// This is faster than clearing or destroying them one by one:
+/// * Trivially destructible mixins are not destroyed at all (not even by the allocator's `destroy_mixin`)
+/// * The mixin and type metrics are updated once per type instead of per mixin
+/// * Optionally the memory is not deallocated and the destructors are not called
+///
+/// The objects stay valid and empty and can be mutated or destroyed afterwards.
+/// Other threads must not use them during the teardown.
+DYNAMIX_API void teardown(object* const* objects, size_t count, const teardown_options& options = teardown_options());
+
+/// Teardown of a contiguous array of objects
+DYNAMIX_API void teardown(object* objects, size_t count, const teardown_options& options = teardown_options());
+
+} // namespace dynamix
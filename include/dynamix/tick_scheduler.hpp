@@ -0,0 +1,250 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * A scheduler which calls a message for objects at different rates.
+ *
+ * Each object is in a bucket with a period which is a power of two. An object with a
+ * period of 4 is called every 4th frame. The objects of a bucket are spread over the
+ * frames of its period so that the number of calls per frame is as even as possible.
+ *
+ * The period of an object is either set explicitly or it's the smallest period set
+ * for its mixins (or the default period if none of its mixins have one).
+ *
+ * The due objects of a frame are grouped by type and the message is resolved
+ * in the call table once per type.
+ *
+ * The dispatch calls the messages through their message structs, which the legacy message
+ * macros don't provide, so it's not available with DYNAMIX_USE_LEGACY_MESSAGE_MACROS.
+ */
+
+#include "config.hpp"
+#include "mixin_id.hpp"
+#include "object.hpp"
+#include "object_type_info.hpp"
+#include "mutation_events.hpp"
+#include "internal/message_callers.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dynamix
+{
+
+class DYNAMIX_API tick_scheduler
+{
+public:
+    /// Objects whose mixins have no period are in the bucket of the default period
+    explicit tick_scheduler(uint32_t default_period = 1);
+    ~tick_scheduler();
+
+    tick_scheduler(const tick_scheduler&) = delete;
+    tick_scheduler& operator=(const tick_scheduler&) = delete;
+
+    /// Maximum period of a bucket
+    static const uint32_t MAX_PERIOD = 1024;
+
+    /// Sets the period of objects with the mixin (0 to clear it)
+    /// Objects which don't have an explicit period are rebucketed.
+    void set_mixin_period(mixin_id id, uint32_t period);
+
+    template <typename Mixin>
+    void set_mixin_period(uint32_t period)
+    {
+        set_mixin_period(_dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr)).id, period);
+    }
+
+    /// Adds an object with the period of its mixins
+    void add(object& obj);
+
+    /// Adds an object with an explicit period
+    void add(object& obj, uint32_t period);
+
+    /// Removes an object. Destroyed objects must be removed before the next dispatch,
+    /// unless the scheduler is notified of the mutations (see `on_mutations`).
+    void remove(const object& obj);
+
+    bool has(const object& obj) const;
+
+    /// Sets an explicit period of an object which has been added
+    void set_period(object& obj, uint32_t period);
+
+    /// Makes the object use the period of its mixins again
+    void clear_period(object& obj);
+
+    /// Moves an object to the bucket of the period of its mixins (if it doesn't have an explicit one)
+    /// Call it after mutations, unless the scheduler is notified of them (see `on_mutations`).
+    void rebucket(object& obj);
+
+    /// Rebuckets the objects in the events and removes the ones which became empty or were destroyed.
+    /// Add it as a subscriber for mutation events to keep the buckets up to date:
+    /// `mutation_events::add_subscriber([&](const std::vector<mutation_event>& e) { s.on_mutations(e); });`
+    void on_mutations(const std::vector<mutation_event>& events);
+
+    /// Returns the period of an object which has been added
+    uint32_t period(const object& obj) const;
+
+    /// Returns the periods of the buckets which are not empty
+    std::vector<uint32_t> periods() const;
+
+    size_t num_objects() const { return _objects.size(); }
+
+    /// Returns the number of objects which are due in the current frame
+    size_t num_due() const;
+
+    /// Current frame
+    uint64_t frame() const { return _frame; }
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    /// Calls the message for the objects due in the current frame.
+    /// Objects which don't implement the message are skipped.
+    /// The same arguments are passed to all calls, so they're never moved.
+    /// The messages must not remove objects from the scheduler or destroy them.
+    template <typename Message, typename... Args>
+    void dispatch(Message* msg, Args&&... args)
+    {
+        collect_due(0);
+        call_due(msg, args...);
+    }
+
+    /// Calls the message for the objects of a single bucket which are due in the current frame.
+    /// Objects in the bucket of a period are called every `period` frames, so this allows
+    /// passing different arguments (say time steps) to the different buckets.
+    template <typename Message, typename... Args>
+    void dispatch_period(uint32_t period, Message* msg, Args&&... args)
+    {
+        collect_due(period);
+        call_due(msg, args...);
+    }
+
+#endif
+
+    /// Advances to the next frame
+    void advance() { ++_frame; }
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    /// Calls the message for the objects due in the current frame and advances to the next frame
+    template <typename Message, typename... Args>
+    void tick(Message* msg, Args&&... args)
+    {
+        dispatch(msg, args...);
+        advance();
+    }
+#endif
+
+private:
+    struct bucket
+    {
+        uint32_t period;
+
+        // a list of objects per frame of the period
+        std::vector<std::vector<object*>> slots;
+    };
+
+    struct object_entry
+    {
+        uint32_t period;
+        uint32_t slot;
+        uint32_t index; // in the slot
+        bool explicit_period;
+    };
+
+    uint32_t period_for(const object_type_info& type) const;
+    void insert(object& obj, uint32_t period, bool explicit_period);
+    void erase(object_entry& entry);
+    void move_to_period(object& obj, object_entry& entry, uint32_t period);
+    uint32_t least_loaded_slot(uint32_t period) const;
+    void add_load(uint32_t period, uint32_t slot, int delta);
+
+    // fills _due with the objects due in the current frame sorted by type
+    // zero period means all buckets
+    void collect_due(uint32_t period);
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    template <typename Message, typename... Args>
+    void call_due(Message*, Args&&... args)
+    {
+        typedef typename std::remove_pointer<
+            decltype(internal::message_object_of(&Message::make_call))>::type message_object;
+        typedef typename Message::caller_func caller_func;
+
+        const feature_id id = _dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr)).id;
+        const bool multicast = static_cast<const internal::message_t&>(
+            _dynamix_get_mixin_feature_fast(static_cast<Message*>(nullptr))).mechanism == internal::message_t::multicast;
+
+        for (size_t i = 0; i < _due.size(); )
+        {
+            const object_type_info* type = _due[i].first;
+            const auto& entry = type->_call_table[id];
+
+            // resolve the message once per type
+            const object_type_info::call_table_message* begin;
+            const object_type_info::call_table_message* end;
+            if (multicast)
+            {
+                begin = entry.begin;
+                end = entry.end;
+            }
+            else
+            {
+                begin = &entry.top_bid_message;
+                end = entry.top_bid_message ? begin + 1 : begin;
+            }
+
+            for (; i < _due.size() && _due[i].first == type; ++i)
+            {
+                message_object& obj = *_due[i].second;
+
+                if (obj._type_info != type)
+                {
+                    // mutated by a message called earlier in this dispatch
+                    if (obj.implements(static_cast<Message*>(nullptr)))
+                    {
+                        Message::call(obj, args...);
+                    }
+                    continue;
+                }
+
+                internal::invalidate_memos_on_call(obj);
+
+                for (auto msg = begin; msg != end; ++msg)
+                {
+                    char* mixin_data = I_DYNAMIX_CALL_INSTANCE(message_object,
+                        obj._mixin_data[msg->mixin_index].mixin(), msg->double_buffer_offset);
+                    auto func = reinterpret_cast<caller_func>(msg->caller);
+                    I_DYNAMIX_CALL_SEQLOCK(message_object, type, obj._mixin_data, msg->mixin_index);
+                    func(mixin_data, args...);
+                }
+            }
+        }
+    }
+#endif
+
+    uint32_t _default_period;
+    uint64_t _frame = 0;
+
+    // 0 for mixins without a period
+    uint32_t _mixin_periods[DYNAMIX_MAX_MIXINS];
+
+    // sorted by period
+    std::vector<bucket> _buckets;
+
+    // number of objects per frame for a cycle of the largest period
+    std::vector<size_t> _frame_load;
+
+    std::unordered_map<const object*, object_entry> _objects;
+
+    std::vector<std::pair<const object_type_info*, object*>> _due;
+};
+
+} // namespace dynamix
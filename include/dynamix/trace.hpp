@@ -0,0 +1,101 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Optional tracing layer. When enabled, the library records scoped events for
+ * mutation phases, call table creation and mixin allocations (if it's built with
+ * `DYNAMIX_TRACE`) and sampled message calls (see `DYNAMIX_TRACE_MESSAGES`) and can
+ * export them in the Chrome trace event format, readable by chrome://tracing,
+ * Perfetto and others.
+ */
+
+#include "config.hpp"
+#include "internal/preprocessor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace dynamix
+{
+namespace trace
+{
+
+/// Enables or disables the recording of events. Tracing is disabled by default.
+DYNAMIX_API void enable(bool enable = true) noexcept;
+
+/// Returns whether the recording of events is enabled.
+DYNAMIX_API bool is_enabled() noexcept;
+
+/// Record one out of every `n` message calls on each thread.
+/// Only relevant for modules compiled with `DYNAMIX_TRACE_MESSAGES`.
+/// Zero disables message events.
+DYNAMIX_API void set_message_sample_rate(uint32_t n) noexcept;
+
+/// Sets the number of events in each per-thread ring buffer. When a buffer is full
+/// the oldest events are overwritten. Only affects buffers created after the call.
+DYNAMIX_API void set_buffer_capacity(size_t num_events) noexcept;
+
+/// Drops all recorded events.
+/// Events which are recorded by other threads during the call may or may not be dropped.
+DYNAMIX_API void clear() noexcept;
+
+/// Writes all recorded events to the stream as a Chrome trace JSON.
+/// Events are read from the per-thread buffers without synchronization, so
+/// it must not be called while other threads are recording events (for example
+/// after they've been joined).
+DYNAMIX_API void write_chrome_trace(std::ostream& out);
+
+/// Writes all recorded events to a file as a Chrome trace JSON.
+/// Returns false if the file couldn't be opened.
+/// Like the stream version, it must not be called while other threads are recording events.
+DYNAMIX_API bool write_chrome_trace(const char* filename);
+
+/// Records a single event for its lifetime in the current thread's buffer.
+/// Does nothing if tracing is disabled when it's created.
+/// The event is dropped if the buffer of the thread can't be allocated.
+/// Strings are not copied and must outlive the export of the trace.
+class DYNAMIX_API scope
+{
+public:
+    scope(const char* name, const char* category, const char* detail = nullptr) noexcept;
+    ~scope() noexcept;
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+private:
+    friend class message_scope;
+    scope() noexcept = default;
+
+    const char* _name = nullptr;
+    const char* _category = nullptr;
+    const char* _detail = nullptr;
+    uint64_t _begin = 0;
+    bool _active = false;
+};
+
+/// Records a message call. Instantiated by the message callers when
+/// `DYNAMIX_TRACE_MESSAGES` is enabled and subject to the message sample rate.
+class DYNAMIX_API message_scope : private scope
+{
+public:
+    explicit message_scope(const char* message_name) noexcept;
+};
+
+} // namespace trace
+} // namespace dynamix
+
+// scopes in the library, which are compiled only with DYNAMIX_TRACE
+#if DYNAMIX_TRACE
+#   define I_DYNAMIX_TRACE_SCOPE(...) ::dynamix::trace::scope I_DYNAMIX_PP_CAT(_dynamix_trace_scope_, __LINE__)(__VA_ARGS__)
+#else
+#   define I_DYNAMIX_TRACE_SCOPE(...)
+#endif
@@ -0,0 +1,116 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+/**
+ * \file
+ * Workload capture and replay.
+ *
+ * The recorder writes a compact binary stream of object creations, destructions
+ * and moves, mutations (with mixin names), object type template applications and
+ * message calls (by message name with argument sizes). Message calls are only
+ * recorded from modules compiled with `DYNAMIX_RECORD_MESSAGES` and the other events
+ * only if the library is built with `DYNAMIX_RECORD_WORKLOAD`. Without it objects are
+ * implicitly created with their current type when they're first used in a recorded call
+ * (so a destroyed object and a new one at the same address are recorded as one).
+ *
+ * The replayer rebuilds the same object population from the registered mixins
+ * and re-executes the stream, so it can be used as a benchmark under different
+ * allocators and configurations.
+ */
+
+#include "config.hpp"
+#include "feature.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace dynamix
+{
+
+class object;
+class object_allocator;
+class object_type_info;
+
+namespace workload
+{
+
+/// Starts recording all supported events to the stream.
+/// The stream must be binary and must outlive the recording.
+/// Any previous recording is stopped.
+DYNAMIX_API void start_recording(std::ostream& out);
+
+/// Stops the recording and flushes all recorded events to the stream.
+DYNAMIX_API void stop_recording();
+
+/// Returns whether a recording is active.
+DYNAMIX_API bool is_recording() noexcept;
+
+/// Statistics of a replay
+struct replay_stats
+{
+    size_t num_objects = 0; ///< objects created by the replay
+    size_t num_mutations = 0; ///< mutations and template applications
+    size_t num_messages = 0; ///< message calls which were executed by a handler
+    size_t num_skipped_messages = 0; ///< message calls without a handler
+    size_t num_unresolved_mixins = 0; ///< mixin names which are not registered
+    double seconds = 0; ///< time spent in the replay
+};
+
+/// Rebuilds and re-executes a recorded workload.
+///
+/// Since messages can't be called without their arguments, message calls
+/// are replayed through handlers set by message name. Calls of messages
+/// without a handler are counted but skipped.
+class DYNAMIX_API replayer
+{
+public:
+    using message_handler = std::function<void(object&)>;
+
+    replayer();
+    ~replayer();
+
+    replayer(const replayer&) = delete;
+    replayer& operator=(const replayer&) = delete;
+
+    /// Reads a recorded stream. Returns false if the stream is not a valid recording.
+    bool load(std::istream& in);
+
+    /// Sets the allocator to be used for the objects created by the replay.
+    void set_object_allocator(object_allocator* allocator) { _allocator = allocator; }
+
+    /// Sets a handler which will be called in place of a recorded message call.
+    void set_message_handler(const char* message_name, message_handler handler);
+
+    /// Executes the loaded stream.
+    /// Objects which are alive at the end of the stream are destroyed afterwards
+    /// and their destruction is not included in the measured time.
+    replay_stats run();
+
+    /// Number of recorded events
+    size_t num_events() const;
+
+private:
+    struct data;
+    std::unique_ptr<data> _data;
+    object_allocator* _allocator = nullptr;
+};
+
+} // namespace workload
+
+namespace internal
+{
+// recorder hooks
+DYNAMIX_API void record_message_call(const object& obj, const feature& msg, const uint32_t* arg_sizes, uint32_t num_args);
+}
+
+} // namespace dynamix
@@ -0,0 +1,386 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// memory footprint of objects of typical compositions
+// compared to equivalent designs with virtual functions and std::function
+//
+// all heap allocations are counted by replacing the global operator new
+// allocator headers are estimated for a 64-bit glibc malloc: chunks are 16-byte aligned,
+// have an 8 byte header and are at least 32 bytes
+
+#include <dynamix/dynamix.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+//////////////////////////////////
+// allocation counting
+
+namespace
+{
+size_t live_bytes = 0;
+size_t live_headers = 0;
+size_t live_allocations = 0;
+
+size_t malloc_header(size_t size)
+{
+    size_t chunk = (size + 8 + 15) & ~size_t(15);
+    if (chunk < 32) chunk = 32;
+    return chunk - size;
+}
+
+// keep the size in front of the block to be able to count deallocations
+const size_t COUNT_HEADER = 16;
+}
+
+void* operator new(size_t size)
+{
+    auto ptr = static_cast<char*>(std::malloc(size + COUNT_HEADER));
+    if (!ptr) throw std::bad_alloc();
+    memcpy(ptr, &size, sizeof(size));
+    live_bytes += size;
+    live_headers += malloc_header(size);
+    ++live_allocations;
+    return ptr + COUNT_HEADER;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (!p) return;
+    auto ptr = static_cast<char*>(p) - COUNT_HEADER;
+    size_t size;
+    memcpy(&size, ptr, sizeof(size));
+    live_bytes -= size;
+    live_headers -= malloc_header(size);
+    --live_allocations;
+    std::free(ptr);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+
+struct snapshot
+{
+    snapshot()
+        : bytes(live_bytes)
+        , headers(live_headers)
+        , allocations(live_allocations)
+    {}
+
+    size_t bytes, headers, allocations;
+};
+
+struct footprint
+{
+    double bytes = 0; // total per object including headers and type share
+    double allocations = 0;
+    double headers = 0;
+    double type_share = 0;
+};
+
+//////////////////////////////////
+// payload
+// each component has 16 bytes of data and implements add and sum
+
+const int MAX_COMPONENTS = 6;
+const size_t NUM_OBJECTS = 10000;
+
+struct payload
+{
+    int data[4] = {};
+};
+
+//////////////////////////////////
+// virtual
+
+class component_base
+{
+public:
+    virtual ~component_base() {}
+    virtual void add(int i) = 0;
+    virtual int sum() const = 0;
+};
+
+template <int N>
+class virtual_component : public component_base, public payload
+{
+public:
+    virtual void add(int i) override { data[0] += i + N; }
+    virtual int sum() const override { return data[0]; }
+};
+
+struct virtual_entity
+{
+    virtual_entity() = default;
+    virtual_entity(virtual_entity&&) = default;
+    ~virtual_entity()
+    {
+        for (auto c : components) delete c;
+    }
+
+    std::vector<component_base*> components;
+};
+
+template <int N>
+void add_virtual_components(virtual_entity& e, int count)
+{
+    if (N >= count) return;
+    e.components.push_back(new virtual_component<N>);
+    add_virtual_components<(N + 1) % MAX_COMPONENTS>(e, N + 1 == MAX_COMPONENTS ? 0 : count);
+}
+
+//////////////////////////////////
+// std::function
+
+template <int N>
+struct func_component : public payload
+{
+    void add(int i) { data[0] += i + N; }
+    int sum() const { return data[0]; }
+};
+
+struct func_entity
+{
+    func_entity() = default;
+    func_entity(func_entity&&) = default;
+    ~func_entity()
+    {
+        for (auto& r : release) r();
+    }
+
+    std::vector<std::function<void(int)>> adds;
+    std::vector<std::function<int()>> sums;
+    std::vector<std::function<void()>> release;
+};
+
+template <int N>
+void add_func_components(func_entity& e, int count)
+{
+    if (N >= count) return;
+    auto c = new func_component<N>;
+    e.adds.emplace_back([c](int i) { c->add(i); });
+    e.sums.emplace_back([c]() { return c->sum(); });
+    e.release.emplace_back([c]() { delete c; });
+    add_func_components<(N + 1) % MAX_COMPONENTS>(e, N + 1 == MAX_COMPONENTS ? 0 : count);
+}
+
+//////////////////////////////////
+// dynamix
+
+DYNAMIX_MULTICAST_MESSAGE_1(void, add, int, i);
+DYNAMIX_CONST_MULTICAST_MESSAGE_0(int, sum);
+
+#define DECLARE_COMPONENT(n) \
+    DYNAMIX_DECLARE_MIXIN(mixin##n); \
+    class mixin##n : public payload \
+    { \
+    public: \
+        void add(int i) { data[0] += i + n; } \
+        int sum() const { return data[0]; } \
+    }; \
+    DYNAMIX_DEFINE_MIXIN(mixin##n, add_msg & sum_msg)
+
+DECLARE_COMPONENT(0);
+DECLARE_COMPONENT(1);
+DECLARE_COMPONENT(2);
+DECLARE_COMPONENT(3);
+DECLARE_COMPONENT(4);
+DECLARE_COMPONENT(5);
+
+DYNAMIX_DEFINE_MESSAGE(add);
+DYNAMIX_DEFINE_MESSAGE(sum);
+
+void add_mixins(dynamix::object& o, int count)
+{
+    dynamix::mutate m(o);
+    if (count > 0) m.add<mixin0>();
+    if (count > 1) m.add<mixin1>();
+    if (count > 2) m.add<mixin2>();
+    if (count > 3) m.add<mixin3>();
+    if (count > 4) m.add<mixin4>();
+    if (count > 5) m.add<mixin5>();
+}
+
+// bump allocator with no per-allocation overhead
+// the memory is allocated with malloc so it's not counted as heap allocations
+class arena_allocator : public dynamix::object_allocator
+{
+public:
+    explicit arena_allocator(size_t capacity)
+        : _buffer(static_cast<char*>(std::malloc(capacity)))
+        , _ptr(_buffer)
+        , _end(_buffer + capacity)
+    {}
+
+    ~arena_allocator()
+    {
+        std::free(_buffer);
+    }
+
+    virtual char* alloc_mixin_data(size_t count, const dynamix::object*) override
+    {
+        return allocate(mixin_data_size * count);
+    }
+
+    virtual void dealloc_mixin_data(char*, size_t, const dynamix::object*) override {}
+
+    virtual std::pair<char*, size_t> alloc_mixin(const dynamix::mixin_type_info& info, const dynamix::object*) override
+    {
+        auto buffer = allocate(mem_size_for_mixin(info.size, info.alignment));
+        return std::make_pair(buffer, mixin_offset(buffer, info.alignment));
+    }
+
+    virtual void dealloc_mixin(char*, size_t, const dynamix::mixin_type_info&, const dynamix::object*) override {}
+
+    virtual object_allocator* on_move(dynamix::object&, dynamix::object&) noexcept override { return this; }
+
+    size_t used() const { return size_t(_ptr - _buffer); }
+
+private:
+    char* allocate(size_t size)
+    {
+        size = (size + 7) & ~size_t(7);
+        if (_ptr + size > _end)
+        {
+            printf("arena allocator out of memory\n");
+            exit(1);
+        }
+        auto ret = _ptr;
+        _ptr += size;
+        return ret;
+    }
+
+    char* const _buffer;
+    char* _ptr;
+    char* const _end;
+};
+
+// capacity of a vector after count push_backs (growth factor 2 as in libstdc++ and libc++)
+size_t vector_capacity(size_t count)
+{
+    size_t cap = 1;
+    while (cap < count) cap *= 2;
+    return cap;
+}
+
+//////////////////////////////////
+// measurement
+
+// measures the memory used by creating NUM_OBJECTS entities with the create function
+// the first entity is measured separately so the memory of shared data (type infos)
+// can be told apart from the per-object memory
+template <typename Entity, typename Create>
+footprint measure(Create create)
+{
+    std::vector<Entity> entities;
+    entities.reserve(NUM_OBJECTS);
+
+    snapshot begin;
+    entities.emplace_back();
+    create(entities.back());
+    snapshot first;
+    for (size_t i = 1; i < NUM_OBJECTS; ++i)
+    {
+        entities.emplace_back();
+        create(entities.back());
+    }
+    snapshot end;
+
+    footprint ret;
+
+    const double n = double(NUM_OBJECTS);
+    double rest_bytes = double(end.bytes - first.bytes) / (n - 1);
+    double first_bytes = double(first.bytes - begin.bytes);
+
+    ret.type_share = (first_bytes - rest_bytes) / n;
+    ret.headers = double(end.headers - begin.headers) / n;
+    ret.allocations = double(end.allocations - begin.allocations) / n;
+    ret.bytes = sizeof(Entity) + double(end.bytes - begin.bytes) / n + ret.headers;
+
+    return ret;
+}
+
+void print_header()
+{
+    printf("| %-26s | %7s | %7s | %7s | %7s | %7s | %7s | %7s | %7s |\n",
+        "design", "total", "allocs", "object", "data", "backptr", "payload", "headers", "types");
+    printf("|----------------------------|---------|---------|---------|---------|---------|---------|---------|---------|\n");
+}
+
+void print_row(const std::string& name, const footprint& f, double object, double data, double backptrs, double payload_bytes)
+{
+    printf("| %-26s | %7.1f | %7.2f | %7.1f | %7.1f | %7.1f | %7.1f | %7.1f | %7.1f |\n",
+        name.c_str(), f.bytes, f.allocations, object, data, backptrs, payload_bytes, f.headers, f.type_share);
+}
+
+int main()
+{
+    using namespace dynamix;
+
+    printf("Memory per object in bytes, averaged over %d objects\n", int(NUM_OBJECTS));
+    printf("data: mixin data array (dynamix), component pointers (virtual), std::function-s (std::function)\n");
+    printf("backptr: object pointers in front of mixins (dynamix), vtable pointers (virtual)\n");
+    printf("headers: estimated malloc headers and rounding\n");
+    printf("types: amortized share of the object type info\n\n");
+
+    const int compositions[] = {1, 3, 6};
+
+    for (int count : compositions)
+    {
+        printf("#### %d component%s, %d bytes of payload each\n\n", count, count > 1 ? "s" : "", int(sizeof(payload)));
+        print_header();
+
+        const double payload_bytes = double(count * sizeof(payload));
+
+        {
+            auto f = measure<object>([count](object& o) { add_mixins(o, count); });
+            // recreate the types for the next measurement
+            internal::domain::safe_instance().garbage_collect_type_infos();
+
+            const double data = double((count + object_type_info::MIXIN_INDEX_OFFSET) * domain_allocator::mixin_data_size);
+            const double mixins = double(count * mixin_allocator::mem_size_for_mixin(sizeof(payload), alignof(payload)));
+            print_row("dynamix", f, sizeof(object), data, mixins - payload_bytes, payload_bytes);
+        }
+
+        {
+            arena_allocator arena(NUM_OBJECTS * 1024);
+            auto f = measure<object>([count, &arena](object& o) {
+                o = object(&arena);
+                add_mixins(o, count);
+            });
+            f.bytes += double(arena.used()) / NUM_OBJECTS;
+            internal::domain::safe_instance().garbage_collect_type_infos();
+
+            const double data = double((count + object_type_info::MIXIN_INDEX_OFFSET) * domain_allocator::mixin_data_size);
+            const double mixins = double(count * mixin_allocator::mem_size_for_mixin(sizeof(payload), alignof(payload)));
+            print_row("dynamix (arena allocator)", f, sizeof(object), data, mixins - payload_bytes, payload_bytes);
+        }
+
+        {
+            auto f = measure<virtual_entity>([count](virtual_entity& e) { add_virtual_components<0>(e, count); });
+            const double data = double(vector_capacity(count) * sizeof(component_base*));
+            print_row("virtual", f, sizeof(virtual_entity), data, double(count * sizeof(void*)), payload_bytes);
+        }
+
+        {
+            auto f = measure<func_entity>([count](func_entity& e) { add_func_components<0>(e, count); });
+            const double data = double(3 * vector_capacity(count) * sizeof(std::function<void()>));
+            print_row("std::function", f, sizeof(func_entity), data, 0, payload_bytes);
+        }
+
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// a multicast message with a 64-byte argument declared by value
+// handled by 8 mixins which take it by const reference
+// compared to one declared with a const reference and to virtual methods
+//
+// make sure link time optimizations are turned of
+// gcc with no -flto
+// msvc with no link time code generation
+#include "perf.hpp"
+#include "picobench.hpp"
+
+using namespace std;
+
+struct event
+{
+    int type;
+    int source;
+    float pos[4];
+    float dir[4];
+    unsigned data[6];
+};
+
+static_assert(sizeof(event) == 64, "the event must be 64 bytes");
+
+DYNAMIX_MULTICAST_MESSAGE_1(void, on_event, event, e);
+DYNAMIX_MULTICAST_MESSAGE_1(void, on_event_cref, const event&, e);
+DYNAMIX_CONST_MULTICAST_MESSAGE_1(void, event_sum, unsigned&, out);
+
+class event_handler
+{
+public:
+    virtual ~event_handler() {}
+    virtual void on_event(const event& e) = 0;
+    virtual void on_event_by_value(event e) = 0;
+    virtual unsigned sum() const = 0;
+};
+
+template <int N>
+class handler final : public event_handler
+{
+public:
+    virtual void on_event(const event& e) override
+    {
+        handled += e.data[N % 6] + unsigned(e.type);
+    }
+
+    virtual void on_event_by_value(event e) override
+    {
+        handled += e.data[N % 6] + unsigned(e.type);
+    }
+
+    virtual unsigned sum() const override
+    {
+        return handled;
+    }
+
+    void on_event_cref(const event& e)
+    {
+        on_event(e);
+    }
+
+    void event_sum(unsigned& out) const
+    {
+        out += handled;
+    }
+
+    unsigned handled = 0;
+};
+
+#define EVENT_HANDLER_MIXIN(n) \
+    using handler##n = handler<n>; \
+    DYNAMIX_DEFINE_MIXIN(handler##n, on_event_msg & on_event_cref_msg & event_sum_msg);
+
+EVENT_HANDLER_MIXIN(0)
+EVENT_HANDLER_MIXIN(1)
+EVENT_HANDLER_MIXIN(2)
+EVENT_HANDLER_MIXIN(3)
+EVENT_HANDLER_MIXIN(4)
+EVENT_HANDLER_MIXIN(5)
+EVENT_HANDLER_MIXIN(6)
+EVENT_HANDLER_MIXIN(7)
+
+DYNAMIX_DEFINE_MESSAGE(on_event);
+DYNAMIX_DEFINE_MESSAGE(on_event_cref);
+DYNAMIX_DEFINE_MESSAGE(event_sum);
+
+namespace
+{
+
+struct virtual_handlers
+{
+    virtual_handlers()
+    {
+        handlers.push_back(new handler0);
+        handlers.push_back(new handler1);
+        handlers.push_back(new handler2);
+        handlers.push_back(new handler3);
+        handlers.push_back(new handler4);
+        handlers.push_back(new handler5);
+        handlers.push_back(new handler6);
+        handlers.push_back(new handler7);
+    }
+
+    virtual_handlers(const virtual_handlers&) = delete;
+    virtual_handlers(virtual_handlers&& other)
+        : handlers(std::move(other.handlers))
+    {}
+
+    ~virtual_handlers()
+    {
+        for (auto h : handlers)
+        {
+            delete h;
+        }
+    }
+
+    std::vector<event_handler*> handlers;
+};
+
+dynamix::object new_event_object()
+{
+    dynamix::object o;
+    dynamix::mutate(o)
+        .add<handler0>()
+        .add<handler1>()
+        .add<handler2>()
+        .add<handler3>()
+        .add<handler4>()
+        .add<handler5>()
+        .add<handler6>()
+        .add<handler7>();
+    return o;
+}
+
+event make_event(int i)
+{
+    event e = {};
+    e.type = i & 1;
+    for (auto& d : e.data)
+    {
+        d = unsigned(i);
+    }
+    return e;
+}
+
+}
+
+PICOBENCH_SUITE("8x multi 64-byte event");
+
+static void virtual_event_by_value(picobench::state& s)
+{
+    vector<virtual_handlers> data(s.iterations());
+
+    auto& ints = random_ints();
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        auto e = make_event(ints[cnt]);
+        for (auto h : data[cnt].handlers)
+        {
+            h->on_event_by_value(e);
+        }
+        ++cnt;
+    }
+
+    unsigned sum = 0;
+    for (auto& d : data)
+    {
+        for (auto h : d.handlers) sum += h->sum();
+    }
+    s.set_result(sum);
+}
+PICOBENCH(virtual_event_by_value);
+
+static void virtual_event(picobench::state& s)
+{
+    vector<virtual_handlers> data(s.iterations());
+
+    auto& ints = random_ints();
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        auto e = make_event(ints[cnt]);
+        for (auto h : data[cnt].handlers)
+        {
+            h->on_event(e);
+        }
+        ++cnt;
+    }
+
+    unsigned sum = 0;
+    for (auto& d : data)
+    {
+        for (auto h : d.handlers) sum += h->sum();
+    }
+    s.set_result(sum);
+}
+PICOBENCH(virtual_event).baseline();
+
+static void msg_event(picobench::state& s)
+{
+    vector<dynamix::object> data;
+    data.reserve(s.iterations());
+    for (int i = 0; i < s.iterations(); ++i)
+    {
+        data.emplace_back(new_event_object());
+    }
+
+    auto& ints = random_ints();
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        on_event(data[cnt], make_event(ints[cnt]));
+        ++cnt;
+    }
+
+    unsigned sum = 0;
+    for (auto& o : data)
+    {
+        event_sum(o, sum);
+    }
+    s.set_result(sum);
+}
+PICOBENCH(msg_event);
+
+static void msg_event_cref(picobench::state& s)
+{
+    vector<dynamix::object> data;
+    data.reserve(s.iterations());
+    for (int i = 0; i < s.iterations(); ++i)
+    {
+        data.emplace_back(new_event_object());
+    }
+
+    auto& ints = random_ints();
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        on_event_cref(data[cnt], make_event(ints[cnt]));
+        ++cnt;
+    }
+
+    unsigned sum = 0;
+    for (auto& o : data)
+    {
+        event_sum(o, sum);
+    }
+    s.set_result(sum);
+}
+PICOBENCH(msg_event_cref);
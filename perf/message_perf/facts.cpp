@@ -0,0 +1,143 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// reading a per-mixin constant with a unicast message,
+// with a virtual method, and as a fact
+//
+// make sure link time optimizations are turned of
+// gcc with no -flto
+// msvc with no link time code generation
+#include "perf.hpp"
+#include "picobench.hpp"
+
+using namespace std;
+
+DYNAMIX_MESSAGE_0(float, get_max_speed);
+DYNAMIX_FACT(float, max_speed);
+
+class speed_limit
+{
+public:
+    virtual ~speed_limit() {}
+    virtual float get_max_speed() const = 0;
+};
+
+template <int N>
+class vehicle final : public speed_limit
+{
+public:
+    virtual float get_max_speed() const override
+    {
+        return 10.f * N;
+    }
+
+    // a mixin which is a bit bigger than a pointer,
+    // so that message calls touch more memory
+    int data[4] = {};
+};
+
+#define VEHICLE_MIXIN(n) \
+    using vehicle##n = vehicle<n>; \
+    DYNAMIX_DEFINE_MIXIN(vehicle##n, get_max_speed_msg & fact(max_speed_fact, 10.f * n));
+
+VEHICLE_MIXIN(1)
+VEHICLE_MIXIN(2)
+VEHICLE_MIXIN(3)
+VEHICLE_MIXIN(4)
+
+DYNAMIX_DEFINE_MESSAGE(get_max_speed);
+DYNAMIX_DEFINE_FACT(max_speed);
+
+namespace
+{
+
+speed_limit* new_vehicle(int i)
+{
+    switch (i & 3)
+    {
+    case 0: return new vehicle1;
+    case 1: return new vehicle2;
+    case 2: return new vehicle3;
+    default: return new vehicle4;
+    }
+}
+
+void fill_vehicle_objects(vector<dynamix::object>& data, size_t size)
+{
+    auto& ints = random_ints();
+    data.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data.emplace_back();
+        dynamix::single_object_mutator m(data.back());
+        switch (ints[i] & 3)
+        {
+        case 0: m.add<vehicle1>(); break;
+        case 1: m.add<vehicle2>(); break;
+        case 2: m.add<vehicle3>(); break;
+        default: m.add<vehicle4>(); break;
+        }
+    }
+}
+
+}
+
+PICOBENCH_SUITE("per-type constant");
+
+static void virtual_constant(picobench::state& s)
+{
+    auto& ints = random_ints();
+    vector<unique_ptr<speed_limit>> data;
+    data.reserve(s.iterations());
+    for (int i = 0; i < s.iterations(); ++i)
+    {
+        data.emplace_back(new_vehicle(ints[i]));
+    }
+
+    float sum = 0;
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        sum += data[cnt]->get_max_speed();
+        ++cnt;
+    }
+    s.set_result(size_t(sum));
+}
+PICOBENCH(virtual_constant).baseline();
+
+static void msg_constant(picobench::state& s)
+{
+    vector<dynamix::object> data;
+    fill_vehicle_objects(data, s.iterations());
+
+    float sum = 0;
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        sum += get_max_speed(data[cnt]);
+        ++cnt;
+    }
+    s.set_result(size_t(sum));
+}
+PICOBENCH(msg_constant);
+
+static void fact_constant(picobench::state& s)
+{
+    vector<dynamix::object> data;
+    fill_vehicle_objects(data, s.iterations());
+
+    float sum = 0;
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        sum += *get_fact(data[cnt], max_speed_fact);
+        ++cnt;
+    }
+    s.set_result(size_t(sum));
+}
+PICOBENCH(fact_constant);
@@ -0,0 +1,110 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// reading two mixins of many objects with get
+// and with gathered arrays of pointers
+#include "perf.hpp"
+#include "picobench.hpp"
+
+#include <dynamix/gather.hpp>
+
+using namespace std;
+
+struct position
+{
+    float x = 0;
+};
+
+struct speed
+{
+    float x = 1;
+};
+
+struct marker {};
+
+DYNAMIX_DEFINE_MIXIN(position, dynamix::none);
+DYNAMIX_DEFINE_MIXIN(speed, dynamix::none);
+DYNAMIX_DEFINE_MIXIN(marker, dynamix::none);
+
+namespace
+{
+
+// objects with a few types, some of which lack speed
+// they're visited in an order which doesn't match their order in memory
+void fill_moving_objects(vector<dynamix::object*>& data, size_t size)
+{
+    auto& ints = random_ints();
+    data.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        data.push_back(new dynamix::object);
+        dynamix::single_object_mutator m(*data.back());
+        m.add<position>();
+        if (ints[i] & 3) m.add<speed>();
+        if (ints[i] & 4) m.add<marker>();
+    }
+
+    for (size_t i = size; i > 1; --i)
+    {
+        swap(data[i - 1], data[unsigned(ints[i - 1]) % i]);
+    }
+}
+
+void free_objects(vector<dynamix::object*>& data)
+{
+    for (auto o : data)
+    {
+        delete o;
+    }
+}
+
+}
+
+PICOBENCH_SUITE("two mixins of many objects");
+
+static void get_move(picobench::state& s)
+{
+    vector<dynamix::object*> data;
+    fill_moving_objects(data, s.iterations());
+
+    {
+        picobench::scope time(s);
+        for (auto o : data)
+        {
+            auto v = o->get<speed>();
+            if (!v) continue;
+            o->get<position>()->x += v->x;
+        }
+    }
+
+    s.set_result(size_t(data.front()->get<position>()->x));
+    free_objects(data);
+}
+PICOBENCH(get_move).baseline();
+
+static void gather_move(picobench::state& s)
+{
+    vector<dynamix::object*> data;
+    fill_moving_objects(data, s.iterations());
+
+    vector<position*> positions;
+    vector<const speed*> speeds;
+
+    {
+        picobench::scope time(s);
+        dynamix::gather(data, positions, speeds);
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            positions[i]->x += speeds[i]->x;
+        }
+    }
+
+    s.set_result(size_t(data.front()->get<position>()->x));
+    free_objects(data);
+}
+PICOBENCH(gather_move);
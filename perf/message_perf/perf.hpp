@@ -11,6 +11,7 @@
 
 #define DYNAMIX_NO_MSG_THROW
 #include <dynamix/dynamix.hpp>
+#include <dynamix/interface.hpp>
 
 #include <functional>
 #include <vector>
@@ -111,6 +112,8 @@ DYNAMIX_MESSAGE_1(void, add, int, val);
 DYNAMIX_CONST_MESSAGE_0(int, sum);
 DYNAMIX_CONST_MESSAGE_0(void, noop);
 
+typedef dynamix::interface<decltype(add_msg), decltype(sum_msg), decltype(noop_msg)> perf_interface;
+
 DYNAMIX_MULTICAST_MESSAGE_1(void, multi_add, int, val);
 DYNAMIX_CONST_MULTICAST_MESSAGE_1(void, multi_sum_out, unsigned&, out);
 DYNAMIX_CONST_MULTICAST_MESSAGE_0(unsigned, multi_sum);
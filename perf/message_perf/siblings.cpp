@@ -0,0 +1,92 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// access from a mixin to another mixin of its object with get
+// and through the required sibling index
+#include "perf.hpp"
+#include "picobench.hpp"
+
+#include <dynamix/sibling.hpp>
+
+using namespace std;
+
+struct frame
+{
+    float x = 1;
+};
+
+struct body
+{
+    float get_frame_x() const { return dynamix::object_of(this)->get<frame>()->x; }
+    float sibling_frame_x() const { return dynamix::sibling<frame>(this)->x; }
+};
+
+struct tag {};
+
+DYNAMIX_DEFINE_MIXIN(frame, dynamix::none);
+DYNAMIX_DEFINE_MIXIN(body, dynamix::requires_sibling<frame>());
+DYNAMIX_DEFINE_MIXIN(tag, dynamix::none);
+
+namespace
+{
+
+// the same objects are visited over and over, so the time is in the lookup, not in cache misses
+const size_t num_objects = 256;
+
+void fill_bodies(vector<dynamix::object>& objects, vector<const body*>& bodies)
+{
+    objects.resize(num_objects);
+    for (size_t i = 0; i < num_objects; ++i)
+    {
+        dynamix::single_object_mutator m(objects[i]);
+        m.add<body>(); // adds the frame
+        if (i & 1) m.add<tag>();
+    }
+    for (auto& o : objects)
+    {
+        bodies.push_back(o.get<body>());
+    }
+}
+
+}
+
+PICOBENCH_SUITE("mixin to sibling");
+
+static void get_sibling(picobench::state& s)
+{
+    vector<dynamix::object> objects;
+    vector<const body*> bodies;
+    fill_bodies(objects, bodies);
+
+    float sum = 0;
+    int i = 0;
+    for (auto _ : s)
+    {
+        sum += bodies[i % num_objects]->get_frame_x();
+        ++i;
+    }
+    s.set_result(size_t(sum));
+}
+PICOBENCH(get_sibling).baseline();
+
+static void required_sibling(picobench::state& s)
+{
+    vector<dynamix::object> objects;
+    vector<const body*> bodies;
+    fill_bodies(objects, bodies);
+
+    float sum = 0;
+    int i = 0;
+    for (auto _ : s)
+    {
+        sum += bodies[i % num_objects]->sibling_frame_x();
+        ++i;
+    }
+    s.set_result(size_t(sum));
+}
+PICOBENCH(required_sibling);
@@ -81,6 +81,52 @@ static void msg_noop(picobench::state& s)
 }
 PICOBENCH(msg_noop);
 
+// objects viewed as an interface of the messages
+static void iface_noop(picobench::state& s)
+{
+    vector<dynamix::object> data;
+    data.reserve(s.iterations());
+    for (int i = 0; i < s.iterations(); ++i)
+    {
+        data.emplace_back(new_object(rand()));
+    }
+
+    vector<perf_interface> views;
+    views.reserve(data.size());
+    for (auto& d : data)
+    {
+        views.emplace_back(d);
+    }
+
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        views[cnt++].call(noop_msg);
+    }
+}
+PICOBENCH(iface_noop);
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+// the calls only pay for the fence of the read scope once
+static void msg_noop_read_scope(picobench::state& s)
+{
+    vector<dynamix::object> data;
+    data.reserve(s.iterations());
+    for (int i = 0; i < s.iterations(); ++i)
+    {
+        data.emplace_back(new_object(rand()));
+    }
+
+    dynamix::read_scope scope;
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        noop(data[cnt++]);
+    }
+}
+PICOBENCH(msg_noop_read_scope);
+#endif
+
 PICOBENCH_SUITE("setter");
 
 static void virtual_setter(picobench::state& s)
@@ -168,3 +214,38 @@ static void msg_setter(picobench::state& s)
     assert(isum == random_ints_partial_sums()[s.iterations() - 1]);
 }
 PICOBENCH(msg_setter);
+
+static void iface_setter(picobench::state& s)
+{
+    vector<dynamix::object> data;
+    data.reserve(s.iterations());
+    for (int i = 0; i < s.iterations(); ++i)
+    {
+        data.emplace_back(new_object(rand()));
+    }
+
+    vector<perf_interface> views;
+    views.reserve(data.size());
+    for (auto& d : data)
+    {
+        views.emplace_back(d);
+    }
+
+    auto& ints = random_ints();
+
+    int cnt = 0;
+    for (auto _ : s)
+    {
+        views[cnt].call(add_msg, ints[cnt]);
+        ++cnt;
+    }
+
+    unsigned isum = 0;
+    for (auto& v : views)
+    {
+        isum += v.call(sum_msg);
+    }
+
+    assert(isum == random_ints_partial_sums()[s.iterations() - 1]);
+}
+PICOBENCH(iface_setter);
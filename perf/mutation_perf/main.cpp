@@ -13,6 +13,8 @@
 
 #include "fast_allocator.hpp"
 
+#include <dynamix/adaptive_allocator.hpp>
+
 #include <iostream>
 
 using namespace std;
@@ -157,6 +159,123 @@ void same_type_mutator_alloc(picobench::state& s)
 }
 PICOBENCH(same_type_mutator_alloc);
 
+PICOBENCH_SUITE("Mixin churn");
+
+// objects which gain and lose mixins all the time
+void churn(picobench::state& s, domain_allocator* alloc)
+{
+    object_domain d;
+    if (alloc) d.set_allocator(alloc);
+
+    const int num_objects = 1024;
+    vector<object> objects;
+    objects.reserve(num_objects);
+    for (int i = 0; i < num_objects; ++i)
+    {
+        objects.emplace_back(d);
+        mutate(objects.back()).add<mixin_3>();
+    }
+
+    int i = 0;
+    for (auto _ : s)
+    {
+        auto& o = objects[i % num_objects];
+        if (o.has<mixin_5>())
+        {
+            mutate(o).remove<mixin_5>().remove<mixin_8>();
+        }
+        else
+        {
+            mutate(o).add<mixin_5>().add<mixin_8>();
+        }
+        ++i;
+    }
+}
+
+void churn_default(picobench::state& s)
+{
+    churn(s, nullptr);
+}
+PICOBENCH(churn_default);
+
+void churn_adaptive(picobench::state& s)
+{
+    adaptive_allocator alloc;
+    churn(s, &alloc);
+}
+PICOBENCH(churn_adaptive);
+
+PICOBENCH_SUITE("Mixin calls");
+
+// calls a message of a mixin of many objects, which have other mixins allocated between theirs
+void call_mixins(picobench::state& s, domain_allocator* alloc)
+{
+    object_domain d;
+    if (alloc) d.set_allocator(alloc);
+
+    const int num_objects = 100000;
+    vector<object> objects;
+    objects.reserve(num_objects);
+    for (int i = 0; i < num_objects; ++i)
+    {
+        objects.emplace_back(d);
+        mutate(objects.back()).add<mixin_3>().add<mixin_4>().add<mixin_6>();
+    }
+
+    int i = 0;
+    for (auto _ : s)
+    {
+        message_mixin_3(objects[i % num_objects]);
+        ++i;
+    }
+}
+
+void call_mixins_default(picobench::state& s)
+{
+    call_mixins(s, nullptr);
+}
+PICOBENCH(call_mixins_default);
+
+void call_mixins_adaptive(picobench::state& s)
+{
+    adaptive_allocator alloc;
+    call_mixins(s, &alloc);
+}
+PICOBENCH(call_mixins_adaptive);
+
+PICOBENCH_SUITE("Object copy");
+
+// the same few pairs are synced over and over, so they're in the cache
+const int num_copy_pairs = 16;
+
+void copy_matching(picobench::state& s)
+{
+    auto sources = create_objects(num_copy_pairs);
+    auto targets = create_objects(num_copy_pairs);
+
+    int i = 0;
+    for (auto _ : s)
+    {
+        targets[i % num_copy_pairs].copy_matching_from(sources[i % num_copy_pairs]);
+        ++i;
+    }
+}
+PICOBENCH(copy_matching);
+
+void copy_from_same_type(picobench::state& s)
+{
+    auto sources = create_objects(num_copy_pairs);
+    auto targets = create_objects(num_copy_pairs);
+
+    int i = 0;
+    for (auto _ : s)
+    {
+        targets[i % num_copy_pairs].copy_from(sources[i % num_copy_pairs]);
+        ++i;
+    }
+}
+PICOBENCH(copy_from_same_type);
+
 #include "regression_tester.inl"
 
 int main(int argc, char* argv[])
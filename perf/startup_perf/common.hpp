@@ -0,0 +1,15 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+#include <dynamix/dynamix.hpp>
+
+#define STARTUP_PERF_API extern "C" DYNAMIX_SYMBOL_EXPORT
+
+// adds 5% of the mixins of the module to the object
+typedef void(*startup_perf_use_proc)(dynamix::object*);
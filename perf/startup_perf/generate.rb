@@ -0,0 +1,73 @@
+# DynaMix
+# Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+#
+# Distributed under the MIT Software License
+# See accompanying file LICENSE.txt or copy at
+# https://opensource.org/licenses/MIT
+#
+
+# generates the mixins of the module loaded by the startup performance tests
+
+COMPILE_FILE = 'generated.cpp'
+NUM_MIXINS = 1000 # must be less than DYNAMIX_MAX_MIXINS of dynamix_startup_perf (see perf/CMakeLists.txt)
+NUM_MESSAGES = 10
+
+# the module uses one in USE_STEP mixins (5%)
+USE_STEP = 20
+
+out = <<DATA
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+// this file is automatically generated by a script
+#include "common.hpp"
+using namespace dynamix;
+
+DATA
+
+MESSAGE_ENTRY = <<DATA
+DYNAMIX_MULTICAST_MESSAGE_1(void, message_%{index}, int&, out);
+DYNAMIX_DEFINE_MESSAGE(message_%{index});
+DATA
+
+MIXIN_ENTRY = <<DATA
+
+DYNAMIX_DECLARE_MIXIN(mixin_%{index});
+class mixin_%{index}
+{
+public:
+  void message_%{m1}(int& out) { out += %{index}; }
+  void message_%{m2}(int& out) { out -= %{index}; }
+  int data = %{index};
+};
+DYNAMIX_DEFINE_MIXIN(mixin_%{index}, message_%{m1}_msg & priority(%{index}, message_%{m2}_msg));
+DATA
+
+1.upto(NUM_MESSAGES) do |i|
+  out += MESSAGE_ENTRY % { :index => i }
+end
+
+1.upto(NUM_MIXINS) do |i|
+  params = {
+    :index => i,
+    :m1 => (i % NUM_MESSAGES) + 1,
+    :m2 => ((i + 1) % NUM_MESSAGES) + 1,
+  }
+
+  out += MIXIN_ENTRY % params
+end
+
+out += "\nSTARTUP_PERF_API void startup_perf_use(dynamix::object* o)\n{\n"
+out += "  mutate(o)"
+
+USE_STEP.step(NUM_MIXINS, USE_STEP) do |i|
+  out += "\n    .add<mixin_#{i}>()"
+end
+
+out += ";\n}\n"
+
+File.open(COMPILE_FILE, "w").write(out)
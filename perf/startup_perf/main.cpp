@@ -0,0 +1,119 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// time to load a module with 1000 mixins (which runs its static initialization)
+// and to then use 5% of them
+// the same module is built with the mixins registered during static initialization
+// and with DYNAMIX_LAZY_MIXIN_REGISTRATION
+
+#include "common.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#if defined (_WIN32)
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+typedef HMODULE DynamicLib;
+
+inline DynamicLib LoadDynamicLib(const char* lib)
+{
+    std::string l;
+#if defined(__GNUC__)
+    l = "lib";
+#endif
+    l += lib;
+    l += ".dll";
+    return LoadLibrary(l.c_str());
+}
+
+#define GetProc GetProcAddress
+
+#else
+
+#include <dlfcn.h>
+
+typedef void* DynamicLib;
+
+inline DynamicLib LoadDynamicLib(const char* lib)
+{
+    std::string l = "lib";
+    l += lib;
+#if defined(__APPLE__)
+    l += ".dylib";
+#else
+    l += ".so";
+#endif
+    return dlopen(l.c_str(), RTLD_NOW);
+}
+#define GetProc dlsym
+
+#endif
+
+using namespace dynamix;
+
+typedef std::chrono::steady_clock clock_type;
+
+double ms_since(clock_type::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+// a module can't be reliably unloaded (for example because of unique symbols)
+// so each one is loaded once in a separate process
+int run(const char* name, const char* lib_name)
+{
+    auto start = clock_type::now();
+    auto lib = LoadDynamicLib(lib_name);
+    if (!lib)
+    {
+        printf("can't load %s\n", lib_name);
+        return 1;
+    }
+    double load = ms_since(start);
+
+    auto proc = reinterpret_cast<startup_perf_use_proc>(GetProc(lib, "startup_perf_use"));
+
+    double use;
+    {
+        start = clock_type::now();
+        object o;
+        proc(&o);
+        use = ms_since(start);
+    }
+
+    printf("| %-12s | %9.3f | %9.3f | %9.3f |\n", name, load, use, load + use);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        std::string mode = argv[1];
+        if (mode == "eager") return run("static init", "startup_perf_eager");
+        if (mode == "lazy") return run("lazy", "startup_perf_lazy");
+        printf("unknown mode %s\n", argv[1]);
+        return 1;
+    }
+
+    printf("Load a module with 1000 mixins and use 50 of them\n\n");
+    printf("| registration |  load ms  |  use ms   | total ms  |\n");
+    printf("|--------------|-----------|-----------|-----------|\n");
+    fflush(stdout);
+
+    std::string self = argv[0];
+    if (std::system((self + " eager").c_str()) != 0) return 1;
+    if (std::system((self + " lazy").c_str()) != 0) return 1;
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// message calls over objects of more than 100k different types
+// with the type infos allocated with new, from an arena, and from a huge page arena
+// (in the latter two cases the mixins are allocated from an arena of the same kind)
+//
+// with the default limits a type info is ~42k so DynaMix for this test is built with
+// DYNAMIX_MAX_MIXINS and DYNAMIX_MAX_MESSAGES of 64
+// each mode runs in a separate process so that it starts with a clean heap
+
+#include <dynamix/dynamix.hpp>
+#include <dynamix/memory_arena.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dynamix;
+
+DYNAMIX_MESSAGE_0(int, top);
+DYNAMIX_MULTICAST_MESSAGE_1(void, accumulate, int&, sum);
+
+// mixins with different priorities for top, so that there are no clashes
+#define TYPE_ARENA_PERF_MIXINS(X) \
+    X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) \
+    X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16)
+
+const int NUM_MIXINS = 17;
+
+#define DECLARE_PERF_MIXIN(i) \
+    DYNAMIX_DECLARE_MIXIN(m##i); \
+    class m##i \
+    { \
+    public: \
+        int top() { return value; } \
+        void accumulate(int& sum) { sum += value; } \
+        int value = i; \
+    };
+
+TYPE_ARENA_PERF_MIXINS(DECLARE_PERF_MIXIN)
+
+namespace
+{
+
+typedef std::chrono::steady_clock clock_type;
+
+double ms_since(clock_type::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+const size_t NUM_TYPES = 120000;
+const int NUM_PASSES = 10;
+
+mixin_id id_of(const mixin_type_info& info)
+{
+    return info.id;
+}
+
+int run(const char* name, bool arena, bool huge_pages)
+{
+    std::vector<mixin_id> ids;
+#define PERF_MIXIN_ID(i) ids.push_back(id_of(_dynamix_get_mixin_type_info(static_cast<m##i*>(nullptr))));
+    TYPE_ARENA_PERF_MIXINS(PERF_MIXIN_ID)
+
+    std::unique_ptr<arena_allocator> alloc;
+    object_domain d;
+    if (arena)
+    {
+        d.use_type_info_arena(huge_pages);
+        alloc.reset(new arena_allocator(memory_arena::HUGE_PAGE_SIZE, huge_pages));
+        d.set_allocator(alloc.get());
+    }
+
+    auto start = clock_type::now();
+
+    // an object per type
+    // the type of object k has the mixins which correspond to the set bits of k + 1
+    std::vector<object> objects;
+    objects.reserve(NUM_TYPES);
+    for (size_t k = 0; k < NUM_TYPES; ++k)
+    {
+        objects.emplace_back(d);
+        single_object_mutator mutator(objects.back());
+        for (int b = 0; b < NUM_MIXINS; ++b)
+        {
+            if ((k + 1) & (size_t(1) << b)) mutator.add(ids[b]);
+        }
+    }
+
+    double create = ms_since(start);
+
+    // visit them in a random order, as an unsorted scene would
+    std::vector<object*> order;
+    for (auto& o : objects) order.push_back(&o);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    int sum = 0;
+    start = clock_type::now();
+    for (int pass = 0; pass < NUM_PASSES; ++pass)
+    {
+        for (auto o : order)
+        {
+            sum += top(*o);
+            accumulate(*o, sum);
+        }
+    }
+    double dispatch = ms_since(start);
+    double ns_per_object = dispatch * 1000000 / (NUM_PASSES * NUM_TYPES);
+
+    printf("| %-18s | %9.1f | %11.1f | %13.1f | %d\n", name, create, dispatch, ns_per_object, sum);
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        std::string mode = argv[1];
+        if (mode == "new") return run("new", false, false);
+        if (mode == "arena") return run("arena", true, false);
+        if (mode == "huge") return run("huge page arena", true, true);
+        printf("unknown mode %s\n", argv[1]);
+        return 1;
+    }
+
+    printf("%d passes over %d objects of different types with a unicast and a multicast message\n\n", NUM_PASSES, int(NUM_TYPES));
+    printf("| type infos         | create ms | dispatch ms | ns per object | (checksum)\n");
+    printf("|--------------------|-----------|-------------|---------------|\n");
+    fflush(stdout);
+
+    std::string self = argv[0];
+    for (auto mode : {" new", " arena", " huge"})
+    {
+        if (std::system((self + mode).c_str()) != 0) return 1;
+    }
+
+    return 0;
+}
+
+#define DEFINE_PERF_MIXIN(i) DYNAMIX_DEFINE_MIXIN(m##i, priority(i, top_msg) & accumulate_msg);
+TYPE_ARENA_PERF_MIXINS(DEFINE_PERF_MIXIN)
+
+DYNAMIX_DEFINE_MESSAGE(top);
+DYNAMIX_DEFINE_MESSAGE(accumulate);
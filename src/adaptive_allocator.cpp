@@ -0,0 +1,316 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/adaptive_allocator.hpp"
+#include "dynamix/mixin_type_info.hpp"
+#include "dynamix/object.hpp"
+#include "dynamix/object_domain.hpp"
+#include "dynamix/object_type_info.hpp"
+
+#include <algorithm>
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+#   define I_DYNAMIX_ADAPTIVE_LOCK() std::lock_guard<std::mutex> lock(_mutex)
+#else
+#   define I_DYNAMIX_ADAPTIVE_LOCK()
+#endif
+
+namespace dynamix
+{
+
+const size_t adaptive_allocator::MAX_DECISIONS;
+
+namespace
+{
+// the allocation rate of mixins on the heap is checked once per this many allocations
+// so most allocations don't read the clock
+const size_t rate_check_period = 64;
+}
+
+adaptive_allocator::adaptive_allocator()
+    : adaptive_allocator(policy())
+{}
+
+adaptive_allocator::adaptive_allocator(const policy& p)
+    : _policy(p)
+{
+    I_DYNAMIX_ASSERT(_policy.heap_population < _policy.pool_population);
+    I_DYNAMIX_ASSERT(_policy.first_chunk_slots);
+}
+
+adaptive_allocator::~adaptive_allocator()
+{
+    for (auto& state : _states)
+    {
+        if (!state) continue;
+        I_DYNAMIX_ASSERT_MSG(!state->pooled, "objects with pooled mixins outlive their allocator");
+        release_pool(*state);
+    }
+}
+
+char* adaptive_allocator::alloc_mixin_data(size_t count, const object*)
+{
+#if DYNAMIX_DEBUG
+    _has_allocated.store(true, std::memory_order_relaxed);
+#endif
+    return new char[mixin_data_size * count];
+}
+
+void adaptive_allocator::dealloc_mixin_data(char* ptr, size_t, const object*)
+{
+    delete[] ptr;
+}
+
+std::pair<char*, size_t> adaptive_allocator::alloc_mixin(const mixin_type_info& info, const object*)
+{
+#if DYNAMIX_DEBUG
+    _has_allocated.store(true, std::memory_order_relaxed);
+#endif
+
+    I_DYNAMIX_ADAPTIVE_LOCK();
+
+    auto& state = state_for(info);
+    ++state.population;
+    ++state.window_allocations;
+
+    if (state.current == strategy::heap)
+    {
+        if (state.population >= _policy.pool_population)
+        {
+            switch_to(info.id, state, strategy::pool);
+        }
+        else if (_policy.pool_allocation_rate && state.window_allocations % rate_check_period == 0)
+        {
+            update_rate(state, std::chrono::steady_clock::now());
+            if (state.allocation_rate >= _policy.pool_allocation_rate)
+            {
+                switch_to(info.id, state, strategy::pool);
+            }
+        }
+    }
+
+    auto buffer = allocate(state);
+    return std::make_pair(buffer, mixin_offset(buffer, info.alignment));
+}
+
+void adaptive_allocator::dealloc_mixin(char* ptr, size_t, const mixin_type_info& info, const object*)
+{
+    I_DYNAMIX_ADAPTIVE_LOCK();
+
+    auto& state = *_states[info.id];
+    I_DYNAMIX_ASSERT(state.population);
+    --state.population;
+
+    deallocate(state, ptr);
+
+    if (state.current == strategy::pool && state.population <= _policy.heap_population)
+    {
+        bool rare = true;
+        if (_policy.pool_allocation_rate)
+        {
+            update_rate(state, std::chrono::steady_clock::now());
+            rare = state.allocation_rate < _policy.pool_allocation_rate / 2;
+        }
+
+        if (rare)
+        {
+            switch_to(info.id, state, strategy::heap);
+        }
+    }
+}
+
+adaptive_allocator::strategy adaptive_allocator::strategy_of(mixin_id id) const
+{
+    I_DYNAMIX_ADAPTIVE_LOCK();
+    auto state = find_state(id);
+    return state ? state->current : strategy::heap;
+}
+
+adaptive_allocator::mixin_stats adaptive_allocator::stats(mixin_id id) const
+{
+    I_DYNAMIX_ADAPTIVE_LOCK();
+
+    mixin_stats ret;
+    auto state = find_state(id);
+    if (!state) return ret;
+
+    ret.current = state->current;
+    ret.population = state->population;
+    ret.pooled = state->pooled;
+    ret.pool_capacity = state->pool_capacity;
+    ret.allocation_rate = state->allocation_rate;
+    ret.num_switches = state->num_switches;
+    return ret;
+}
+
+std::vector<adaptive_allocator::decision> adaptive_allocator::decisions() const
+{
+    I_DYNAMIX_ADAPTIVE_LOCK();
+    return std::vector<decision>(_decisions.begin(), _decisions.end());
+}
+
+#if DYNAMIX_OBJECT_REPLACE_MIXIN
+size_t adaptive_allocator::migrate(object& obj)
+{
+    size_t ret = 0;
+    const auto& type = obj.type_info();
+
+    for (const mixin_type_info* info : type._compact_mixins)
+    {
+        mixin_allocator* alloc = obj.allocator() ? obj.allocator() : obj.domain().mixin_allocator_for(*info);
+        if (alloc != this || !info->move_constructor) continue;
+
+        const auto& data = obj._mixin_data[type.mixin_index(info->id)];
+
+        char* new_buffer;
+        {
+            I_DYNAMIX_ADAPTIVE_LOCK();
+            auto& state = *_states[info->id];
+            const bool pooled = owns_slot(state, data.buffer());
+            if (pooled == (state.current == strategy::pool)) continue;
+            new_buffer = allocate(state);
+        }
+
+        // the move constructor is called without holding the lock
+        // as it may allocate mixins of other objects
+        auto old = obj.move_mixin(info->id, new_buffer, mixin_offset(new_buffer, info->alignment));
+        destroy_mixin(*info, old.first + old.second);
+
+        {
+            I_DYNAMIX_ADAPTIVE_LOCK();
+            deallocate(*_states[info->id], old.first);
+        }
+
+        ++ret;
+    }
+
+    return ret;
+}
+#endif
+
+adaptive_allocator::mixin_state& adaptive_allocator::state_for(const mixin_type_info& info)
+{
+    auto& state = _states[info.id];
+    if (!state)
+    {
+        state.reset(new mixin_state);
+        state->slot_size = mem_size_for_mixin(info.size, info.alignment);
+        state->window_start = std::chrono::steady_clock::now();
+    }
+    return *state;
+}
+
+const adaptive_allocator::mixin_state* adaptive_allocator::find_state(mixin_id id) const
+{
+    I_DYNAMIX_ASSERT(id < DYNAMIX_MAX_MIXINS);
+    return _states[id].get();
+}
+
+void adaptive_allocator::update_rate(mixin_state& state, std::chrono::steady_clock::time_point now)
+{
+    auto elapsed = now - state.window_start;
+    if (elapsed < _policy.rate_window) return;
+
+    // a zero window (as in tests) may end in the same tick as it started
+    auto ns = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), decltype(elapsed.count())(1));
+    state.allocation_rate = size_t(double(state.window_allocations) * 1e9 / double(ns));
+    state.window_allocations = 0;
+    state.window_start = now;
+}
+
+void adaptive_allocator::switch_to(mixin_id id, mixin_state& state, strategy s)
+{
+    I_DYNAMIX_ASSERT(state.current != s);
+    state.current = s;
+    ++state.num_switches;
+
+    if (_decisions.size() == MAX_DECISIONS) _decisions.pop_front();
+    _decisions.push_back({id, s, state.population, state.allocation_rate});
+
+    if (s == strategy::heap && !state.pooled)
+    {
+        release_pool(state);
+    }
+}
+
+char* adaptive_allocator::allocate(mixin_state& state)
+{
+    if (state.current == strategy::heap)
+    {
+        return new char[state.slot_size];
+    }
+
+    if (!state.free_slots)
+    {
+        // each chunk doubles the capacity
+        chunk c;
+        c.num_slots = state.pool_capacity ? state.pool_capacity : _policy.first_chunk_slots;
+        c.memory = new char[c.num_slots * state.slot_size];
+
+        // link the slots in order of their addresses, so they're allocated in it
+        for (size_t i = c.num_slots; i-- > 0; )
+        {
+            char* slot = c.memory + i * state.slot_size;
+            *reinterpret_cast<char**>(slot) = state.free_slots;
+            state.free_slots = slot;
+        }
+
+        auto pos = std::upper_bound(state.chunks.begin(), state.chunks.end(), c.memory,
+            [](const char* mem, const chunk& ch) { return mem < ch.memory; });
+        state.chunks.insert(pos, c);
+        state.pool_capacity += c.num_slots;
+    }
+
+    char* ret = state.free_slots;
+    state.free_slots = *reinterpret_cast<char**>(ret);
+    ++state.pooled;
+    return ret;
+}
+
+void adaptive_allocator::deallocate(mixin_state& state, char* ptr)
+{
+    if (!owns_slot(state, ptr))
+    {
+        delete[] ptr;
+        return;
+    }
+
+    I_DYNAMIX_ASSERT(state.pooled);
+    --state.pooled;
+    *reinterpret_cast<char**>(ptr) = state.free_slots;
+    state.free_slots = ptr;
+
+    if (state.current == strategy::heap && !state.pooled)
+    {
+        release_pool(state);
+    }
+}
+
+bool adaptive_allocator::owns_slot(const mixin_state& state, const char* ptr) const
+{
+    // the last chunk which starts at or before the pointer
+    auto pos = std::upper_bound(state.chunks.begin(), state.chunks.end(), ptr,
+        [](const char* p, const chunk& ch) { return p < ch.memory; });
+    if (pos == state.chunks.begin()) return false;
+    --pos;
+    return ptr < pos->memory + pos->num_slots * state.slot_size;
+}
+
+void adaptive_allocator::release_pool(mixin_state& state)
+{
+    I_DYNAMIX_ASSERT(!state.pooled);
+    for (auto& c : state.chunks)
+    {
+        delete[] c.memory;
+    }
+    state.chunks.clear();
+    state.pool_capacity = 0;
+    state.free_slots = nullptr;
+}
+
+} // namespace dynamix
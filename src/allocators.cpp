@@ -37,6 +37,12 @@ void mixin_allocator::destroy_mixin(const mixin_type_info& info, void* ptr) noex
     info.destructor(ptr);
 }
 
+bool mixin_allocator::can_reuse_mixin_buffer(const mixin_type_info&, const mixin_type_info&) const
+{
+    // buffers may come from per-mixin pools
+    return false;
+}
+
 void object_allocator::on_set_to_object(object&)
 {}
 
@@ -100,6 +106,13 @@ void default_allocator::dealloc_mixin(char* ptr, size_t, const mixin_type_info&,
     delete[] ptr;
 }
 
+bool default_allocator::can_reuse_mixin_buffer(const mixin_type_info& freed, const mixin_type_info& needed) const
+{
+    // the same alignment means the same mixin offset in the buffer
+    return freed.alignment == needed.alignment
+        && mem_size_for_mixin(freed.size, freed.alignment) == mem_size_for_mixin(needed.size, needed.alignment);
+}
+
 } // namespace internal
 
 } // namespace dynamix
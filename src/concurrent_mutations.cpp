@@ -0,0 +1,284 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/concurrent_mutations.hpp"
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+
+#include "concurrent_mutations.hpp"
+#include "dynamix/allocators.hpp"
+#include "dynamix/mixin_type_info.hpp"
+#include "dynamix/trace.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dynamix
+{
+
+namespace
+{
+
+// epochs start from 1, since 0 in a record means that the thread is not reading
+// an item retired in epoch E can be destroyed when the global epoch reaches E + 2
+// the global epoch is only advanced when all active readers have entered the current one
+// thus by then all readers which were active at the time of the retirement have finished
+
+struct retired_mixin
+{
+    uint64_t epoch;
+    const mixin_type_info* info;
+    mixin_allocator* alloc;
+    char* buffer;
+    size_t mixin_offset;
+    const object* obj;
+
+    void destroy() const
+    {
+        {
+            I_DYNAMIX_TRACE_SCOPE("destroy_mixin", "mutation", info->name);
+            alloc->destroy_mixin(*info, buffer + mixin_offset);
+        }
+
+        {
+            I_DYNAMIX_TRACE_SCOPE("dealloc_mixin", "allocator", info->name);
+            alloc->dealloc_mixin(buffer, mixin_offset, *info, obj);
+        }
+    }
+};
+
+struct retired_mixin_data
+{
+    uint64_t epoch;
+    char* memory;
+    size_t count;
+    domain_allocator* alloc;
+    const object* obj;
+
+    void destroy() const
+    {
+        I_DYNAMIX_TRACE_SCOPE("dealloc_mixin_data", "allocator");
+        // mixin data elements are trivially destructible
+        alloc->dealloc_mixin_data(memory, count, obj);
+    }
+};
+
+struct thread_record
+{
+    internal::epoch_record record;
+    bool in_use;
+};
+
+class reclaimer
+{
+public:
+    static reclaimer& instance()
+    {
+        static reclaimer r;
+        return r;
+    }
+
+    std::atomic<uint64_t> epoch = {1};
+
+    internal::epoch_record* acquire()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto& r : _records)
+        {
+            if (!r->in_use)
+            {
+                r->in_use = true;
+                return &r->record;
+            }
+        }
+
+        _records.emplace_back(new thread_record);
+        auto& r = *_records.back();
+        r.record.epoch.store(0, std::memory_order_relaxed);
+        r.record.depth = 0;
+        r.in_use = true;
+        return &r.record;
+    }
+
+    void release(internal::epoch_record* record)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        I_DYNAMIX_ASSERT(record->depth == 0);
+        // the record is the first member
+        reinterpret_cast<thread_record*>(record)->in_use = false;
+    }
+
+    void retire(const retired_mixin& m)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _mixins.push_back(m);
+        _mixins.back().epoch = epoch.load();
+    }
+
+    void retire(const retired_mixin_data& d)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _mixin_datas.push_back(d);
+        _mixin_datas.back().epoch = epoch.load();
+    }
+
+    size_t reclaim()
+    {
+        std::vector<retired_mixin> mixins;
+        std::vector<retired_mixin_data> datas;
+        size_t remaining;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_mixins.empty() && _mixin_datas.empty()) return 0;
+
+            // if there are no readers, two advances free everything
+            if (try_advance()) try_advance();
+            auto e = epoch.load();
+
+            // move the ones which can be destroyed out, so they're destroyed outside of the lock
+            // a mixin destructor may mutate other objects
+            extract(_mixins, mixins, e);
+            extract(_mixin_datas, datas, e);
+            remaining = _mixins.size() + _mixin_datas.size();
+        }
+
+        for (auto& m : mixins) m.destroy();
+        for (auto& d : datas) d.destroy();
+
+        return remaining;
+    }
+
+    void reclaim_all() noexcept
+    {
+        std::vector<retired_mixin> mixins;
+        std::vector<retired_mixin_data> datas;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            mixins.swap(_mixins);
+            datas.swap(_mixin_datas);
+        }
+
+        for (auto& m : mixins) m.destroy();
+        for (auto& d : datas) d.destroy();
+    }
+
+private:
+    reclaimer() = default;
+
+    // advances the global epoch if all active readers have entered the current one
+    bool try_advance()
+    {
+        // pairs with the fence in enter_epoch
+        // either we see the reader's epoch, or it sees the newly published mixin data
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto e = epoch.load();
+        for (auto& r : _records)
+        {
+            auto re = r->record.epoch.load();
+            if (re != 0 && re != e) return false;
+        }
+
+        epoch.store(e + 1);
+        return true;
+    }
+
+    template <typename Item>
+    static void extract(std::vector<Item>& from, std::vector<Item>& to, uint64_t e)
+    {
+        auto keep = from.begin();
+        for (auto& item : from)
+        {
+            if (item.epoch + 2 <= e)
+            {
+                to.push_back(item);
+            }
+            else
+            {
+                *keep++ = item;
+            }
+        }
+        from.erase(keep, from.end());
+    }
+
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<thread_record>> _records;
+    std::vector<retired_mixin> _mixins;
+    std::vector<retired_mixin_data> _mixin_datas;
+};
+
+// releases the records acquired by a thread when it exits
+class thread_records
+{
+public:
+    ~thread_records()
+    {
+        for (auto r : records)
+        {
+            reclaimer::instance().release(r);
+        }
+    }
+
+    std::vector<internal::epoch_record*> records;
+};
+
+thread_local thread_records the_thread_records;
+
+} // namespace
+
+namespace internal
+{
+
+epoch_record* acquire_epoch_record()
+{
+    auto r = reclaimer::instance().acquire();
+    the_thread_records.records.push_back(r);
+    return r;
+}
+
+void enter_epoch(epoch_record& record) noexcept
+{
+    record.epoch.store(reclaimer::instance().epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    // the epoch must be visible before the reader loads any object data
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void retire_mixin(const mixin_type_info& info, mixin_allocator* alloc, char* buffer, size_t mixin_offset, const object* obj)
+{
+    reclaimer::instance().retire(retired_mixin{0, &info, alloc, buffer, mixin_offset, obj});
+}
+
+void retire_mixin_data(char* memory, size_t count, domain_allocator* alloc, const object* obj)
+{
+    reclaimer::instance().retire(retired_mixin_data{0, memory, count, alloc, obj});
+}
+
+void reclaim_all() noexcept
+{
+    reclaimer::instance().reclaim_all();
+}
+
+void init_reclamation()
+{
+    reclaimer::instance();
+}
+
+} // namespace internal
+
+size_t reclaim()
+{
+    return reclaimer::instance().reclaim();
+}
+
+} // namespace dynamix
+
+#endif // DYNAMIX_CONCURRENT_MUTATIONS
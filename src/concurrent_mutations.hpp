@@ -0,0 +1,42 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+// internal hooks of the epoch based reclamation
+// only used when DYNAMIX_CONCURRENT_MUTATIONS is enabled
+
+#include <cstddef>
+
+namespace dynamix
+{
+
+class object;
+class mixin_type_info;
+class mixin_allocator;
+class domain_allocator;
+
+namespace internal
+{
+
+// the retire functions must be called after the object has published its new mixin data
+// the memory is destroyed and deallocated when no reader can see it
+// the object pointers are passed to the allocators but they may be dangling by then
+
+void retire_mixin(const mixin_type_info& info, mixin_allocator* alloc, char* buffer, size_t mixin_offset, const object* obj);
+void retire_mixin_data(char* memory, size_t count, domain_allocator* alloc, const object* obj);
+
+// destroys everything regardless of readers
+// called when the domain is destroyed
+void reclaim_all() noexcept;
+
+// creates the reclamation data
+// called by the domain so that it's destroyed after it
+void init_reclamation();
+
+}
+}
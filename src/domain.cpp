@@ -7,13 +7,17 @@
 //
 #include "internal.hpp"
 #include "dynamix/domain.hpp"
+#include "dynamix/object_domain.hpp"
 #include "zero_memory.hpp"
 #include "dynamix/object_type_info.hpp"
 #include "dynamix/mutation_rule.hpp"
+#include "dynamix/object_type_mutation.hpp"
 #include "dynamix/allocators.hpp"
 #include "dynamix/internal/mixin_traits.hpp"
 #include "dynamix/features.hpp"
 #include "dynamix/type_class.hpp"
+#include "dynamix/trace.hpp"
+#include "concurrent_mutations.hpp"
 
 #include <algorithm>
 
@@ -43,13 +47,34 @@ const domain& domain::instance()
 domain::domain()
     : _num_registered_mixins(0)
     , _num_registered_messages(0)
+    , _num_registered_facts(0)
     , _allocator(&the_default_allocator)
 {
     zero_memory(_mixin_type_infos, sizeof(_mixin_type_infos));
     zero_memory(_messages, sizeof(_messages));
+    zero_memory(_facts, sizeof(_facts));
+
+    // lazily registered mixins can be registered while other threads mutate objects
+    // so make sure this never reallocates
+    _mixins_with_siblings.reserve(DYNAMIX_MAX_MIXINS);
+
+    _global_object_domain.reset(new object_domain(object_domain::global_tag()));
+    _object_domains.push_back(_global_object_domain.get());
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // make sure it outlives us
+    init_reclamation();
+#endif
 }
 
-domain::~domain() = default;
+domain::~domain()
+{
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // objects which were mutated may still have mixins waiting for readers
+    // there can be no readers at this point and the mixin infos are still alive
+    reclaim_all();
+#endif
+}
 
 mutation_rule_id domain::add_mutation_rule(mutation_rule* rule)
 {
@@ -59,105 +84,54 @@ mutation_rule_id domain::add_mutation_rule(mutation_rule* rule)
 
 mutation_rule_id domain::add_mutation_rule(std::shared_ptr<mutation_rule> rule)
 {
-#if DYNAMIX_THREAD_SAFE_MUTATIONS
-    std::lock_guard<std::mutex> lock(_mutation_rules_mutex);
-#endif
-
-    // find free slot
-    for (mutation_rule_id i = 0; i < _mutation_rules.size(); ++i)
-    {
-        auto& r = _mutation_rules[i];
-        if (!r)
-        {
-            r = rule;
-            return i;
-        }
-    }
-
-    _mutation_rules.emplace_back(std::move(rule));
-    return _mutation_rules.size() - 1;
+    return _global_object_domain->add_mutation_rule(std::move(rule));
 }
 
 std::shared_ptr<mutation_rule> domain::remove_mutation_rule(mutation_rule_id id)
 {
-#if DYNAMIX_THREAD_SAFE_MUTATIONS
-    std::lock_guard<std::mutex> lock(_mutation_rules_mutex);
-#endif
-
-    if (id >= _mutation_rules.size()) return std::shared_ptr<mutation_rule>();
-
-    auto ret = _mutation_rules[id];
-    _mutation_rules[id].reset();
-    return ret;
-}
-
-void domain::apply_mutation_rules(object_type_mutation& mutation, const mixin_collection& source_mixins)
-{
-#if DYNAMIX_THREAD_SAFE_MUTATIONS
-    std::lock_guard<std::mutex> lock(_mutation_rules_mutex);
-#endif
-
-    for (auto& rule : _mutation_rules)
-    {
-        if (rule)
-        {
-            rule->apply_to(mutation, source_mixins);
-        }
-    }
+    return _global_object_domain->remove_mutation_rule(id);
 }
 
-const object_type_info* domain::get_object_type_info(mixin_collection mixins)
+void domain::apply_sibling_requirements(object_type_mutation& mutation, const mixin_collection& source_mixins) const
 {
-    // the mixin type infos need to be sorted
-    // so as to guarantee that two object type infos of the same mixins
-    // will have the exact same content
-    I_DYNAMIX_ASSERT(std::is_sorted(mixins._compact_mixins.begin(), mixins._compact_mixins.end()));
-
 #if DYNAMIX_THREAD_SAFE_MUTATIONS
-    // TODO C++17: do this with a shared mutex instead
-    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+    // a mixin with siblings may be registered lazily in another thread
+    // when there are no lazy mixins left, the list doesn't change
+    std::unique_lock<std::recursive_mutex> lock(_lazy_mixins_mutex, std::defer_lock);
+    if (_num_unregistered_lazy_mixins) lock.lock();
 #endif
 
-    object_type_info_map::iterator it = _object_type_infos.find(mixins._mixins);
-
-    if(it != _object_type_infos.end())
+    // added siblings may have required siblings of their own
+    // so repeat until there are no changes
+    bool changed;
+    do
     {
-        // get existing
-        I_DYNAMIX_ASSERT(mixins._compact_mixins == it->second->_compact_mixins);
-        return it->second.get();
-    }
-    else
-    {
-        // create object type info
-        // use unique_ptr since fill_call_table might throw
-        std::unique_ptr<object_type_info> new_type(new object_type_info);
-        new_type->_mixins = mixins._mixins;
-
-        uint32_t index = 0;
-        for(auto info : mixins._compact_mixins)
+        changed = false;
+        for (auto info : _mixins_with_siblings)
         {
-            I_DYNAMIX_ASSERT(info);
-            new_type->_mixin_indices[info->id] = index + object_type_info::MIXIN_INDEX_OFFSET;
-            ++index;
-        }
-
-        new_type->_compact_mixins = std::move(mixins._compact_mixins);
+            bool will_have = mutation.is_adding(info->id)
+                || (source_mixins.has(info->id) && !mutation.is_removing(info->id));
+            if (!will_have) continue;
 
-        new_type->fill_call_table();
-
-        // add matching type classes
-        for (auto tc : _type_classes)
-        {
-            if (tc && tc->matches(*new_type))
+            for (auto& link : info->required_siblings)
             {
-                new_type->_matching_type_classes.emplace_back(tc->id());
+                auto sibling_id = link.sibling->id;
+                I_DYNAMIX_ASSERT_MSG(sibling_id != INVALID_MIXIN_ID, "required sibling is not registered");
+
+                if (mutation.is_removing(sibling_id))
+                {
+                    // keep the sibling
+                    mutation.stop_removing(sibling_id);
+                    changed = true;
+                }
+                else if (!source_mixins.has(sibling_id) && !mutation.is_adding(sibling_id))
+                {
+                    mutation.start_adding(sibling_id);
+                    changed = true;
+                }
             }
         }
-
-        auto ret = new_type.get();
-        _object_type_infos.emplace(make_pair(std::move(mixins._mixins), std::move(new_type)));
-        return ret;
-    }
+    } while (changed);
 }
 
 void domain::register_feature(message_t& m)
@@ -227,6 +201,7 @@ void domain::register_feature(message_t& m)
     }
 
     _messages[m.id] = &m;
+    ++_messages_version;
 }
 
 void domain::unregister_feature(const message_t& msg)
@@ -236,6 +211,7 @@ void domain::unregister_feature(const message_t& msg)
     I_DYNAMIX_ASSERT_MSG(_messages[msg.id] == &msg, "unregistering a message with know id but unknown data");
 
     _messages[msg.id] = nullptr;
+    ++_messages_version;
 
     // to be pedantic we should clear all type infos which have this message,
     // but this seems to be unnecessary
@@ -247,6 +223,58 @@ void domain::unregister_feature(const message_t& msg)
     // will be dropped
 }
 
+void domain::register_feature(fact_t& f)
+{
+    // registered by every mixin which provides it
+    if (f.id != INVALID_FEATURE_ID)
+    {
+        return;
+    }
+
+    feature_id free = INVALID_FEATURE_ID;
+
+    for (size_t i = 0; i < _num_registered_facts; ++i)
+    {
+        if (!_facts[i])
+        {
+            free = i;
+            continue;
+        }
+
+        if (strcmp(f.name, _facts[i]->name) == 0)
+        {
+            I_DYNAMIX_ASSERT_MSG(false, "Attempting to register a fact that has already been registered");
+            f.id = _facts[i]->id;
+            return;
+        }
+    }
+
+    if (free == INVALID_FEATURE_ID)
+    {
+        I_DYNAMIX_ASSERT_MSG(_num_registered_facts < DYNAMIX_MAX_FACTS,
+            "you have to increase the maximum number of facts");
+
+        f.id = _num_registered_facts;
+        ++_num_registered_facts;
+    }
+    else
+    {
+        f.id = free;
+    }
+
+    _facts[f.id] = &f;
+}
+
+void domain::unregister_feature(const fact_t& f)
+{
+    I_DYNAMIX_ASSERT_MSG(f.id < _num_registered_facts, "unregistering a fact which isn't registered");
+    I_DYNAMIX_ASSERT_MSG(_facts[f.id] == &f, "unregistering a fact with known id but unknown data");
+
+    // as with messages, the types which have this fact are dropped
+    // when the mixins which provide it are unregistered
+    _facts[f.id] = nullptr;
+}
+
 void domain::register_mixin_type(mixin_type_info& info)
 {
     // mixin is already registered?
@@ -295,7 +323,28 @@ void domain::register_mixin_type(mixin_type_info& info)
         info.allocator = _allocator;
     }
 
+    if (!info.required_siblings.empty())
+    {
+        for (auto& link : info.required_siblings)
+        {
+            uint32_t id = 0;
+            while (id < _num_sibling_links && _used_sibling_links[id]) ++id;
+
+            if (id == _num_sibling_links)
+            {
+                I_DYNAMIX_ASSERT_MSG(_num_sibling_links < DYNAMIX_MAX_SIBLING_LINKS,
+                    "you have to increase the maximum number of sibling links");
+                ++_num_sibling_links;
+            }
+
+            _used_sibling_links[id] = true;
+            link.id = id;
+        }
+        _mixins_with_siblings.push_back(&info);
+    }
+
     _mixin_type_infos[info.id] = &info;
+    info.registered.store(true, std::memory_order_release);
 }
 
 void domain::unregister_mixin_type(const mixin_type_info& info)
@@ -312,29 +361,95 @@ void domain::unregister_mixin_type(const mixin_type_info& info)
 #endif
 
     _mixin_type_infos[info.id] = nullptr;
+    const_cast<mixin_type_info&>(info).registered = false;
+
+    auto with_siblings = std::find(_mixins_with_siblings.begin(), _mixins_with_siblings.end(), &info);
+    if (with_siblings != _mixins_with_siblings.end())
+    {
+        _mixins_with_siblings.erase(with_siblings);
+
+        for (auto& link : info.required_siblings)
+        {
+            _used_sibling_links[link.id] = false;
+        }
+    }
 
     // since this mixin is no longer valid
     // clean up all object type infos which reference it
 
+    std::vector<object_domain*> object_domains;
+    {
 #if DYNAMIX_THREAD_SAFE_MUTATIONS
-    // TODO C++17: do this with a shared mutex instead
-    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+        std::lock_guard<std::mutex> lock(_registry_mutex);
 #endif
+        object_domains = _object_domains;
+    }
 
-    for (auto i = _object_type_infos.begin(); i != _object_type_infos.end(); )
+    for (auto od : object_domains)
     {
-        if (i->first[info.id])
-        {
-            // uh-oh there are still objects alive with this mixin? this is not supported
-            // I wish I could keep this assertion but it keeps firing on abnormal app termination
-            // we do support unregister with living objects if we're terminating
-            // I_DYNAMIX_ASSERT(i->second->num_objects == 0);
-            i = _object_type_infos.erase(i);
-        }
-        else
-        {
-            ++i;
-        }
+        od->drop_type_infos(info.id);
+    }
+}
+
+void domain::add_lazy_mixin(mixin_type_info& info)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::recursive_mutex> lock(_lazy_mixins_mutex);
+#endif
+
+    I_DYNAMIX_ASSERT(info.lazy_registrator);
+    _lazy_mixins.push_back(&info);
+    ++_num_unregistered_lazy_mixins;
+}
+
+void domain::remove_lazy_mixin(const mixin_type_info& info)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::recursive_mutex> lock(_lazy_mixins_mutex);
+#endif
+
+    auto f = std::find(_lazy_mixins.begin(), _lazy_mixins.end(), &info);
+    I_DYNAMIX_ASSERT_MSG(f != _lazy_mixins.end(), "removing a lazy mixin which isn't added");
+    _lazy_mixins.erase(f);
+
+    if (!info.registered)
+    {
+        --_num_unregistered_lazy_mixins;
+    }
+}
+
+void domain::register_lazy_mixin(mixin_type_info& info)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::recursive_mutex> lock(_lazy_mixins_mutex);
+#endif
+
+    // another thread could have registered it while we were waiting
+    if (info.registered) return;
+
+    // the registrator is null while the mixin is being registered in this thread
+    // (mixins which require each other as siblings get here recursively)
+    // the info is complete enough to be referenced as a sibling
+    auto registrator = info.lazy_registrator;
+    if (!registrator) return;
+    info.lazy_registrator = nullptr;
+
+    I_DYNAMIX_TRACE_SCOPE("register_lazy_mixin", "type");
+
+    registrator();
+    --_num_unregistered_lazy_mixins;
+}
+
+void domain::register_all_lazy_mixins()
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::recursive_mutex> lock(_lazy_mixins_mutex);
+#endif
+
+    // registering a mixin doesn't change the vector
+    for (auto info : _lazy_mixins)
+    {
+        register_lazy_mixin(*info);
     }
 }
 
@@ -361,16 +476,30 @@ void domain::set_allocator(domain_allocator* allocator)
 
 mixin_id domain::get_mixin_id_by_name(const char* mixin_name) const
 {
-    for(size_t i=0; i<_num_registered_mixins; ++i)
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    // mixins may be registered lazily in other threads while we're searching
+    std::lock_guard<std::recursive_mutex> lock(_lazy_mixins_mutex);
+#endif
+
+    // a second pass is made if there are lazily registered mixins which haven't been used yet
+    for (int pass = 0; pass < 2; ++pass)
     {
-        const mixin_type_info* registered = _mixin_type_infos[i];
+        for(size_t i=0; i<_num_registered_mixins; ++i)
+        {
+            const mixin_type_info* registered = _mixin_type_infos[i];
 
-        if (!registered) continue;
+            if (!registered) continue;
 
-        if(strcmp(mixin_name, registered->name) == 0)
-        {
-            return registered->id;
+            if(strcmp(mixin_name, registered->name) == 0)
+            {
+                return registered->id;
+            }
         }
+
+        if (!_num_unregistered_lazy_mixins) break;
+
+        // safe_instance is the same as us, but not const
+        safe_instance().register_all_lazy_mixins();
     }
 
     // no mixin of this name found
@@ -379,24 +508,32 @@ mixin_id domain::get_mixin_id_by_name(const char* mixin_name) const
 
 void domain::garbage_collect_type_infos()
 {
-    for (auto i = _object_type_infos.begin(); i != _object_type_infos.end(); )
-    {
-        if (i->second->num_objects == 0)
-        {
-            i = _object_type_infos.erase(i);
-        }
-        else
-        {
-            ++i;
-        }
-    }
+    _global_object_domain->garbage_collect_type_infos();
+}
+
+void domain::register_object_domain(object_domain& od)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_registry_mutex);
+#endif
+    _object_domains.push_back(&od);
+}
+
+void domain::unregister_object_domain(const object_domain& od)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_registry_mutex);
+#endif
+    auto f = std::find(_object_domains.begin(), _object_domains.end(), &od);
+    I_DYNAMIX_ASSERT_MSG(f != _object_domains.end(), "unregistering an object domain which isn't registered");
+    _object_domains.erase(f);
 }
 
 void domain::register_type_class(type_class& t)
 {
 #if DYNAMIX_THREAD_SAFE_MUTATIONS
-    // lock since registering new types reads the _type_classes array
-    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+    // lock since creating new types reads the _type_classes array
+    std::unique_lock<std::mutex> lock(_registry_mutex);
 #endif
 
     type_class_id free = 0;
@@ -417,10 +554,23 @@ void domain::register_type_class(type_class& t)
 #if DYNAMIX_DEBUG
     // make a check
     // we don't support registering a type class which matches existing type infos
-    for (const auto& ti : _object_type_infos)
+    auto object_domains = _object_domains;
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    // the type infos lock of a domain is never taken after the registry lock
+    lock.unlock();
+#endif
+
+    for (auto od : object_domains)
     {
-        auto& info = ti.second;
-        I_DYNAMIX_ASSERT_MSG(!t.matches(*info), "registering a type class which matches existing type infos");
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+        std::lock_guard<std::mutex> od_lock(od->_object_type_infos_mutex);
+#endif
+        for (const auto& ti : od->_object_type_infos)
+        {
+            auto& info = ti.second;
+            I_DYNAMIX_ASSERT_MSG(!t.matches(*info), "registering a type class which matches existing type infos");
+        }
     }
 #endif
 }
@@ -428,8 +578,8 @@ void domain::register_type_class(type_class& t)
 void domain::unregister_type_class(const type_class& t)
 {
 #if DYNAMIX_THREAD_SAFE_MUTATIONS
-    // lock since registering new types reads the _type_classes array
-    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+    // lock since creating new types reads the _type_classes array
+    std::lock_guard<std::mutex> lock(_registry_mutex);
 #endif
 
     I_DYNAMIX_ASSERT_MSG(t.id() < _type_classes.size(), "unregistering a type class which isn't registered");
@@ -468,6 +618,11 @@ std::shared_ptr<mutation_rule> remove_mutation_rule(mutation_rule_id id)
     return internal::domain::safe_instance().remove_mutation_rule(id);
 }
 
+void preload_all_mixins()
+{
+    internal::domain::safe_instance().register_all_lazy_mixins();
+}
+
 // set allocator to all domains
 void set_global_allocator(domain_allocator* allocator)
 {
@@ -0,0 +1,29 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/double_buffer.hpp"
+
+namespace dynamix
+{
+
+namespace internal
+{
+std::atomic<uint32_t> double_buffer_epoch = {0};
+}
+
+void swap_buffers() noexcept
+{
+    internal::double_buffer_epoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t buffer_epoch() noexcept
+{
+    return internal::double_buffer_epoch.load(std::memory_order_relaxed);
+}
+
+} // namespace dynamix
@@ -0,0 +1,59 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/interface.hpp"
+#include "dynamix/domain.hpp"
+#include "dynamix/trace.hpp"
+
+#include <atomic>
+
+namespace dynamix
+{
+namespace internal
+{
+
+uint32_t new_interface_id()
+{
+    static std::atomic<uint32_t> num_interfaces = {0};
+    const uint32_t ret = num_interfaces.fetch_add(1, std::memory_order_relaxed);
+    I_DYNAMIX_ASSERT_MSG(ret < DYNAMIX_MAX_INTERFACES,
+        "maximum number of interfaces reached, increase DYNAMIX_MAX_INTERFACES");
+    return ret;
+}
+
+const object_type_info::call_table_message* make_interface_table(
+    const object_type_info& type, uint32_t interface_id, const feature_id* messages, size_t num_messages)
+{
+    I_DYNAMIX_TRACE_SCOPE("make_interface_table", "type");
+
+    auto& dom = domain::instance();
+
+    // a copy of the top-bid messages, so the calls don't need the call table
+    auto table = new object_type_info::call_table_message[num_messages];
+    for (size_t i = 0; i < num_messages; ++i)
+    {
+        I_DYNAMIX_ASSERT_MSG(messages[i] != INVALID_FEATURE_ID, "the messages of interfaces must be registered");
+        I_DYNAMIX_ASSERT_MSG(dom.message_data(messages[i]).mechanism == message_t::unicast,
+            "interfaces can only have unicast messages");
+        table[i] = type._call_table[messages[i]].top_bid_message;
+    }
+
+    // another thread might have made it in the meantime
+    const object_type_info::call_table_message* expected = nullptr;
+    if (!type._interface_tables[interface_id].compare_exchange_strong(expected, table,
+        std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        delete[] table;
+        return expected;
+    }
+
+    return table;
+}
+
+} // namespace internal
+} // namespace dynamix
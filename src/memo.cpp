@@ -0,0 +1,124 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/memo.hpp"
+#include "dynamix/domain.hpp"
+#include "dynamix/object.hpp"
+#include "dynamix/object_domain.hpp"
+#include "dynamix/object_type_info.hpp"
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+#   define I_DYNAMIX_MEMOS_LOCK(dom) std::lock_guard<std::mutex> lock(dom._memos_mutex)
+#else
+#   define I_DYNAMIX_MEMOS_LOCK(dom)
+#endif
+
+namespace dynamix
+{
+
+void invalidate_memos(const object& obj) noexcept
+{
+    if (auto table = internal::find_memo_table(obj))
+    {
+        ++table->generation;
+    }
+}
+
+namespace internal
+{
+
+memo_table* find_memo_table(const object& obj) noexcept
+{
+    auto& dom = obj.domain();
+    if (!dom._has_memos.load(std::memory_order_relaxed)) return nullptr;
+
+    I_DYNAMIX_MEMOS_LOCK(dom);
+    auto f = dom._memos.find(&obj);
+    return f == dom._memos.end() ? nullptr : f->second.get();
+}
+
+memo_table& get_memo_table(const object& obj)
+{
+    auto& dom = obj.domain();
+    I_DYNAMIX_MEMOS_LOCK(dom);
+    auto& table = dom._memos[&obj];
+    if (!table)
+    {
+        table.reset(new memo_table);
+    }
+    dom._has_memos.store(true, std::memory_order_relaxed);
+    return *table;
+}
+
+void drop_memos(const object& obj) noexcept
+{
+    auto& dom = obj.domain();
+    if (!dom._has_memos.load(std::memory_order_relaxed)) return;
+
+    I_DYNAMIX_MEMOS_LOCK(dom);
+    dom._memos.erase(&obj);
+}
+
+void move_memos(const object& to, const object& from) noexcept
+{
+    auto& dom = from.domain();
+    I_DYNAMIX_ASSERT(&to.domain() == &dom);
+    if (!dom._has_memos.load(std::memory_order_relaxed)) return;
+
+    I_DYNAMIX_MEMOS_LOCK(dom);
+    auto f = dom._memos.find(&from);
+    if (f == dom._memos.end()) return;
+
+    std::unique_ptr<memo_table> table = std::move(f->second);
+    dom._memos.erase(f);
+
+    // the results are dropped if there's no memory for them
+    try
+    {
+        dom._memos[&to] = std::move(table);
+    }
+    catch (...)
+    {
+    }
+}
+
+bool is_pure_message(const object& obj, feature_id id) noexcept
+{
+    const auto& entry = obj.type_info()._call_table[id];
+    if (!entry.top_bid_message) return false;
+
+    if (domain::instance().message_data(id).mechanism == message_t::unicast)
+    {
+        return entry.top_bid_message.data->pure;
+    }
+
+    for (auto msg = entry.begin; msg != entry.end; ++msg)
+    {
+        if (!msg->data->pure) return false;
+    }
+    return true;
+}
+
+void invalidate_memo(const object& obj, feature_id id) noexcept
+{
+    auto table = find_memo_table(obj);
+    if (!table) return;
+
+    for (auto& e : table->entries)
+    {
+        if (e.message == id)
+        {
+            // any generation but the current one
+            e.generation = table->generation - 1;
+        }
+    }
+}
+
+} // namespace internal
+
+} // namespace dynamix
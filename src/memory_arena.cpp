@@ -0,0 +1,199 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/memory_arena.hpp"
+#include "dynamix/mixin_type_info.hpp"
+#include "dynamix/exception.hpp"
+
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define I_DYNAMIX_HUGE_PAGES 1
+#else
+#define I_DYNAMIX_HUGE_PAGES 0
+#endif
+
+namespace dynamix
+{
+
+constexpr size_t memory_arena::CACHE_LINE_SIZE;
+constexpr size_t memory_arena::HUGE_PAGE_SIZE;
+
+memory_arena::memory_arena(size_t block_size /*= HUGE_PAGE_SIZE*/, bool huge_pages /*= false*/)
+    : _block_size(huge_pages ? internal::next_multiple(block_size, HUGE_PAGE_SIZE) : block_size)
+    , _huge_pages(huge_pages && I_DYNAMIX_HUGE_PAGES)
+{
+    I_DYNAMIX_ASSERT(block_size);
+}
+
+memory_arena::~memory_arena()
+{
+    release();
+}
+
+void* memory_arena::allocate(size_t size, size_t alignment /*= sizeof(void*)*/)
+{
+    I_DYNAMIX_ASSERT((alignment & (alignment - 1)) == 0); // power of two
+
+    auto aligned = reinterpret_cast<char*>(internal::next_multiple(uintptr_t(_pos), alignment));
+    if (_pos && aligned + size <= _end)
+    {
+        _pos = aligned + size;
+        return aligned;
+    }
+
+    if (size + alignment > _block_size)
+    {
+        // big allocation
+        // put it in its own block, but keep allocating from the current one
+        auto block_size = size + alignment;
+        if (_huge_pages) block_size = internal::next_multiple(block_size, HUGE_PAGE_SIZE);
+        auto memory = alloc_block(block_size);
+        _blocks.push_back({memory, block_size});
+        return reinterpret_cast<char*>(internal::next_multiple(uintptr_t(memory), alignment));
+    }
+
+    auto memory = alloc_block(_block_size);
+    _blocks.push_back({memory, _block_size});
+    _end = memory + _block_size;
+
+    aligned = reinterpret_cast<char*>(internal::next_multiple(uintptr_t(memory), alignment));
+    _pos = aligned + size;
+    return aligned;
+}
+
+void memory_arena::release()
+{
+    for (auto& b : _blocks)
+    {
+        free_block(b);
+    }
+    _blocks.clear();
+    _pos = _end = nullptr;
+}
+
+size_t memory_arena::reserved_size() const
+{
+    size_t size = 0;
+    for (auto& b : _blocks)
+    {
+        size += b.size;
+    }
+    return size;
+}
+
+char* memory_arena::alloc_block(size_t size)
+{
+#if I_DYNAMIX_HUGE_PAGES
+    if (_huge_pages)
+    {
+        // huge pages are only used for huge page aligned memory
+        // so map more and unmap the unaligned parts
+        const size_t mapped_size = size + HUGE_PAGE_SIZE;
+        void* mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        DYNAMIX_THROW_UNLESS(mapped != MAP_FAILED, std::bad_alloc);
+
+        auto begin = reinterpret_cast<char*>(mapped);
+        auto aligned = reinterpret_cast<char*>(internal::next_multiple(uintptr_t(begin), HUGE_PAGE_SIZE));
+        if (aligned != begin)
+        {
+            munmap(begin, size_t(aligned - begin));
+        }
+        auto tail = mapped_size - size_t(aligned - begin) - size;
+        if (tail)
+        {
+            munmap(aligned + size, tail);
+        }
+
+        // it's only advice, so the result doesn't matter
+        madvise(aligned, size, MADV_HUGEPAGE);
+        return aligned;
+    }
+#endif
+
+    return new char[size];
+}
+
+void memory_arena::free_block(const block& b)
+{
+#if I_DYNAMIX_HUGE_PAGES
+    if (_huge_pages)
+    {
+        munmap(b.memory, b.size);
+        return;
+    }
+#endif
+
+    delete[] b.memory;
+}
+
+arena_allocator::arena_allocator(size_t block_size /*= memory_arena::HUGE_PAGE_SIZE*/, bool huge_pages /*= false*/)
+    : _arena(block_size, huge_pages)
+{
+}
+
+char* arena_allocator::alloc_mixin_data(size_t count, const object*)
+{
+#if DYNAMIX_DEBUG
+    _has_allocated.store(true, std::memory_order_relaxed);
+#endif
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_mutex);
+#endif
+    return static_cast<char*>(_arena.allocate(count * mixin_data_size, alignof(internal::mixin_data_in_object)));
+}
+
+void arena_allocator::dealloc_mixin_data(char*, size_t, const object*)
+{
+    // released with the arena
+}
+
+std::pair<char*, size_t> arena_allocator::alloc_mixin(const mixin_type_info& info, const object*)
+{
+#if DYNAMIX_DEBUG
+    _has_allocated.store(true, std::memory_order_relaxed);
+#endif
+
+    size_t mem_size = mem_size_for_mixin(info.size, info.alignment);
+
+    char* buffer;
+    {
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+        std::lock_guard<std::mutex> lock(_mutex);
+#endif
+        buffer = static_cast<char*>(_arena.allocate(mem_size, sizeof(object*)));
+    }
+
+    auto offset = mixin_offset(buffer, info.alignment);
+    I_DYNAMIX_ASSERT(offset + info.size <= mem_size);
+    return std::make_pair(buffer, offset);
+}
+
+void arena_allocator::dealloc_mixin(char*, size_t, const mixin_type_info&, const object*)
+{
+    // released with the arena
+}
+
+bool arena_allocator::can_reuse_mixin_buffer(const mixin_type_info& freed, const mixin_type_info& needed) const
+{
+    // the freed buffer is lost otherwise
+    return freed.alignment == needed.alignment
+        && mem_size_for_mixin(freed.size, freed.alignment) == mem_size_for_mixin(needed.size, needed.alignment);
+}
+
+void arena_allocator::reset()
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_mutex);
+#endif
+    _arena.release();
+}
+
+} // namespace dynamix
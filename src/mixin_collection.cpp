@@ -60,6 +60,7 @@ bool mixin_collection::remove(const mixin_type_info& info)
     auto i = std::find(_compact_mixins.begin(), _compact_mixins.end(), &info);
     I_DYNAMIX_ASSERT(i != _compact_mixins.end());
     _compact_mixins.erase(i);
+    _mixins[info.id] = false;
     return true;
 }
 
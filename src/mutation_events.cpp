@@ -0,0 +1,217 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "mutation_events.hpp"
+#include "dynamix/mutation_events.hpp"
+#include "dynamix/object_type_info.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace dynamix
+{
+
+namespace
+{
+
+// the events of a thread
+// the thread pushes to one of the two vectors, while the dispatcher drains the other
+struct thread_buffer
+{
+    std::vector<mutation_event> events[2];
+    std::atomic<int> current = {0};
+
+    // set while the thread is pushing
+    // the dispatcher waits for it after switching the current vector
+    std::atomic<bool> pushing = {false};
+};
+
+class event_hub
+{
+public:
+    std::atomic<bool> enabled = {false};
+
+    thread_buffer& this_thread_buffer()
+    {
+        // the thread only holds a reference, so the events of threads
+        // which have exited can still be dispatched
+        thread_local std::shared_ptr<thread_buffer> buffer;
+        if (!buffer)
+        {
+            buffer = std::make_shared<thread_buffer>();
+            std::lock_guard<std::mutex> lock(_buffers_mutex);
+            _buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    size_t dispatch()
+    {
+        std::lock_guard<std::mutex> dispatch_lock(_dispatch_mutex);
+
+        {
+            std::lock_guard<std::mutex> lock(_buffers_mutex);
+
+            _batch.clear();
+            for (auto i = _buffers.begin(); i != _buffers.end(); )
+            {
+                auto& buf = **i;
+                bool orphaned = i->use_count() == 1;
+
+                int drained = buf.current.load(std::memory_order_seq_cst);
+                buf.current.store(1 - drained, std::memory_order_seq_cst);
+
+                // if the thread has seen the old current vector, it's still pushing to it
+                while (buf.pushing.load(std::memory_order_seq_cst))
+                {
+                    std::this_thread::yield();
+                }
+
+                auto& events = buf.events[drained];
+                _batch.insert(_batch.end(), events.begin(), events.end());
+                events.clear();
+
+                if (orphaned)
+                {
+                    // the thread has exited, so nothing can be pushed to the other vector
+                    auto& rest = buf.events[1 - drained];
+                    _batch.insert(_batch.end(), rest.begin(), rest.end());
+                    i = _buffers.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        if (_batch.empty()) return 0;
+
+        std::lock_guard<std::mutex> lock(_subscribers_mutex);
+        for (auto& s : _subscribers)
+        {
+            if (s) s(_batch);
+        }
+
+        return _batch.size();
+    }
+
+    mutation_events::subscriber_id add_subscriber(mutation_events::subscriber s)
+    {
+        std::lock_guard<std::mutex> lock(_subscribers_mutex);
+
+        // find free slot
+        for (mutation_events::subscriber_id i = 0; i < _subscribers.size(); ++i)
+        {
+            if (!_subscribers[i])
+            {
+                _subscribers[i] = std::move(s);
+                return i;
+            }
+        }
+
+        _subscribers.emplace_back(std::move(s));
+        return _subscribers.size() - 1;
+    }
+
+    void remove_subscriber(mutation_events::subscriber_id id)
+    {
+        std::lock_guard<std::mutex> lock(_subscribers_mutex);
+        if (id >= _subscribers.size()) return;
+        _subscribers[id] = nullptr;
+    }
+
+private:
+    std::mutex _dispatch_mutex;
+
+    // only locked when a thread pushes its first event and by the dispatcher
+    std::mutex _buffers_mutex;
+    std::vector<std::shared_ptr<thread_buffer>> _buffers;
+
+    // reused between dispatches
+    std::vector<mutation_event> _batch;
+
+    std::mutex _subscribers_mutex;
+    std::vector<mutation_events::subscriber> _subscribers;
+};
+
+event_hub& the_hub()
+{
+    static event_hub h;
+    return h;
+}
+
+} // anonymous namespace
+
+namespace internal
+{
+
+void push_mutation_event(const object& obj, const object_type_info* old_type, const object_type_info* new_type)
+{
+    auto& h = the_hub();
+    if (!h.enabled.load(std::memory_order_relaxed)) return;
+    if (old_type == new_type) return;
+
+    auto& buf = h.this_thread_buffer();
+
+    // pairs with the store of the current vector in dispatch:
+    // either the dispatcher sees that we're pushing or we see the new current vector
+    buf.pushing.store(true, std::memory_order_seq_cst);
+    auto& events = buf.events[buf.current.load(std::memory_order_seq_cst)];
+
+    events.emplace_back();
+    auto& e = events.back();
+    e.obj = &obj;
+    e.old_type = old_type;
+    e.new_type = new_type;
+    e.added = new_type->_mixins & ~old_type->_mixins;
+    e.removed = old_type->_mixins & ~new_type->_mixins;
+
+    buf.pushing.store(false, std::memory_order_release);
+}
+
+} // namespace internal
+
+namespace mutation_events
+{
+
+void enable()
+{
+    the_hub().enabled = true;
+}
+
+void disable()
+{
+    the_hub().enabled = false;
+}
+
+bool is_enabled() noexcept
+{
+    return the_hub().enabled.load(std::memory_order_relaxed);
+}
+
+subscriber_id add_subscriber(subscriber s)
+{
+    return the_hub().add_subscriber(std::move(s));
+}
+
+void remove_subscriber(subscriber_id id)
+{
+    the_hub().remove_subscriber(id);
+}
+
+size_t dispatch()
+{
+    return the_hub().dispatch();
+}
+
+} // namespace mutation_events
+
+} // namespace dynamix
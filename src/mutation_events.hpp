@@ -0,0 +1,25 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+// internal hooks of the mutation events
+
+namespace dynamix
+{
+
+class object;
+class object_type_info;
+
+namespace internal
+{
+
+// does nothing if the events are disabled or the type doesn't change
+void push_mutation_event(const object& obj, const object_type_info* old_type, const object_type_info* new_type);
+
+}
+}
@@ -9,13 +9,24 @@
 #include "dynamix/object.hpp"
 #include "dynamix/allocators.hpp"
 #include "dynamix/domain.hpp"
+#include "dynamix/object_domain.hpp"
 #include "dynamix/exception.hpp"
 #include "dynamix/message.hpp"
 #include "dynamix/mixin_type_info.hpp"
 #include "dynamix/object_type_info.hpp"
 #include "dynamix/object_type_template.hpp"
+#include "dynamix/memo.hpp"
+#include "dynamix/double_buffer.hpp"
+#include "dynamix/seqlock.hpp"
+#include "dynamix/trace.hpp"
+#include "workload.hpp"
+#include "mutation_events.hpp"
+#include "concurrent_mutations.hpp"
+#include "dynamix/concurrent_mutations.hpp"
 #include "dynamix/internal/mixin_data_in_object.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <tuple>
 
 namespace dynamix
@@ -23,22 +34,71 @@ namespace dynamix
 
 using namespace internal;
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+// the null mixin data needs the null type in front of it, so it's defined next to it
+static mixin_data_in_object* null_mixin_data() { return object_type_info::null_mixin_data(); }
+#else
 // used by objects with no mixin data, so they would
 // return nullptr on get<Mixin>() without having to
 // check or crashing
-static mixin_data_in_object null_mixin_data;
+static mixin_data_in_object the_null_mixin_data;
+static mixin_data_in_object* null_mixin_data() { return &the_null_mixin_data; }
+#endif
+
+// the instance of a mixin for access through an object with the constness of Object
+// or null if the object doesn't have the mixin
+template <typename Object>
+static char* mixin_instance(const object_type_info& type, const mixin_data_in_object* data, mixin_id id)
+{
+    const uint32_t index = type.mixin_index(id);
+    const void* mixin = data[index].mixin();
+    if (!mixin) return nullptr;
+    return double_buffer_instance<Object>(mixin,
+        type._compact_mixins[index - object_type_info::MIXIN_INDEX_OFFSET]->double_buffer_offset);
+}
+
+// assigns a trivially assignable mixin with memcpy instead of calling its assignment proc
+// only a single instance is copied, without the sequence counter of seqlocked mixins
+// the second instance of double-buffered ones is copied separately,
+// so the pointer to the object in front of it is kept
+static void copy_instances(void* target, const void* source, const mixin_type_info& info)
+{
+    const size_t size = (info.seqlocked ? info.seqlock_offset : info.size) - info.double_buffer_offset;
+    std::memcpy(target, source, size);
+    if (info.double_buffer_offset)
+    {
+        std::memcpy(static_cast<char*>(target) + info.double_buffer_offset,
+            static_cast<const char*>(source) + info.double_buffer_offset, size);
+    }
+}
 
 object::object() noexcept
     : _type_info(&object_type_info::null())
-    , _mixin_data(&null_mixin_data)
+    , _mixin_data(null_mixin_data())
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    , _published_mixin_data(null_mixin_data())
+#endif
+    , _domain(&object_domain::global())
 {
+    record_object_create(*this);
 }
 
 object::object(object_allocator* allocator)
+    : object(object_domain::global(), allocator)
+{
+}
+
+object::object(object_domain& domain, object_allocator* allocator /*= nullptr*/)
     : _type_info(&object_type_info::null())
-    , _mixin_data(&null_mixin_data)
+    , _mixin_data(null_mixin_data())
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    , _published_mixin_data(null_mixin_data())
+#endif
     , _allocator(allocator)
+    , _domain(&domain)
 {
+    record_object_create(*this);
+
     if (_allocator)
     {
         _allocator->on_set_to_object(*this);
@@ -46,21 +106,30 @@ object::object(object_allocator* allocator)
 }
 
 object::object(const object_type_template& type, object_allocator* allocator /*= nullptr*/)
-    : object(allocator)
+    : object(type.domain(), allocator)
 {
     type.apply_to(*this);
 }
 
 object::~object()
 {
+    record_object_destroy(*this);
+    record_suppress_scope no_record;
     clear();
     if (_allocator)
     {
         _allocator->release(*this);
     }
+    drop_memos(*this);
 }
 
 object::object(object&& o) noexcept
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    : _published_mixin_data(null_mixin_data())
+    , _domain(o._domain)
+#else
+    : _domain(o._domain)
+#endif
 {
     usurp(std::move(o));
 }
@@ -75,8 +144,13 @@ object& object::operator=(object&& o) noexcept
 #if DYNAMIX_OBJECT_IMPLICIT_COPY
 object::object(const object& o)
     : _type_info(&object_type_info::null())
-    , _mixin_data(&null_mixin_data)
+    , _mixin_data(null_mixin_data())
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    , _published_mixin_data(null_mixin_data())
+#endif
+    , _domain(o._domain)
 {
+    record_object_create(*this);
     copy_from(o);
 }
 
@@ -89,25 +163,51 @@ object& object::operator=(const object& o)
 
 object object::copy() const
 {
-    object o;
+    object o(*_domain);
     o.copy_from(*this);
     return o;
 }
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+// queries can come from other threads, so they use the published mixin data
+// the returned mixins are only valid in the read scope of the caller
+
+void* object::internal_get_mixin(mixin_id id)
+{
+    read_scope scope;
+    auto data = _published_mixin_data.load(std::memory_order_acquire);
+    return mixin_instance<object>(*object_type_info::of_mixin_data(data), data, id);
+}
+
+const void* object::internal_get_mixin(mixin_id id) const
+{
+    read_scope scope;
+    auto data = _published_mixin_data.load(std::memory_order_acquire);
+    return mixin_instance<const object>(*object_type_info::of_mixin_data(data), data, id);
+}
+
+bool object::internal_has_mixin(mixin_id id) const
+{
+    read_scope scope;
+    auto data = _published_mixin_data.load(std::memory_order_acquire);
+    return object_type_info::of_mixin_data(data)->has(id);
+}
+#else
 void* object::internal_get_mixin(mixin_id id)
 {
-    return _mixin_data[_type_info->mixin_index(id)].mixin();
+    return mixin_instance<object>(*_type_info, _mixin_data, id);
 }
 
 const void* object::internal_get_mixin(mixin_id id) const
 {
-    return _mixin_data[_type_info->mixin_index(id)].mixin();
+    return mixin_instance<const object>(*_type_info, _mixin_data, id);
 }
 
 bool object::internal_has_mixin(mixin_id id) const
 {
     return _type_info->has(id);
 }
+#endif
 
 bool object::is_a(const type_class& tc) const
 {
@@ -116,21 +216,89 @@ bool object::is_a(const type_class& tc) const
 
 void object::clear() noexcept
 {
+    I_DYNAMIX_TRACE_SCOPE("clear", "mutation");
+
+    invalidate_memos(*this);
+
+    if (!empty())
+    {
+        record_type_change(*this, _type_info, &object_type_info::null());
+        push_mutation_event(*this, _type_info, &object_type_info::null());
+    }
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    _published_mixin_data.store(null_mixin_data(), std::memory_order_release);
+#endif
+
     for (const mixin_type_info* mixin_info : _type_info->_compact_mixins)
     {
+#if DYNAMIX_CONCURRENT_MUTATIONS
+        retire_mixin(*mixin_info, _mixin_data[_type_info->mixin_index(mixin_info->id)]);
+#else
         delete_mixin(*mixin_info);
+#endif
     }
 
-    if (_mixin_data != &null_mixin_data)
+    if (_mixin_data != null_mixin_data())
     {
+#if DYNAMIX_CONCURRENT_MUTATIONS
+        _type_info->retire_mixin_data(_mixin_data, this);
+#else
         _type_info->dealloc_mixin_data(_mixin_data, this);
-        _mixin_data = &null_mixin_data;
+#endif
+        _mixin_data = null_mixin_data();
 
         I_DYNAMIX_ASSERT(_type_info->num_objects > 0);
         --_type_info->num_objects;
     }
 
     _type_info = &object_type_info::null();
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    reclaim();
+#endif
+}
+
+void object::teardown_destroy_mixins(bool call_destructors) noexcept
+{
+    for (const mixin_type_info* mixin_info : _type_info->_compact_mixins)
+    {
+        if (mixin_info->trivially_destructible) continue;
+        if (!call_destructors && !mixin_info->destroy_on_teardown) continue;
+
+        mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(*mixin_info);
+        alloc->destroy_mixin(*mixin_info, _mixin_data[_type_info->mixin_index(mixin_info->id)].mixin());
+    }
+}
+
+void object::teardown_release(bool release_memory) noexcept
+{
+    if (empty()) return;
+
+    invalidate_memos(*this);
+
+    record_type_change(*this, _type_info, &object_type_info::null());
+    push_mutation_event(*this, _type_info, &object_type_info::null());
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // there must be no readers, so nothing is retired
+    _published_mixin_data.store(null_mixin_data(), std::memory_order_release);
+#endif
+
+    if (release_memory)
+    {
+        for (const mixin_type_info* mixin_info : _type_info->_compact_mixins)
+        {
+            mixin_data_in_object& data = _mixin_data[_type_info->mixin_index(mixin_info->id)];
+            mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(*mixin_info);
+            alloc->dealloc_mixin(data.buffer(), data.mixin_offset(), *mixin_info, this);
+        }
+
+        _type_info->dealloc_mixin_data(_mixin_data, this);
+    }
+
+    _mixin_data = null_mixin_data();
+    _type_info = &object_type_info::null();
 }
 
 bool object::empty() const noexcept
@@ -143,43 +311,176 @@ void object::change_type(const object_type_info* new_type)
     change_type_from(new_type, nullptr);
 }
 
+#if !DYNAMIX_CONCURRENT_MUTATIONS
+namespace
+{
+// buffer of a mixin removed by a mutation, which may be reused by an added one
+struct freed_mixin_buffer
+{
+    const mixin_type_info* info;
+    mixin_allocator* alloc;
+    char* buffer;
+    size_t mixin_offset;
+};
+
+// the common mutations remove only a few mixins
+// buffers of the ones above that are deallocated immediately
+const size_t MAX_FREED_MIXIN_BUFFERS = 8;
+
+// the buffers which haven't been reused are deallocated when it's destroyed,
+// so they aren't leaked if a mixin constructor throws
+struct freed_mixin_buffers
+{
+    explicit freed_mixin_buffers(const object* obj) : obj(obj) {}
+    ~freed_mixin_buffers() { dealloc_all(); }
+
+    freed_mixin_buffers(const freed_mixin_buffers&) = delete;
+    freed_mixin_buffers& operator=(const freed_mixin_buffers&) = delete;
+
+    void dealloc_all()
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto& f = buffers[i];
+            I_DYNAMIX_TRACE_SCOPE("dealloc_mixin", "allocator", f.info->name);
+            f.alloc->dealloc_mixin(f.buffer, f.mixin_offset, *f.info, obj);
+        }
+        size = 0;
+    }
+
+    const object* obj;
+    freed_mixin_buffer buffers[MAX_FREED_MIXIN_BUFFERS];
+    size_t size = 0;
+};
+}
+#endif
+
 object::change_type_from_result object::change_type_from(const object_type_info* new_type, const internal::mixin_data_in_object* source)
 {
+    I_DYNAMIX_TRACE_SCOPE("change_type", "mutation");
+
+    invalidate_memos(*this);
+
+    record_type_change(*this, _type_info, new_type);
+    push_mutation_event(*this, _type_info, new_type);
+
     auto res = change_type_from_result::success;
     const object_type_info* old_type = _type_info;
     mixin_data_in_object* old_mixin_data = _mixin_data;
-    mixin_data_in_object* new_mixin_data = new_type->alloc_mixin_data(this);
+    mixin_data_in_object* new_mixin_data;
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // readers may still use the old mixin data and the removed mixins
+    // so they are retired after the new data is published and nothing can be reused
+    new_mixin_data = new_type->alloc_mixin_data(this);
 
     for (const mixin_type_info* mixin_info : old_type->_compact_mixins)
     {
         mixin_id id = mixin_info->id;
         if (new_type->has(id))
         {
-            auto new_index = new_type->mixin_index(id);
-            auto& data = new_mixin_data[new_index];
-            data = old_mixin_data[old_type->mixin_index(id)];
+            new_mixin_data[new_type->mixin_index(id)] = old_mixin_data[old_type->mixin_index(id)];
+        }
+    }
+#else
+    freed_mixin_buffers freed(this);
+
+    for (const mixin_type_info* mixin_info : old_type->_compact_mixins)
+    {
+        if (new_type->has(mixin_info->id)) continue;
 
-            if (source)
+        if (freed.size == MAX_FREED_MIXIN_BUFFERS)
+        {
+            delete_mixin(*mixin_info);
+            continue;
+        }
+
+        // destroy the mixin, but keep its buffer for the mixins which will be added
+        mixin_data_in_object& data = old_mixin_data[old_type->mixin_index(mixin_info->id)];
+        mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(*mixin_info);
+
+        {
+            I_DYNAMIX_TRACE_SCOPE("destroy_mixin", "mutation", mixin_info->name);
+            alloc->destroy_mixin(*mixin_info, data.mixin());
+        }
+
+        I_DYNAMIX_ASSERT(mixin_info->num_mixins > 0);
+        --mixin_info->num_mixins;
+
+        freed.buffers[freed.size++] = { mixin_info, alloc, data.buffer(), data.mixin_offset() };
+        data.clear();
+    }
+
+    if (old_mixin_data != null_mixin_data() && old_type->_compact_mixins.size() == new_type->_compact_mixins.size())
+    {
+        // same number of mixins (say one was swapped for another), so the mixin data can be reused
+        // the kept mixins are in the same order in both types, so their data can be moved in place
+        // without overwriting the data of others:
+        // the ones which move to a lower index are moved in ascending order and the rest in descending
+        new_mixin_data = old_mixin_data;
+
+        for (const mixin_type_info* mixin_info : new_type->_compact_mixins)
+        {
+            if (!old_type->has(mixin_info->id)) continue;
+            auto old_index = old_type->mixin_index(mixin_info->id);
+            auto new_index = new_type->mixin_index(mixin_info->id);
+            if (new_index < old_index)
             {
-                if (!mixin_info->copy_assignment)
-                {
-                    res = change_type_from_result::bad_assign;
-                }
-                else
-                {
-                    mixin_info->copy_assignment(data.mixin(), source[new_index].mixin());
-                }
+                new_mixin_data[new_index] = old_mixin_data[old_index];
+                new_mixin_data[old_index].clear();
             }
         }
-        else
+
+        for (auto i = new_type->_compact_mixins.rbegin(); i != new_type->_compact_mixins.rend(); ++i)
         {
-            delete_mixin(*mixin_info);
+            const mixin_type_info* mixin_info = *i;
+            if (!old_type->has(mixin_info->id)) continue;
+            auto old_index = old_type->mixin_index(mixin_info->id);
+            auto new_index = new_type->mixin_index(mixin_info->id);
+            if (new_index > old_index)
+            {
+                new_mixin_data[new_index] = old_mixin_data[old_index];
+                new_mixin_data[old_index].clear();
+            }
+        }
+    }
+    else
+    {
+        new_mixin_data = new_type->alloc_mixin_data(this);
+
+        for (const mixin_type_info* mixin_info : old_type->_compact_mixins)
+        {
+            mixin_id id = mixin_info->id;
+            if (new_type->has(id))
+            {
+                new_mixin_data[new_type->mixin_index(id)] = old_mixin_data[old_type->mixin_index(id)];
+            }
+        }
+
+        if (old_mixin_data != null_mixin_data())
+        {
+            old_type->dealloc_mixin_data(old_mixin_data, this);
         }
     }
+#endif
 
-    if (old_mixin_data != &null_mixin_data)
+    if (source)
     {
-        old_type->dealloc_mixin_data(old_mixin_data, this);
+        for (const mixin_type_info* mixin_info : old_type->_compact_mixins)
+        {
+            mixin_id id = mixin_info->id;
+            if (!new_type->has(id)) continue;
+
+            auto new_index = new_type->mixin_index(id);
+            if (!mixin_info->copy_assignment)
+            {
+                res = change_type_from_result::bad_assign;
+            }
+            else
+            {
+                mixin_info->copy_assignment(new_mixin_data[new_index].mixin(), source[new_index].mixin());
+            }
+        }
     }
 
     if (old_type != &object_type_info::null())
@@ -198,16 +499,53 @@ object::change_type_from_result object::change_type_from(const object_type_info*
     for (const mixin_type_info* mixin_info : new_type->_compact_mixins)
     {
         size_t index = new_type->mixin_index(mixin_info->id);
-        if (!new_mixin_data[index].buffer())
+        if (new_mixin_data[index].buffer()) continue;
+
+        const void* source_mixin_data = source ? source[index].mixin() : nullptr;
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+        bool made = make_mixin(*mixin_info, source_mixin_data);
+#else
+        freed_mixin_buffer* reused = nullptr;
+        if (freed.size)
         {
-            const void* source_mixin_data = source ? source[index].mixin() : nullptr;
-            if (!make_mixin(*mixin_info, source_mixin_data))
+            mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(*mixin_info);
+            for (size_t i = 0; i < freed.size; ++i)
             {
-                res = change_type_from_result::bad_copy_construct;
+                auto& f = freed.buffers[i];
+                if (f.alloc == alloc && alloc->can_reuse_mixin_buffer(*f.info, *mixin_info))
+                {
+                    reused = &f;
+                    break;
+                }
             }
         }
+
+        bool made;
+        if (reused)
+        {
+            // the mixin data owns the buffer from here on, even if the constructor throws
+            auto buf = *reused;
+            *reused = freed.buffers[--freed.size];
+            made = make_mixin(*mixin_info, source_mixin_data, buf.buffer, buf.mixin_offset);
+        }
+        else
+        {
+            made = make_mixin(*mixin_info, source_mixin_data);
+        }
+#endif
+
+        if (!made)
+        {
+            res = change_type_from_result::bad_copy_construct;
+        }
     }
 
+#if !DYNAMIX_CONCURRENT_MUTATIONS
+    // deallocate the buffers which weren't reused
+    freed.dealloc_all();
+#endif
+
     if (!empty())
     {
         // set the appropriate default message implementation virtual mixin
@@ -216,28 +554,54 @@ object::change_type_from_result object::change_type_from(const object_type_info*
         data.set_object(this);
     }
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    // the new mixin data is complete, so readers can see it
+    // only after that the old one and the removed mixins can be retired
+    _published_mixin_data.store(_mixin_data, std::memory_order_release);
+
+    for (const mixin_type_info* mixin_info : old_type->_compact_mixins)
+    {
+        if (!new_type->has(mixin_info->id))
+        {
+            retire_mixin(*mixin_info, old_mixin_data[old_type->mixin_index(mixin_info->id)]);
+        }
+    }
+
+    if (old_mixin_data != null_mixin_data())
+    {
+        old_type->retire_mixin_data(old_mixin_data, this);
+    }
+
+    reclaim();
+#endif
+
     return res;
 }
 
-bool object::make_mixin(const mixin_type_info& mixin_info, const void* source)
+bool object::make_mixin(const mixin_type_info& mixin_info, const void* source, char* buffer /*= nullptr*/, size_t mixin_offset /*= 0*/)
 {
     I_DYNAMIX_ASSERT(_type_info->has(mixin_info.id));
     mixin_data_in_object& data = _mixin_data[_type_info->mixin_index(mixin_info.id)];
     I_DYNAMIX_ASSERT(!data.buffer());
 
-    mixin_allocator* alloc = _allocator ? _allocator : mixin_info.allocator;
-    char* buffer;
-    size_t mixin_offset;
-    std::tie(buffer, mixin_offset) = alloc->alloc_mixin(mixin_info, this);
+    mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(mixin_info);
+    if (!buffer)
+    {
+        I_DYNAMIX_TRACE_SCOPE("alloc_mixin", "allocator", mixin_info.name);
+        std::tie(buffer, mixin_offset) = alloc->alloc_mixin(mixin_info, this);
+    }
 
     I_DYNAMIX_ASSERT(buffer);
     I_DYNAMIX_ASSERT(mixin_offset >= sizeof(object*)); // we should have room for an object pointer
 
     data.set_buffer(buffer, mixin_offset);
-    data.set_object(this);
+    data.set_object(this, mixin_info.double_buffer_offset);
+    init_seqlock(data.mixin(), mixin_info.seqlock_offset);
 
     ++mixin_info.num_mixins;
 
+    I_DYNAMIX_TRACE_SCOPE("construct_mixin", "mutation", mixin_info.name);
+
     if (!source)
     {
         alloc->construct_mixin(mixin_info, data.mixin());
@@ -266,22 +630,59 @@ void object::delete_mixin(const mixin_type_info& mixin_info)
     I_DYNAMIX_ASSERT(_type_info->has(mixin_info.id));
     mixin_data_in_object& data = _mixin_data[_type_info->mixin_index(mixin_info.id)];
 
-    mixin_allocator* alloc = _allocator ? _allocator : mixin_info.allocator;
+    mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(mixin_info);
+
+    {
+        I_DYNAMIX_TRACE_SCOPE("destroy_mixin", "mutation", mixin_info.name);
+        alloc->destroy_mixin(mixin_info, data.mixin());
+    }
 
-    alloc->destroy_mixin(mixin_info, data.mixin());
+    {
+        I_DYNAMIX_TRACE_SCOPE("dealloc_mixin", "allocator", mixin_info.name);
+        // dealocate mixin
+        alloc->dealloc_mixin(data.buffer(), data.mixin_offset(), mixin_info, this);
+    }
 
-    // dealocate mixin
-    alloc->dealloc_mixin(data.buffer(), data.mixin_offset(), mixin_info, this);
+    I_DYNAMIX_ASSERT(mixin_info.num_mixins > 0);
+    --mixin_info.num_mixins;
 
+    data.clear();
+}
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+void object::retire_mixin(const mixin_type_info& mixin_info, mixin_data_in_object& data)
+{
+    mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(mixin_info);
+    internal::retire_mixin(mixin_info, alloc, data.buffer(), data.mixin_offset(), this);
+
+    // the mixin is no longer in an object even if it's still alive
     I_DYNAMIX_ASSERT(mixin_info.num_mixins > 0);
     --mixin_info.num_mixins;
 
     data.clear();
 }
+#endif
 
 bool object::internal_implements(feature_id id, const internal::message_feature_tag&) const
 {
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    read_scope scope;
+    auto data = _published_mixin_data.load(std::memory_order_acquire);
+    return object_type_info::of_mixin_data(data)->implements_message(id);
+#else
     return _type_info->implements_message(id);
+#endif
+}
+
+bool object::internal_implements(feature_id id, const internal::fact_feature_tag& tag) const
+{
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    read_scope scope;
+    auto data = _published_mixin_data.load(std::memory_order_acquire);
+    return object_type_info::of_mixin_data(data)->internal_implements(id, tag);
+#else
+    return _type_info->internal_implements(id, tag);
+#endif
 }
 
 bool object::has(mixin_id id) const noexcept
@@ -292,7 +693,7 @@ bool object::has(mixin_id id) const noexcept
 
 bool object::has(const char* mixin_name) const noexcept
 {
-    auto id = domain::instance().get_mixin_id_by_name(mixin_name);
+    auto id = internal::domain::instance().get_mixin_id_by_name(mixin_name);
     return has(id);
 }
 
@@ -310,18 +711,20 @@ const void* object::get(mixin_id id) const noexcept
 
 void* object::get(const char* mixin_name) noexcept
 {
-    auto id = domain::instance().get_mixin_id_by_name(mixin_name);
+    auto id = internal::domain::instance().get_mixin_id_by_name(mixin_name);
     return get(id);
 }
 
 const void* object::get(const char* mixin_name) const noexcept
 {
-    auto id = domain::instance().get_mixin_id_by_name(mixin_name);
+    auto id = internal::domain::instance().get_mixin_id_by_name(mixin_name);
     return get(id);
 }
 
 void object::usurp(object&& o) noexcept
 {
+    record_object_move(*this, o);
+
     if (_allocator)
     {
         _allocator->release(*this);
@@ -338,13 +741,20 @@ void object::usurp(object&& o) noexcept
         o._allocator = nullptr;
     }
 
+    drop_memos(*this);
+
+    _domain = o._domain;
     _type_info = o._type_info;
     _mixin_data = o._mixin_data;
 
+    // the mixins are the same, so are the memoized results
+    move_memos(*this, o);
+
     for (size_t i = object_type_info::MIXIN_INDEX_OFFSET;
          i < _type_info->_compact_mixins.size() + object_type_info::MIXIN_INDEX_OFFSET; ++i)
     {
-        _mixin_data[i].set_object(this);
+        _mixin_data[i].set_object(this,
+            _type_info->_compact_mixins[i - object_type_info::MIXIN_INDEX_OFFSET]->double_buffer_offset);
     }
 
     if (!empty())
@@ -354,9 +764,18 @@ void object::usurp(object&& o) noexcept
         data.set_object(this);
     }
 
+    // for the events the mixins are removed from the source and added to the target
+    push_mutation_event(o, _type_info, &object_type_info::null());
+    push_mutation_event(*this, &object_type_info::null(), _type_info);
+
     // clear other object
     o._type_info = &object_type_info::null();
-    o._mixin_data = &null_mixin_data;
+    o._mixin_data = null_mixin_data();
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    _published_mixin_data.store(_mixin_data, std::memory_order_release);
+    o._published_mixin_data.store(null_mixin_data(), std::memory_order_release);
+#endif
 }
 
 void object::copy_from(const object& o)
@@ -389,13 +808,24 @@ void object::copy_from(const object& o)
         return;
     }
 
-    if (o._type_info == _type_info)
+    // the object stays in its domain, so it needs the equivalent type from it
+    // the mixin indices in types of the same mixins are the same in all domains
+    const object_type_info* new_type = o._type_info;
+    if (new_type->_domain != _domain)
+    {
+        // the mixins of a type are in the order of the mixin data
+        auto mixins = new_type->_compact_mixins;
+        std::sort(mixins.begin(), mixins.end());
+        new_type = _domain->get_object_type_info(mixin_collection(mixins));
+    }
+
+    if (new_type == _type_info)
     {
         copy_matching_from(o);
         return;
     }
 
-    auto res = change_type_from(o._type_info, o._mixin_data);
+    auto res = change_type_from(new_type, o._mixin_data);
 
     if (res != change_type_from_result::success)
     {
@@ -406,14 +836,24 @@ void object::copy_from(const object& o)
 
 void object::copy_matching_from(const object& o)
 {
+    invalidate_memos(*this);
+
     for (const mixin_type_info* info : o._type_info->_compact_mixins)
     {
         auto id = info->id;
         if (_type_info->has(id))
         {
-            DYNAMIX_THROW_UNLESS(info->copy_assignment, bad_copy_assignment);
-            info->copy_assignment(
-                _mixin_data[_type_info->mixin_index(id)].mixin(), o._mixin_data[o._type_info->mixin_index(id)].mixin());
+            void* target = _mixin_data[_type_info->mixin_index(id)].mixin();
+            const void* source = o._mixin_data[o._type_info->mixin_index(id)].mixin();
+            if (info->trivially_copy_assignable)
+            {
+                copy_instances(target, source, *info);
+            }
+            else
+            {
+                DYNAMIX_THROW_UNLESS(info->copy_assignment, bad_copy_assignment);
+                info->copy_assignment(target, source);
+            }
         }
     }
 }
@@ -431,14 +871,25 @@ bool object::copyable() const noexcept
 
 void object::move_matching_from(object& o)
 {
+    invalidate_memos(*this);
+    invalidate_memos(o);
+
     for (auto* info : o._type_info->_compact_mixins)
     {
         auto id = info->id;
         if (_type_info->has(id))
         {
-            DYNAMIX_THROW_UNLESS(info->move_assignment, bad_move_assignment);
-            info->move_assignment(
-                _mixin_data[_type_info->mixin_index(id)].mixin(), o._mixin_data[o._type_info->mixin_index(id)].mixin());
+            void* target = _mixin_data[_type_info->mixin_index(id)].mixin();
+            void* source = o._mixin_data[o._type_info->mixin_index(id)].mixin();
+            if (info->trivially_move_assignable)
+            {
+                copy_instances(target, source, *info);
+            }
+            else
+            {
+                DYNAMIX_THROW_UNLESS(info->move_assignment, bad_move_assignment);
+                info->move_assignment(target, source);
+            }
         }
     }
 }
@@ -452,14 +903,15 @@ std::pair<char*, size_t> object::move_mixin(mixin_id id, char* buffer, size_t mi
     auto& data = _mixin_data[_type_info->mixin_index(id)];
     if (!data.mixin()) return std::pair<char*, size_t>(nullptr, 0);
 
-    auto& dom = domain::instance();
+    auto& dom = internal::domain::instance();
     const auto& mixin_info = dom.mixin_info(id);
     DYNAMIX_THROW_UNLESS(mixin_info.move_constructor, bad_mixin_move);
 
     auto old_data = data;
 
     data.set_buffer(buffer, mixin_offset);
-    data.set_object(this);
+    data.set_object(this, mixin_info.double_buffer_offset);
+    init_seqlock(data.mixin(), mixin_info.seqlock_offset);
 
     mixin_info.move_constructor(data.mixin(), old_data.mixin());
 
@@ -475,6 +927,9 @@ std::pair<char*, size_t> object::hard_replace_mixin(mixin_id id, char* buffer, s
     auto ret = std::make_pair(data.buffer(), data.mixin_offset());
     data.set_buffer(buffer, mixin_offset);
 
+    // the new buffer may have a mixin with a different state
+    invalidate_memos(*this);
+
     // not needed yet. It must be the user's responsibility
     // data.set_object(this);
 
@@ -492,12 +947,13 @@ void object::reallocate_mixins()
         auto old_data = data;
         I_DYNAMIX_ASSERT(data.buffer());
 
-        mixin_allocator* alloc = _allocator ? _allocator : mixin_info->allocator;
+        mixin_allocator* alloc = _allocator ? _allocator : _domain->mixin_allocator_for(*mixin_info);
 
         auto new_buf = alloc->alloc_mixin(*mixin_info, this);
 
         data.set_buffer(new_buf.first, new_buf.second);
-        data.set_object(this);
+        data.set_object(this, mixin_info->double_buffer_offset);
+        init_seqlock(data.mixin(), mixin_info->seqlock_offset);
 
         mixin_info->move_constructor(data.mixin(), old_data.mixin());
 
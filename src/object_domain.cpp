@@ -0,0 +1,495 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/object_domain.hpp"
+#include "dynamix/domain.hpp"
+#include "zero_memory.hpp"
+#include "dynamix/object_type_info.hpp"
+#include "dynamix/mutation_rule.hpp"
+#include "dynamix/object_type_mutation.hpp"
+#include "dynamix/allocators.hpp"
+#include "dynamix/memory_arena.hpp"
+#include "dynamix/type_class.hpp"
+#include "dynamix/trace.hpp"
+#include "dynamix/memo.hpp"
+
+#include <algorithm>
+#include <bitset>
+
+namespace dynamix
+{
+
+object_domain::object_domain()
+    : _is_global(false)
+{
+    internal::domain::safe_instance().register_object_domain(*this);
+}
+
+object_domain::object_domain(global_tag)
+    : _is_global(true)
+{
+}
+
+object_domain::~object_domain()
+{
+    // the type infos can be in the arena
+    _object_type_infos.clear();
+
+    if (!_is_global)
+    {
+        internal::domain::safe_instance().unregister_object_domain(*this);
+    }
+}
+
+object_domain& object_domain::global()
+{
+    return *internal::domain::safe_instance()._global_object_domain;
+}
+
+mutation_rule_id object_domain::add_mutation_rule(std::shared_ptr<mutation_rule> rule)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_mutation_rules_mutex);
+#endif
+
+    // find free slot
+    for (mutation_rule_id i = 0; i < _mutation_rules.size(); ++i)
+    {
+        auto& r = _mutation_rules[i];
+        if (!r)
+        {
+            r = rule;
+            return i;
+        }
+    }
+
+    _mutation_rules.emplace_back(std::move(rule));
+    return _mutation_rules.size() - 1;
+}
+
+std::shared_ptr<mutation_rule> object_domain::remove_mutation_rule(mutation_rule_id id)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_mutation_rules_mutex);
+#endif
+
+    if (id >= _mutation_rules.size()) return std::shared_ptr<mutation_rule>();
+
+    auto ret = _mutation_rules[id];
+    _mutation_rules[id].reset();
+    return ret;
+}
+
+void object_domain::apply_mutation_rules(object_type_mutation& mutation, const mixin_collection& source_mixins)
+{
+    {
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+        std::lock_guard<std::mutex> lock(_mutation_rules_mutex);
+#endif
+
+        for (auto& rule : _mutation_rules)
+        {
+            if (rule)
+            {
+                rule->apply_to(mutation, source_mixins);
+            }
+        }
+    }
+
+    // siblings are a property of the mixins, so they're required in all domains
+    // (the list may only be read without a lock when there are no unregistered lazy mixins)
+    auto& dom = internal::domain::instance();
+    if (dom._num_unregistered_lazy_mixins || !dom._mixins_with_siblings.empty())
+    {
+        dom.apply_sibling_requirements(mutation, source_mixins);
+    }
+}
+
+void object_domain::set_allocator(domain_allocator* allocator)
+{
+    if (_is_global)
+    {
+        // the global allocator is also set to the mixins
+        internal::domain::safe_instance().set_allocator(allocator);
+        return;
+    }
+
+    I_DYNAMIX_ASSERT(!_allocator || !_allocator->has_allocated());
+    _allocator = allocator;
+}
+
+domain_allocator* object_domain::allocator() const
+{
+    return _allocator ? _allocator : internal::domain::instance().allocator();
+}
+
+mixin_allocator* object_domain::mixin_allocator_for(const mixin_type_info& info) const
+{
+    // mixins which have the global allocator don't have one of their own
+    if (_allocator && info.allocator == internal::domain::instance().allocator())
+    {
+        return _allocator;
+    }
+
+    return info.allocator;
+}
+
+void object_domain::use_type_info_arena(bool huge_pages /*= false*/)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+#endif
+
+    I_DYNAMIX_ASSERT_MSG(_object_type_infos.empty(), "the domain already has object types");
+    _type_info_arena.reset(new memory_arena(memory_arena::HUGE_PAGE_SIZE, huge_pages));
+}
+
+void object_domain::type_info_deleter::operator()(object_type_info* type) const
+{
+    if (type->_domain)
+    {
+        type->_domain->release_call_table(*type);
+    }
+
+    if (type->_arena)
+    {
+        type->~object_type_info();
+    }
+    else
+    {
+        delete type;
+    }
+}
+
+object_type_info* object_domain::new_object_type_info()
+{
+    if (!_type_info_arena)
+    {
+        return new object_type_info;
+    }
+
+    auto memory = _type_info_arena->allocate(sizeof(object_type_info), alignof(object_type_info));
+    auto type = new (memory) object_type_info;
+    type->_arena = _type_info_arena.get();
+    return type;
+}
+
+void object_domain::set_call_table(object_type_info& type)
+{
+    auto& dom = internal::domain::instance();
+
+    internal::available_mixins_bitset implementers;
+    for (auto info : type._compact_mixins)
+    {
+        if (!info->message_infos.empty()) implementers[info->id] = true;
+    }
+
+    auto it = _call_tables.find(implementers);
+    if (it != _call_tables.end() && it->second->messages_version == dom._messages_version)
+    {
+        // a type with the same mixins implementing messages
+        // their mixin indices are the same, so are the call tables
+        auto table = it->second;
+        ++table->num_types;
+        type._shared_call_table = table;
+        type._call_table = table->entries;
+        return;
+    }
+
+    internal::shared_call_table* table;
+    if (_type_info_arena)
+    {
+        // at the start of a cache line
+        auto memory = _type_info_arena->allocate(sizeof(internal::shared_call_table), memory_arena::CACHE_LINE_SIZE);
+        table = new (memory) internal::shared_call_table;
+    }
+    else
+    {
+        table = new internal::shared_call_table;
+    }
+
+    internal::zero_memory(table->entries, sizeof(table->entries));
+    table->message_data_buffer = nullptr;
+    table->implementers = implementers;
+    table->messages_version = dom._messages_version;
+    table->num_types = 1;
+
+    type._shared_call_table = table;
+    type._call_table = table->entries;
+
+    // if this throws the table is released with the type
+    type.fill_call_table();
+
+    // replaces the table of the same mixins from before messages were registered (if any)
+    _call_tables[implementers] = table;
+}
+
+void object_domain::release_call_table(object_type_info& type)
+{
+    auto table = type._shared_call_table;
+    if (!table) return;
+    type._shared_call_table = nullptr;
+
+    if (--table->num_types) return;
+
+    auto it = _call_tables.find(table->implementers);
+    if (it != _call_tables.end() && it->second == table)
+    {
+        _call_tables.erase(it);
+    }
+
+    if (_type_info_arena)
+    {
+        // the memory of the table and its buffer is freed with the arena
+        table->~shared_call_table();
+    }
+    else
+    {
+        delete[] table->message_data_buffer;
+        delete table;
+    }
+}
+
+const object_type_info* object_domain::get_object_type_info(mixin_collection mixins)
+{
+    // the mixin type infos need to be sorted
+    // so as to guarantee that two object type infos of the same mixins
+    // will have the exact same content
+    I_DYNAMIX_ASSERT(std::is_sorted(mixins._compact_mixins.begin(), mixins._compact_mixins.end()));
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    // TODO C++17: do this with a shared mutex instead
+    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+#endif
+
+    object_type_info_map::iterator it = _object_type_infos.find(mixins._mixins);
+
+    if(it != _object_type_infos.end())
+    {
+        // get existing
+        // (its mixins are in the order of the mixin data, so they're not sorted)
+        I_DYNAMIX_ASSERT(mixins._compact_mixins.size() == it->second->_compact_mixins.size());
+        return it->second.get();
+    }
+    else
+    {
+        I_DYNAMIX_TRACE_SCOPE("create_type_info", "type");
+
+        auto& dom = internal::domain::instance();
+
+        // create object type info
+        // use unique_ptr since fill_call_table and fill_fact_table might throw
+        object_type_info_ptr new_type(new_object_type_info());
+        new_type->_mixins = mixins._mixins;
+        new_type->_domain = this;
+
+        // the mixins which implement messages are first in the mixin data, so that
+        // types which differ only by mixins which don't can share a call table
+        std::stable_partition(mixins._compact_mixins.begin(), mixins._compact_mixins.end(),
+            [](const mixin_type_info* info) { return !info->message_infos.empty(); });
+
+        uint32_t index = 0;
+        for(auto info : mixins._compact_mixins)
+        {
+            I_DYNAMIX_ASSERT(info);
+            new_type->_mixin_indices[info->id] = index + object_type_info::MIXIN_INDEX_OFFSET;
+            ++index;
+        }
+
+        new_type->_compact_mixins = std::move(mixins._compact_mixins);
+
+        for (auto info : new_type->_compact_mixins)
+        {
+            if (info->seqlock_offset) new_type->_has_seqlocked_mixins = true;
+
+            for (auto& link : info->required_siblings)
+            {
+                // null mixin index if the sibling is missing (no rules were applied for this type)
+                new_type->_sibling_indices[link.id] = new_type->_mixin_indices[link.sibling->id];
+            }
+        }
+
+        set_call_table(*new_type);
+        new_type->fill_fact_table();
+
+        {
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+            // type classes may be registered from other threads
+            std::lock_guard<std::mutex> registry_lock(internal::domain::safe_instance()._registry_mutex);
+#endif
+
+            // add matching type classes
+            for (auto tc : dom._type_classes)
+            {
+                if (tc && tc->matches(*new_type))
+                {
+                    new_type->_matching_type_classes.emplace_back(tc->id());
+                }
+            }
+        }
+
+        auto ret = new_type.get();
+        _object_type_infos.emplace(make_pair(std::move(mixins._mixins), std::move(new_type)));
+        index_type_info(ret);
+        return ret;
+    }
+}
+
+void object_domain::index_type_info(const object_type_info* type)
+{
+    if (_type_infos_by_mixin.empty())
+    {
+        _type_infos_by_mixin.resize(DYNAMIX_MAX_MIXINS);
+        _type_infos_by_message.resize(DYNAMIX_MAX_MESSAGES);
+    }
+
+    for (auto info : type->_compact_mixins)
+    {
+        _type_infos_by_mixin[info->id].push_back(type);
+
+        for (auto& msg : info->message_infos)
+        {
+            auto& types = _type_infos_by_message[msg.message->id];
+
+            // several mixins in the type may implement the message
+            if (types.empty() || types.back() != type)
+            {
+                types.push_back(type);
+            }
+        }
+    }
+}
+
+void object_domain::unindex_type_infos(const std::vector<const object_type_info*>& types)
+{
+    I_DYNAMIX_ASSERT(std::is_sorted(types.begin(), types.end()));
+
+    auto is_removed = [&types](const object_type_info* type)
+    {
+        return std::binary_search(types.begin(), types.end(), type);
+    };
+
+    // only touch the lists of the mixins and messages of the removed types
+    internal::available_mixins_bitset affected_mixins;
+    std::bitset<DYNAMIX_MAX_MESSAGES> affected_messages;
+    for (auto type : types)
+    {
+        for (auto info : type->_compact_mixins)
+        {
+            affected_mixins[info->id] = true;
+            for (auto& msg : info->message_infos)
+            {
+                affected_messages[msg.message->id] = true;
+            }
+        }
+    }
+
+    auto compact = [&is_removed](std::vector<const object_type_info*>& list)
+    {
+        list.erase(std::remove_if(list.begin(), list.end(), is_removed), list.end());
+    };
+
+    for (size_t i = 0; i < affected_mixins.size(); ++i)
+    {
+        if (affected_mixins[i]) compact(_type_infos_by_mixin[i]);
+    }
+
+    for (size_t i = 0; i < affected_messages.size(); ++i)
+    {
+        if (affected_messages[i]) compact(_type_infos_by_message[i]);
+    }
+}
+
+void object_domain::drop_type_infos(mixin_id id)
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+#endif
+
+    if (_type_infos_by_mixin.empty()) return; // no types were created
+
+    // uh-oh if there are still objects alive with this mixin? this is not supported
+    // I wish I could assert for it but it keeps firing on abnormal app termination
+    // we do support unregister with living objects if we're terminating
+    auto dropped = _type_infos_by_mixin[id];
+    std::sort(dropped.begin(), dropped.end());
+    erase_type_infos(dropped);
+}
+
+void object_domain::garbage_collect_type_infos()
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+#endif
+
+    std::vector<const object_type_info*> garbage;
+    for (auto& type : _object_type_infos)
+    {
+        if (type.second->num_objects == 0)
+        {
+            garbage.push_back(type.second.get());
+        }
+    }
+
+    std::sort(garbage.begin(), garbage.end());
+    erase_type_infos(garbage);
+}
+
+void object_domain::erase_type_infos(const std::vector<const object_type_info*>& types)
+{
+    if (types.empty()) return;
+
+    unindex_type_infos(types);
+
+    for (auto type : types)
+    {
+        auto it = _object_type_infos.find(type->_mixins);
+        I_DYNAMIX_ASSERT(it != _object_type_infos.end() && it->second.get() == type);
+        _object_type_infos.erase(it);
+    }
+}
+
+std::vector<const object_type_info*> object_domain::types_with_mixin(mixin_id id) const
+{
+    I_DYNAMIX_ASSERT(id < DYNAMIX_MAX_MIXINS);
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+#endif
+
+    if (_type_infos_by_mixin.empty()) return {};
+    return _type_infos_by_mixin[id];
+}
+
+std::vector<const object_type_info*> object_domain::types_with_mixin(const mixin_type_info& info) const
+{
+    return types_with_mixin(info.id);
+}
+
+std::vector<const object_type_info*> object_domain::types_implementing_message(feature_id id) const
+{
+    I_DYNAMIX_ASSERT(id < DYNAMIX_MAX_MESSAGES);
+
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+#endif
+
+    if (_type_infos_by_message.empty()) return {};
+    return _type_infos_by_message[id];
+}
+
+size_t object_domain::num_type_infos() const
+{
+#if DYNAMIX_THREAD_SAFE_MUTATIONS
+    std::lock_guard<std::mutex> lock(_object_type_infos_mutex);
+#endif
+
+    return _object_type_infos.size();
+}
+
+} // namespace dynamix
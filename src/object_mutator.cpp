@@ -11,7 +11,9 @@
 #include <dynamix/mixin_type_info.hpp>
 #include <dynamix/exception.hpp>
 #include <dynamix/domain.hpp>
+#include <dynamix/object_domain.hpp>
 #include <dynamix/object.hpp>
+#include <dynamix/trace.hpp>
 #include <algorithm>
 
 namespace dynamix
@@ -21,8 +23,9 @@ namespace internal
 
 object_mutator::object_mutator() = default;
 
-object_mutator::object_mutator(const mixin_collection* source_mixins)
+object_mutator::object_mutator(const mixin_collection* source_mixins, object_domain* domain /*= nullptr*/)
     : _source_mixins(source_mixins)
+    , _domain(domain)
 {}
 
 void object_mutator::cancel()
@@ -42,10 +45,17 @@ void object_mutator::create()
     }
     _is_created = true;
 
+    I_DYNAMIX_TRACE_SCOPE("create_mutation", "mutation");
+
     _mutation.normalize();
 
-    auto& dom = domain::safe_instance();
-    dom.apply_mutation_rules(_mutation, *_source_mixins);
+    // set by the derived class at the latest here
+    I_DYNAMIX_ASSERT(_domain);
+    auto& dom = *_domain;
+    {
+        I_DYNAMIX_TRACE_SCOPE("apply_mutation_rules", "mutation");
+        dom.apply_mutation_rules(_mutation, *_source_mixins);
+    }
 
     // in case the rules broke it somehow
     _mutation.normalize();
@@ -106,6 +116,9 @@ void object_mutator::apply_to(object& obj) const
     // we need to mutate only objects of the same type
     DYNAMIX_THROW_UNLESS(obj._type_info->as_mixin_collection() == _source_mixins, bad_mutation_source);
 
+    // and the same domain (empty objects have the same type in all domains)
+    DYNAMIX_THROW_UNLESS(&obj.domain() == _domain, bad_mutation_source);
+
     if(!_target_type_info)
     {
         // this is an empty mutation
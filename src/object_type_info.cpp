@@ -10,23 +10,43 @@
 #include "dynamix/mixin_type_info.hpp"
 #include "dynamix/object_type_info.hpp"
 #include "dynamix/domain.hpp"
+#include "dynamix/object_domain.hpp"
 #include "dynamix/allocators.hpp"
+#include "dynamix/memory_arena.hpp"
 #include "dynamix/exception.hpp"
 #include "dynamix/object.hpp"
 #include "dynamix/type_class.hpp"
+#include "dynamix/trace.hpp"
+#include "concurrent_mutations.hpp"
 #include <algorithm>
 
 namespace dynamix
 {
 
+// the call table of the null type info
+static const object_type_info::call_table_entry empty_call_table[DYNAMIX_MAX_MESSAGES] = {};
+
 object_type_info::object_type_info()
+    : _call_table(empty_call_table)
 {
     internal::zero_memory(_mixin_indices, sizeof(_mixin_indices));
-    internal::zero_memory(_call_table, sizeof(_call_table));
+    internal::zero_memory(_fact_table, sizeof(_fact_table));
+    internal::zero_memory(_sibling_indices, sizeof(_sibling_indices));
+    for (auto& t : _interface_tables)
+    {
+        t.store(nullptr, std::memory_order_relaxed);
+    }
 }
 
 object_type_info::~object_type_info()
 {
+    for (auto& t : _interface_tables)
+    {
+        delete[] t.load(std::memory_order_relaxed);
+    }
+
+    // the shared call table is released by the domain
+    I_DYNAMIX_ASSERT(!_shared_call_table);
 }
 
 static const object_type_info null_type_info;
@@ -36,29 +56,70 @@ const object_type_info& object_type_info::null()
     return null_type_info;
 };
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+
+// the type pointer is right in front of the mixin data
+// allocated arrays have a whole element for it, to keep the alignment simple
+static const size_t num_header_elements = 1;
+
+static struct
+{
+    const object_type_info* padding;
+    const object_type_info* type;
+    internal::mixin_data_in_object data;
+} null_mixin_data_with_type = { nullptr, &null_type_info, {} };
+
+internal::mixin_data_in_object* object_type_info::null_mixin_data()
+{
+    return &null_mixin_data_with_type.data;
+}
+
+#else
+static const size_t num_header_elements = 0;
+#endif
+
 internal::mixin_data_in_object* object_type_info::alloc_mixin_data(const object* obj) const
 {
-    const size_t num_to_allocate = _compact_mixins.size() + MIXIN_INDEX_OFFSET;
+    const size_t num_to_allocate = _compact_mixins.size() + MIXIN_INDEX_OFFSET + num_header_elements;
 
-    domain_allocator* alloc = obj->allocator() ? obj->allocator() : internal::domain::instance().allocator();
+    I_DYNAMIX_TRACE_SCOPE("alloc_mixin_data", "allocator");
+
+    domain_allocator* alloc = obj->allocator() ? obj->allocator() : obj->domain().allocator();
     char* memory = alloc->alloc_mixin_data(num_to_allocate, obj);
     internal::mixin_data_in_object* ret = new (memory) internal::mixin_data_in_object[num_to_allocate];
+    ret += num_header_elements;
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+    reinterpret_cast<const object_type_info**>(ret)[-1] = this;
+#endif
 
     return ret;
 }
 
 void object_type_info::dealloc_mixin_data(internal::mixin_data_in_object* data, const object* obj) const
 {
+    I_DYNAMIX_TRACE_SCOPE("dealloc_mixin_data", "allocator");
+
     const size_t num_mixins = _compact_mixins.size() + MIXIN_INDEX_OFFSET;
     for (size_t i = 0; i < num_mixins; ++i)
     {
         data[i].~mixin_data_in_object();
     }
 
-    domain_allocator* alloc = obj->allocator() ? obj->allocator() : internal::domain::instance().allocator();
-    alloc->dealloc_mixin_data(reinterpret_cast<char*>(data), num_mixins, obj);
+    domain_allocator* alloc = obj->allocator() ? obj->allocator() : obj->domain().allocator();
+    alloc->dealloc_mixin_data(reinterpret_cast<char*>(data - num_header_elements), num_mixins + num_header_elements, obj);
 }
 
+#if DYNAMIX_CONCURRENT_MUTATIONS
+void object_type_info::retire_mixin_data(internal::mixin_data_in_object* data, const object* obj) const
+{
+    // we can't rely on the object or the type being alive when the data is deallocated
+    const size_t count = _compact_mixins.size() + MIXIN_INDEX_OFFSET + num_header_elements;
+    domain_allocator* alloc = obj->allocator() ? obj->allocator() : obj->domain().allocator();
+    internal::retire_mixin_data(reinterpret_cast<char*>(data - num_header_elements), count, alloc, obj);
+}
+#endif
+
 bool object_type_info::is_a(const type_class& tc) const
 {
     if (tc.is_registered())
@@ -75,10 +136,11 @@ bool object_type_info::is_a(const type_class& tc) const
     }
 }
 
-object_type_info::call_table_message object_type_info::make_call_table_message(mixin_id id, const internal::message_for_mixin& data) const
+object_type_info::call_table_message object_type_info::make_call_table_message(const mixin_type_info& info, const internal::message_for_mixin& data) const
 {
     call_table_message ret;
-    ret.mixin_index = _mixin_indices[id];
+    ret.mixin_index = _mixin_indices[info.id];
+    ret.double_buffer_offset = uint32_t(info.double_buffer_offset);
     ret.caller = data.caller;
     ret.data = &data;
     return ret;
@@ -86,32 +148,38 @@ object_type_info::call_table_message object_type_info::make_call_table_message(m
 
 void object_type_info::fill_call_table()
 {
+    I_DYNAMIX_TRACE_SCOPE("fill_call_table", "type");
+
+    I_DYNAMIX_ASSERT(_shared_call_table);
+    call_table_entry* const call_table = _shared_call_table->entries;
+    call_table_message*& message_data_buffer = _shared_call_table->message_data_buffer;
+
     // first pass
     // find top bid messages and prepare to calculate message buffer length length
 
     intptr_t message_data_buffer_size = 0;
 
-    // in this pass we make use of the fact that _call_table begin starts as nullptr
+    // in this pass we make use of the fact that the begin of call table entries starts as nullptr
     // for a new type so we will use it as a counter
 
     for (const mixin_type_info* info : _compact_mixins)
     {
         for (const internal::message_for_mixin& msg : info->message_infos)
         {
-            call_table_entry& table_entry = _call_table[msg.message->id];
+            call_table_entry& table_entry = call_table[msg.message->id];
 
             if (msg.message->mechanism == internal::message_t::unicast)
             {
                 if (!table_entry.top_bid_message)
                 {
                     // new message
-                    table_entry.top_bid_message = make_call_table_message(info->id, msg);
+                    table_entry.top_bid_message = make_call_table_message(*info, msg);
                 }
                 else if (table_entry.top_bid_message.data->priority < msg.priority)
                 {
                     // we found bigger priority
                     // make it looks like a new message
-                    table_entry.top_bid_message = make_call_table_message(info->id, msg);
+                    table_entry.top_bid_message = make_call_table_message(*info, msg);
 
                     // also remove the top-priority size we've accumulated
                     message_data_buffer_size -= reinterpret_cast<intptr_t>(table_entry.begin) / sizeof(*table_entry.begin);
@@ -138,7 +206,7 @@ void object_type_info::fill_call_table()
                     // we have multiple bidders for the same priority
                     if (table_entry.top_bid_message.data->bid < msg.bid)
                     {
-                        table_entry.top_bid_message = make_call_table_message(info->id, msg);
+                        table_entry.top_bid_message = make_call_table_message(*info, msg);
                     }
                 }
             }
@@ -153,7 +221,7 @@ void object_type_info::fill_call_table()
 
                     // also set top bid message just so we mark it as implemented
                     // it won't actually be used for multicasts
-                    table_entry.top_bid_message = make_call_table_message(info->id, msg);
+                    table_entry.top_bid_message = make_call_table_message(*info, msg);
                 }
 
                 // again we use begin to set the size of the buffer this particular message needs
@@ -165,16 +233,26 @@ void object_type_info::fill_call_table()
 
     const internal::domain& dom = internal::domain::instance();
 
-    _message_data_buffer.reset(new call_table_message[message_data_buffer_size]);
-    auto message_data_buffer_ptr = _message_data_buffer.get();
+    if (_arena)
+    {
+        // next to the type info and aligned like its call table
+        auto memory = _arena->allocate(sizeof(call_table_message) * message_data_buffer_size, memory_arena::CACHE_LINE_SIZE);
+        // a trivial type, which is left uninitialized by new[] as well
+        message_data_buffer = static_cast<call_table_message*>(memory);
+    }
+    else
+    {
+        message_data_buffer = new call_table_message[message_data_buffer_size];
+    }
+    auto message_data_buffer_ptr = message_data_buffer;
 
     // second pass
-    // update begin and end pointers of _call_table and add message datas to buffer
+    // update begin and end pointers of the call table and add message datas to buffer
     for (const mixin_type_info* info : _compact_mixins)
     {
         for (const internal::message_for_mixin& msg : info->message_infos)
         {
-            call_table_entry& table_entry = _call_table[msg.message->id];
+            call_table_entry& table_entry = call_table[msg.message->id];
 
             if(table_entry.begin)
             {
@@ -192,7 +270,7 @@ void object_type_info::fill_call_table()
                         ++message_data_buffer_ptr;
                     }
 
-                    I_DYNAMIX_ASSERT(message_data_buffer_ptr - _message_data_buffer.get() <= message_data_buffer_size);
+                    I_DYNAMIX_ASSERT(message_data_buffer_ptr - message_data_buffer <= message_data_buffer_size);
                     table_entry.begin = begin;
                     table_entry.end = begin;
                 }
@@ -201,7 +279,7 @@ void object_type_info::fill_call_table()
                 {
                     // add all messages for multicasts
                     // add same-priority messages for unicasts
-                    *table_entry.end++ = make_call_table_message(info->id, msg);
+                    *table_entry.end++ = make_call_table_message(*info, msg);
                 }
             }
         }
@@ -217,7 +295,7 @@ void object_type_info::fill_call_table()
             continue;
         }
 
-        call_table_entry& table_entry = _call_table[i];
+        call_table_entry& table_entry = call_table[i];
 
         if (!table_entry.begin)
         {
@@ -292,7 +370,7 @@ void object_type_info::fill_call_table()
     // no messages with the same bid at the top-priority may exist
     for (size_t i = 0; i < dom._num_registered_messages; ++i)
     {
-        call_table_entry& table_entry = _call_table[i];
+        call_table_entry& table_entry = call_table[i];
 
         if (!table_entry.begin)
         {
@@ -331,7 +409,7 @@ void object_type_info::fill_call_table()
     // if we don't implement a message and it has a default implementation, set it
     for (size_t i = 0; i<dom._num_registered_messages; ++i)
     {
-        call_table_entry& table_entry = _call_table[i];
+        call_table_entry& table_entry = call_table[i];
 
         if (table_entry.top_bid_message)
         {
@@ -354,6 +432,7 @@ void object_type_info::fill_call_table()
         }
 
         table_entry.top_bid_message.mixin_index = DEFAULT_MSG_IMPL_INDEX;
+        table_entry.top_bid_message.double_buffer_offset = 0;
         table_entry.top_bid_message.caller = msg_data->default_impl_data->caller;
         table_entry.top_bid_message.data = msg_data->default_impl_data;
 
@@ -367,6 +446,54 @@ void object_type_info::fill_call_table()
     }
 }
 
+void object_type_info::fill_fact_table()
+{
+    // top provider for each fact and whether another provider has the same priority and bid
+    const internal::fact_for_mixin* top[DYNAMIX_MAX_FACTS] = {};
+    bool clash[DYNAMIX_MAX_FACTS] = {};
+
+    for (const mixin_type_info* info : _compact_mixins)
+    {
+        for (const internal::fact_for_mixin& fact : info->fact_infos)
+        {
+            const feature_id id = fact.fact->id;
+            auto& cur = top[id];
+
+            if (!cur || cur->priority < fact.priority
+                || (cur->priority == fact.priority && cur->bid < fact.bid))
+            {
+                cur = &fact;
+                clash[id] = false;
+            }
+            else if (cur->priority == fact.priority && cur->bid == fact.bid)
+            {
+                // a clash unless a higher provider comes later
+                clash[id] = true;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < DYNAMIX_MAX_FACTS; ++i)
+    {
+        if (!top[i]) continue;
+        DYNAMIX_THROW_UNLESS(!clash[i], fact_clash);
+        _fact_table[i] = top[i]->value.get();
+    }
+}
+
+size_t object_type_info::internal_num_implementers(feature_id id, const internal::fact_feature_tag&) const
+{
+    size_t ret = 0;
+    for (const mixin_type_info* info : _compact_mixins)
+    {
+        for (const internal::fact_for_mixin& fact : info->fact_infos)
+        {
+            if (fact.fact->id == id) ++ret;
+        }
+    }
+    return ret;
+}
+
 bool object_type_info::implements_message_by_mixin(feature_id id) const
 {
     auto& entry = _call_table[id];
@@ -9,6 +9,8 @@
 #include <dynamix/object_type_template.hpp>
 #include <dynamix/object_type_info.hpp>
 #include <dynamix/object.hpp>
+#include <dynamix/exception.hpp>
+#include "workload.hpp"
 
 using namespace std;
 
@@ -17,13 +19,19 @@ namespace dynamix
 
 using namespace internal;
 
-object_type_template::object_type_template()
-    : object_mutator(object_type_info::null().as_mixin_collection())
+object_type_template::object_type_template(object_domain& domain /*= object_domain::global()*/)
+    : object_mutator(object_type_info::null().as_mixin_collection(), &domain)
 {
 }
 
 void object_type_template::apply_to(object& o) const
 {
+    // check before clearing the object
+    DYNAMIX_THROW_UNLESS(&o.domain() == _domain, bad_mutation_source);
+
+    record_template_apply(o, _target_type_info ? _target_type_info : &object_type_info::null());
+    record_suppress_scope no_record;
+
     o.clear();
     object_mutator::apply_to(o);
 }
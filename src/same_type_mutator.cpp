@@ -11,6 +11,7 @@
 #include <dynamix/mixin_type_info.hpp>
 #include <dynamix/exception.hpp>
 #include <dynamix/object.hpp>
+#include <dynamix/object_domain.hpp>
 
 using namespace std;
 
@@ -22,7 +23,7 @@ same_type_mutator::same_type_mutator()
 }
 
 same_type_mutator::same_type_mutator(const object_type_info* info)
-    : object_mutator(info->as_mixin_collection())
+    : object_mutator(info->as_mixin_collection(), info->_domain ? info->_domain : &object_domain::global())
 {
 }
 
@@ -32,6 +33,7 @@ void same_type_mutator::apply_to(object& o)
     if(!_is_created)
     {
         _source_mixins = o._type_info->as_mixin_collection();
+        _domain = &o.domain();
         create();
     }
 
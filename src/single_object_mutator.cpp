@@ -44,6 +44,7 @@ single_object_mutator::~single_object_mutator()
 void single_object_mutator::apply()
 {
     _source_mixins = _object._type_info->as_mixin_collection();
+    _domain = &_object.domain();
     create();
     apply_to(_object);
     cancel(); // to go back to empty state
@@ -0,0 +1,100 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/teardown.hpp"
+#include "dynamix/object.hpp"
+#include "dynamix/object_type_info.hpp"
+#include "dynamix/trace.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace dynamix
+{
+
+namespace
+{
+
+template <typename GetObject>
+void teardown_objects(GetObject get, size_t count, const teardown_options& options)
+{
+    I_DYNAMIX_TRACE_SCOPE("teardown", "mutation");
+
+    auto destroy = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            get(i).teardown_destroy_mixins(options.call_destructors);
+        }
+    };
+
+    if (options.parallel_for && options.num_tasks > 1 && count > 1)
+    {
+        const size_t num_tasks = std::min(options.num_tasks, count);
+        const size_t per_task = (count + num_tasks - 1) / num_tasks;
+        options.parallel_for(num_tasks, [&](size_t task)
+        {
+            const size_t begin = task * per_task;
+            destroy(begin, std::min(begin + per_task, count));
+        });
+    }
+    else
+    {
+        destroy(0, count);
+    }
+
+    // the metrics are updated once per type
+    // objects of the same type are often next to each other, so the last one is checked first
+    std::unordered_map<const object_type_info*, size_t> objects_per_type;
+    const object_type_info* last_type = nullptr;
+    size_t* last_count = nullptr;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        object& o = get(i);
+        if (o.empty()) continue;
+
+        if (o._type_info != last_type)
+        {
+            last_type = o._type_info;
+            last_count = &objects_per_type[last_type];
+        }
+        ++*last_count;
+
+        o.teardown_release(options.release_memory);
+    }
+
+    for (auto& type_count : objects_per_type)
+    {
+        auto type = type_count.first;
+        auto n = type_count.second;
+
+        I_DYNAMIX_ASSERT(type->num_objects >= n);
+        type->num_objects -= n;
+
+        for (auto info : type->_compact_mixins)
+        {
+            I_DYNAMIX_ASSERT(info->num_mixins >= n);
+            info->num_mixins -= n;
+        }
+    }
+}
+
+} // anonymous namespace
+
+void teardown(object* const* objects, size_t count, const teardown_options& options)
+{
+    teardown_objects([objects](size_t i) -> object& { return *objects[i]; }, count, options);
+}
+
+void teardown(object* objects, size_t count, const teardown_options& options)
+{
+    teardown_objects([objects](size_t i) -> object& { return objects[i]; }, count, options);
+}
+
+} // namespace dynamix
@@ -0,0 +1,300 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "zero_memory.hpp"
+#include "dynamix/tick_scheduler.hpp"
+#include "dynamix/mixin_type_info.hpp"
+#include "dynamix/trace.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace dynamix
+{
+
+namespace
+{
+// only used in asserts
+inline bool is_valid_period(uint32_t period)
+{
+    // a power of two
+    return period && period <= tick_scheduler::MAX_PERIOD && !(period & (period - 1));
+}
+}
+
+tick_scheduler::tick_scheduler(uint32_t default_period)
+    : _default_period(default_period)
+{
+    I_DYNAMIX_ASSERT_MSG(is_valid_period(default_period), "periods must be powers of two");
+    internal::zero_memory(_mixin_periods, sizeof(_mixin_periods));
+}
+
+tick_scheduler::~tick_scheduler() = default;
+
+void tick_scheduler::set_mixin_period(mixin_id id, uint32_t period)
+{
+    I_DYNAMIX_ASSERT_MSG(!period || is_valid_period(period), "periods must be powers of two");
+    I_DYNAMIX_ASSERT(id < DYNAMIX_MAX_MIXINS);
+    if (_mixin_periods[id] == period) return;
+    _mixin_periods[id] = period;
+
+    std::vector<object*> affected;
+    for (auto& b : _buckets)
+    {
+        for (auto& slot : b.slots)
+        {
+            for (auto obj : slot)
+            {
+                if (obj->type_info().has(id)) affected.push_back(obj);
+            }
+        }
+    }
+
+    for (auto obj : affected)
+    {
+        rebucket(*obj);
+    }
+}
+
+uint32_t tick_scheduler::period_for(const object_type_info& type) const
+{
+    uint32_t ret = 0;
+    for (auto info : type._compact_mixins)
+    {
+        auto p = _mixin_periods[info->id];
+        if (p && (!ret || p < ret)) ret = p;
+    }
+    return ret ? ret : _default_period;
+}
+
+void tick_scheduler::add(object& obj)
+{
+    insert(obj, period_for(obj.type_info()), false);
+}
+
+void tick_scheduler::add(object& obj, uint32_t period)
+{
+    I_DYNAMIX_ASSERT_MSG(is_valid_period(period), "periods must be powers of two");
+    insert(obj, period, true);
+}
+
+void tick_scheduler::insert(object& obj, uint32_t period, bool explicit_period)
+{
+    I_DYNAMIX_ASSERT_MSG(!has(obj), "object is already in the scheduler");
+
+    auto b = std::lower_bound(_buckets.begin(), _buckets.end(), period,
+        [](const bucket& b, uint32_t p) { return b.period < p; });
+    if (b == _buckets.end() || b->period != period)
+    {
+        b = _buckets.insert(b, bucket());
+        b->period = period;
+        b->slots.resize(period);
+    }
+
+    if (_frame_load.size() < period)
+    {
+        // repeat the current load for the longer cycle
+        const size_t old_size = _frame_load.size();
+        _frame_load.resize(period);
+        for (size_t i = old_size; i < period; ++i)
+        {
+            _frame_load[i] = old_size ? _frame_load[i % old_size] : 0;
+        }
+    }
+
+    object_entry entry;
+    entry.period = period;
+    entry.slot = least_loaded_slot(period);
+    auto& slot = b->slots[entry.slot];
+    entry.index = uint32_t(slot.size());
+    entry.explicit_period = explicit_period;
+
+    slot.push_back(&obj);
+    add_load(period, entry.slot, 1);
+    _objects[&obj] = entry;
+}
+
+uint32_t tick_scheduler::least_loaded_slot(uint32_t period) const
+{
+    // the slot whose busiest frame is the least busy
+    // the frame of the current cycle is the first to break ties
+    // so new objects are called as soon as possible
+    const size_t cycle = _frame_load.size();
+    uint32_t best = 0;
+    size_t best_load = ~size_t(0);
+    for (uint32_t i = 0; i < period; ++i)
+    {
+        const uint32_t s = uint32_t((_frame + i) % period);
+        size_t load = 0;
+        for (size_t f = s; f < cycle; f += period)
+        {
+            load = std::max(load, _frame_load[f]);
+        }
+        if (load < best_load)
+        {
+            best_load = load;
+            best = s;
+        }
+    }
+    return best;
+}
+
+void tick_scheduler::add_load(uint32_t period, uint32_t slot, int delta)
+{
+    for (size_t f = slot; f < _frame_load.size(); f += period)
+    {
+        _frame_load[f] += delta;
+    }
+}
+
+void tick_scheduler::erase(object_entry& entry)
+{
+    auto b = std::lower_bound(_buckets.begin(), _buckets.end(), entry.period,
+        [](const bucket& b, uint32_t p) { return b.period < p; });
+    I_DYNAMIX_ASSERT(b != _buckets.end() && b->period == entry.period);
+
+    auto& slot = b->slots[entry.slot];
+    I_DYNAMIX_ASSERT(entry.index < slot.size());
+
+    // swap with the last one
+    if (entry.index != slot.size() - 1)
+    {
+        object* last = slot.back();
+        slot[entry.index] = last;
+        _objects[last].index = entry.index;
+    }
+    slot.pop_back();
+
+    add_load(entry.period, entry.slot, -1);
+}
+
+void tick_scheduler::remove(const object& obj)
+{
+    auto f = _objects.find(&obj);
+    if (f == _objects.end()) return;
+    erase(f->second);
+    _objects.erase(f);
+}
+
+bool tick_scheduler::has(const object& obj) const
+{
+    return _objects.find(&obj) != _objects.end();
+}
+
+void tick_scheduler::move_to_period(object& obj, object_entry& entry, uint32_t period)
+{
+    const bool explicit_period = entry.explicit_period;
+    if (entry.period == period) return;
+    erase(entry);
+    _objects.erase(&obj);
+    insert(obj, period, explicit_period);
+}
+
+void tick_scheduler::set_period(object& obj, uint32_t period)
+{
+    I_DYNAMIX_ASSERT_MSG(is_valid_period(period), "periods must be powers of two");
+    auto f = _objects.find(&obj);
+    I_DYNAMIX_ASSERT_MSG(f != _objects.end(), "object is not in the scheduler");
+    f->second.explicit_period = true;
+    move_to_period(obj, f->second, period);
+}
+
+void tick_scheduler::clear_period(object& obj)
+{
+    auto f = _objects.find(&obj);
+    I_DYNAMIX_ASSERT_MSG(f != _objects.end(), "object is not in the scheduler");
+    f->second.explicit_period = false;
+    move_to_period(obj, f->second, period_for(obj.type_info()));
+}
+
+void tick_scheduler::rebucket(object& obj)
+{
+    auto f = _objects.find(&obj);
+    if (f == _objects.end()) return;
+    if (f->second.explicit_period) return;
+    move_to_period(obj, f->second, period_for(obj.type_info()));
+}
+
+void tick_scheduler::on_mutations(const std::vector<mutation_event>& events)
+{
+    // only the last event of an object matters
+    // if the object became empty, it might have been destroyed, so it's not touched
+    std::unordered_set<const object*> done;
+    for (auto e = events.rbegin(); e != events.rend(); ++e)
+    {
+        if (!done.insert(e->obj).second) continue;
+
+        auto f = _objects.find(e->obj);
+        if (f == _objects.end()) continue;
+
+        if (e->new_type == &object_type_info::null())
+        {
+            erase(f->second);
+            _objects.erase(f);
+        }
+        else
+        {
+            // the object is alive
+            rebucket(*const_cast<object*>(e->obj));
+        }
+    }
+}
+
+uint32_t tick_scheduler::period(const object& obj) const
+{
+    auto f = _objects.find(&obj);
+    I_DYNAMIX_ASSERT_MSG(f != _objects.end(), "object is not in the scheduler");
+    return f->second.period;
+}
+
+std::vector<uint32_t> tick_scheduler::periods() const
+{
+    std::vector<uint32_t> ret;
+    for (auto& b : _buckets)
+    {
+        for (auto& slot : b.slots)
+        {
+            if (!slot.empty())
+            {
+                ret.push_back(b.period);
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
+size_t tick_scheduler::num_due() const
+{
+    size_t ret = 0;
+    for (auto& b : _buckets)
+    {
+        ret += b.slots[_frame % b.period].size();
+    }
+    return ret;
+}
+
+void tick_scheduler::collect_due(uint32_t period)
+{
+    I_DYNAMIX_TRACE_SCOPE("collect_due", "tick_scheduler");
+
+    _due.clear();
+    for (auto& b : _buckets)
+    {
+        if (period && b.period != period) continue;
+        for (auto obj : b.slots[_frame % b.period])
+        {
+            _due.emplace_back(obj->_type_info, obj);
+        }
+    }
+
+    // group by type, and keep the objects of a type in memory order
+    std::sort(_due.begin(), _due.end());
+}
+
+} // namespace dynamix
@@ -0,0 +1,251 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "dynamix/trace.hpp"
+#include "dynamix/internal/assert.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace dynamix
+{
+namespace trace
+{
+
+namespace
+{
+
+struct event
+{
+    const char* name;
+    const char* category;
+    const char* detail;
+    uint64_t begin; // nanoseconds since the trace epoch
+    uint64_t duration;
+};
+
+// ring buffer of events
+// it's only ever written by a single thread, so recording is lock free
+// the events themselves are not atomic, so they're only exported while the thread isn't recording
+// clear doesn't touch the head, which only the owning thread writes, but moves the start after it
+struct thread_buffer
+{
+    thread_buffer(size_t capacity, uint32_t tid)
+        : events(capacity)
+        , thread_id(tid)
+    {}
+
+    void push(const event& e)
+    {
+        auto h = head.load(std::memory_order_relaxed);
+        events[h % events.size()] = e;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    std::vector<event> events;
+    std::atomic<uint64_t> head = {0};
+    std::atomic<uint64_t> start = {0}; // events before it are cleared
+    const uint32_t thread_id;
+};
+
+struct tracer
+{
+    std::atomic<bool> enabled = {false};
+    std::atomic<uint32_t> message_sample_rate = {64};
+    std::atomic<size_t> buffer_capacity = {16 * 1024};
+
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    // buffers are only added here (once per thread) and outlive their threads
+    // so their events can be exported after the threads have exited
+    std::mutex buffers_mutex;
+    std::vector<std::unique_ptr<thread_buffer>> buffers;
+
+    thread_buffer* new_buffer()
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        auto id = uint32_t(buffers.size());
+        buffers.emplace_back(new thread_buffer(buffer_capacity.load(std::memory_order_relaxed), id));
+        return buffers.back().get();
+    }
+
+    uint64_t now() const
+    {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+};
+
+tracer& the_tracer()
+{
+    static tracer t;
+    return t;
+}
+
+thread_local thread_buffer* the_thread_buffer = nullptr;
+thread_local uint32_t the_message_counter = 0;
+
+// scopes are destroyed in noexcept functions (like object::clear)
+// so the event is dropped if the buffer of the thread can't be created
+void record(const event& e) noexcept
+{
+    if (!the_thread_buffer)
+    {
+        try
+        {
+            the_thread_buffer = the_tracer().new_buffer();
+        }
+        catch (...)
+        {
+            return;
+        }
+    }
+    the_thread_buffer->push(e);
+}
+
+void write_json_string(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (; *str; ++str)
+    {
+        char c = *str;
+        if (c == '"' || c == '\\') out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+        else out << c;
+    }
+    out << '"';
+}
+
+} // anonymous namespace
+
+void enable(bool enable) noexcept
+{
+    the_tracer().enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool is_enabled() noexcept
+{
+    return the_tracer().enabled.load(std::memory_order_relaxed);
+}
+
+void set_message_sample_rate(uint32_t n) noexcept
+{
+    the_tracer().message_sample_rate.store(n, std::memory_order_relaxed);
+}
+
+void set_buffer_capacity(size_t num_events) noexcept
+{
+    I_DYNAMIX_ASSERT(num_events > 0);
+    the_tracer().buffer_capacity.store(num_events, std::memory_order_relaxed);
+}
+
+void clear() noexcept
+{
+    auto& t = the_tracer();
+    std::lock_guard<std::mutex> lock(t.buffers_mutex);
+    for (auto& buf : t.buffers)
+    {
+        buf->start.store(buf->head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+void write_chrome_trace(std::ostream& out)
+{
+    auto& t = the_tracer();
+    std::lock_guard<std::mutex> lock(t.buffers_mutex);
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    auto saved_precision = out.precision(3);
+    auto saved_flags = out.setf(std::ios::fixed, std::ios::floatfield);
+    for (auto& buf : t.buffers)
+    {
+        const uint64_t head = buf->head.load(std::memory_order_acquire);
+        const uint64_t size = buf->events.size();
+        const uint64_t start = buf->start.load(std::memory_order_acquire);
+        const uint64_t begin = head - start > size ? head - size : start;
+
+        for (uint64_t i = begin; i < head; ++i)
+        {
+            const event& e = buf->events[i % size];
+
+            if (!first) out << ',';
+            first = false;
+
+            out << "\n{\"name\":";
+            write_json_string(out, e.name);
+            out << ",\"cat\":";
+            write_json_string(out, e.category);
+            // chrome traces use microseconds
+            out << ",\"ph\":\"X\",\"ts\":" << double(e.begin) / 1000
+                << ",\"dur\":" << double(e.duration) / 1000
+                << ",\"pid\":1,\"tid\":" << buf->thread_id;
+            if (e.detail)
+            {
+                out << ",\"args\":{\"detail\":";
+                write_json_string(out, e.detail);
+                out << '}';
+            }
+            out << '}';
+        }
+    }
+
+    out.precision(saved_precision);
+    out.flags(saved_flags);
+
+    out << "\n]}\n";
+}
+
+bool write_chrome_trace(const char* filename)
+{
+    std::ofstream fout(filename);
+    if (!fout) return false;
+    write_chrome_trace(fout);
+    return !!fout;
+}
+
+scope::scope(const char* name, const char* category, const char* detail) noexcept
+    : _name(name)
+    , _category(category)
+    , _detail(detail)
+{
+    auto& t = the_tracer();
+    if (!t.enabled.load(std::memory_order_relaxed)) return;
+    _active = true;
+    _begin = t.now();
+}
+
+scope::~scope() noexcept
+{
+    if (!_active) return;
+    auto end = the_tracer().now();
+    record({_name, _category, _detail, _begin, end - _begin});
+}
+
+message_scope::message_scope(const char* message_name) noexcept
+{
+    auto& t = the_tracer();
+    if (!t.enabled.load(std::memory_order_relaxed)) return;
+
+    auto rate = t.message_sample_rate.load(std::memory_order_relaxed);
+    if (!rate) return;
+    if (the_message_counter++ % rate) return;
+
+    _name = message_name;
+    _category = "message";
+    _active = true;
+    _begin = t.now();
+}
+
+} // namespace trace
+} // namespace dynamix
@@ -0,0 +1,700 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include "internal.hpp"
+#include "workload.hpp"
+#include "dynamix/workload.hpp"
+#include "dynamix/domain.hpp"
+#include "dynamix/mixin_type_info.hpp"
+#include "dynamix/object.hpp"
+#include "dynamix/object_type_info.hpp"
+#include "dynamix/object_type_template.hpp"
+#include "dynamix/single_object_mutator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace dynamix
+{
+
+namespace
+{
+
+// stream format
+// a header followed by records
+// each record is a one byte opcode followed by its operands
+// all integers are unsigned LEB128 varints
+
+const char MAGIC[4] = {'D', 'M', 'X', 'W'};
+const uint8_t VERSION = 1;
+
+enum opcode : uint8_t
+{
+    op_define_mixin = 1, // index, name
+    op_define_type, // index, num mixins, mixin indices...
+    op_define_message, // index, name, num args, arg sizes...
+    op_create, // object
+    op_destroy, // object
+    op_move, // target object, source object
+    op_mutate, // object, num added, mixin indices..., num removed, mixin indices...
+    op_apply_template, // object, type index
+    op_call, // object, message index
+};
+
+#if DYNAMIX_RECORD_WORKLOAD
+thread_local int suppress_depth = 0;
+#endif
+
+class recorder
+{
+public:
+    std::atomic<bool> recording = {false};
+
+    void start(std::ostream& out)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (recording) stop_no_lock();
+
+        _out = &out;
+        _out->write(MAGIC, sizeof(MAGIC));
+        _out->put(char(VERSION));
+
+        recording = true;
+    }
+
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stop_no_lock();
+    }
+
+    void create(const object& obj)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!recording) return;
+        auto id = _next_object_id++;
+        _objects[&obj] = id;
+        op(op_create);
+        varint(id);
+        flush_if_needed();
+    }
+
+    void destroy(const object& obj)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!recording) return;
+        auto f = _objects.find(&obj);
+        if (f == _objects.end()) return; // never referenced in the recording
+        op(op_destroy);
+        varint(f->second);
+        _objects.erase(f);
+        flush_if_needed();
+    }
+
+    void move(const object& to, const object& from)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!recording) return;
+        auto from_id = object_id(from, from._type_info);
+        // the target is either being constructed or was just cleared
+        auto to_id = object_id(to, &object_type_info::null());
+        op(op_move);
+        varint(to_id);
+        varint(from_id);
+        flush_if_needed();
+    }
+
+    void type_change(const object& obj, const object_type_info* old_type, const object_type_info* new_type)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!recording) return;
+        auto id = object_id(obj, old_type);
+        mutate(id, old_type, new_type);
+        flush_if_needed();
+    }
+
+    void template_apply(const object& obj, const object_type_info* type)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!recording) return;
+        auto id = object_id(obj, obj._type_info);
+        auto type_index = type_id(type);
+        op(op_apply_template);
+        varint(id);
+        varint(type_index);
+        flush_if_needed();
+    }
+
+    void message_call(const object& obj, const feature& msg, const uint32_t* arg_sizes, uint32_t num_args)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!recording) return;
+        auto id = object_id(obj, obj._type_info);
+
+        auto f = _messages.find(msg.id);
+        uint32_t msg_index;
+        if (f == _messages.end())
+        {
+            msg_index = uint32_t(_messages.size());
+            _messages.emplace(msg.id, msg_index);
+            op(op_define_message);
+            varint(msg_index);
+            string(msg.name);
+            varint(num_args);
+            for (uint32_t i = 0; i < num_args; ++i)
+            {
+                varint(arg_sizes[i]);
+            }
+        }
+        else
+        {
+            msg_index = f->second;
+        }
+
+        op(op_call);
+        varint(id);
+        varint(msg_index);
+        flush_if_needed();
+    }
+
+private:
+    void stop_no_lock()
+    {
+        if (!recording) return;
+        recording = false;
+        flush();
+        _out->flush();
+        _out = nullptr;
+        _next_object_id = 0;
+        _objects.clear();
+        _mixins.clear();
+        _types.clear();
+        _messages.clear();
+    }
+
+    // objects which existed before the recording started are implicitly created when first referenced
+    uint32_t object_id(const object& obj, const object_type_info* current_type)
+    {
+        auto f = _objects.find(&obj);
+        if (f != _objects.end()) return f->second;
+
+        auto id = _next_object_id++;
+        _objects[&obj] = id;
+        op(op_create);
+        varint(id);
+        mutate(id, &object_type_info::null(), current_type);
+        return id;
+    }
+
+    uint32_t mixin_id(const mixin_type_info* info)
+    {
+        auto f = _mixins.find(info);
+        if (f != _mixins.end()) return f->second;
+
+        auto index = uint32_t(_mixins.size());
+        _mixins.emplace(info, index);
+        op(op_define_mixin);
+        varint(index);
+        string(info->name);
+        return index;
+    }
+
+    uint32_t type_id(const object_type_info* type)
+    {
+        auto f = _types.find(type);
+        if (f != _types.end()) return f->second;
+
+        // define the mixins first
+        _indices.clear();
+        for (auto info : type->_compact_mixins)
+        {
+            _indices.push_back(mixin_id(info));
+        }
+
+        auto index = uint32_t(_types.size());
+        _types.emplace(type, index);
+        op(op_define_type);
+        varint(index);
+        varint(uint32_t(_indices.size()));
+        for (auto i : _indices) varint(i);
+        return index;
+    }
+
+    void mutate(uint32_t id, const object_type_info* old_type, const object_type_info* new_type)
+    {
+        if (old_type == new_type) return;
+
+        _indices.clear();
+        uint32_t num_added = 0;
+        for (auto info : new_type->_compact_mixins)
+        {
+            if (old_type->has(info->id)) continue;
+            _indices.push_back(mixin_id(info));
+            ++num_added;
+        }
+        for (auto info : old_type->_compact_mixins)
+        {
+            if (new_type->has(info->id)) continue;
+            _indices.push_back(mixin_id(info));
+        }
+
+        op(op_mutate);
+        varint(id);
+        varint(num_added);
+        for (uint32_t i = 0; i < num_added; ++i) varint(_indices[i]);
+        varint(uint32_t(_indices.size()) - num_added);
+        for (size_t i = num_added; i < _indices.size(); ++i) varint(_indices[i]);
+    }
+
+    void op(opcode o)
+    {
+        _buffer.push_back(char(o));
+    }
+
+    void varint(uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            _buffer.push_back(char(v | 0x80));
+            v >>= 7;
+        }
+        _buffer.push_back(char(v));
+    }
+
+    void string(const char* str)
+    {
+        auto len = strlen(str);
+        varint(len);
+        _buffer.insert(_buffer.end(), str, str + len);
+    }
+
+    void flush()
+    {
+        _out->write(_buffer.data(), std::streamsize(_buffer.size()));
+        _buffer.clear();
+    }
+
+    void flush_if_needed()
+    {
+        if (_buffer.size() > 64 * 1024) flush();
+    }
+
+    std::mutex _mutex;
+    std::ostream* _out = nullptr;
+    std::vector<char> _buffer;
+    std::vector<uint32_t> _indices; // temporary
+
+    uint32_t _next_object_id = 0;
+    std::unordered_map<const object*, uint32_t> _objects;
+    std::unordered_map<const mixin_type_info*, uint32_t> _mixins;
+    std::unordered_map<const object_type_info*, uint32_t> _types;
+    std::unordered_map<feature_id, uint32_t> _messages;
+};
+
+recorder& the_recorder()
+{
+    static recorder r;
+    return r;
+}
+
+} // anonymous namespace
+
+namespace internal
+{
+
+#if DYNAMIX_RECORD_WORKLOAD
+void record_object_create(const object& obj)
+{
+    auto& r = the_recorder();
+    if (!r.recording.load(std::memory_order_relaxed)) return;
+    r.create(obj);
+}
+
+void record_object_destroy(const object& obj)
+{
+    auto& r = the_recorder();
+    if (!r.recording.load(std::memory_order_relaxed)) return;
+    r.destroy(obj);
+}
+
+void record_object_move(const object& to, const object& from)
+{
+    auto& r = the_recorder();
+    if (!r.recording.load(std::memory_order_relaxed)) return;
+    r.move(to, from);
+}
+
+void record_type_change(const object& obj, const object_type_info* old_type, const object_type_info* new_type)
+{
+    auto& r = the_recorder();
+    if (!r.recording.load(std::memory_order_relaxed)) return;
+    if (suppress_depth) return;
+    r.type_change(obj, old_type, new_type);
+}
+
+void record_template_apply(const object& obj, const object_type_info* type)
+{
+    auto& r = the_recorder();
+    if (!r.recording.load(std::memory_order_relaxed)) return;
+    r.template_apply(obj, type);
+}
+
+record_suppress_scope::record_suppress_scope()
+{
+    ++suppress_depth;
+}
+
+record_suppress_scope::~record_suppress_scope()
+{
+    --suppress_depth;
+}
+#endif
+
+void record_message_call(const object& obj, const feature& msg, const uint32_t* arg_sizes, uint32_t num_args)
+{
+    auto& r = the_recorder();
+    if (!r.recording.load(std::memory_order_relaxed)) return;
+    r.message_call(obj, msg, arg_sizes, num_args);
+}
+
+} // namespace internal
+
+namespace workload
+{
+
+void start_recording(std::ostream& out)
+{
+    the_recorder().start(out);
+}
+
+void stop_recording()
+{
+    the_recorder().stop();
+}
+
+bool is_recording() noexcept
+{
+    return the_recorder().recording.load(std::memory_order_relaxed);
+}
+
+struct replayer::data
+{
+    struct op
+    {
+        opcode code;
+        uint32_t a; // object or target object
+        uint32_t b; // source object, type, message or offset in mixin_lists
+        uint32_t num_added;
+        uint32_t num_removed;
+    };
+
+    std::vector<op> ops;
+    std::vector<uint32_t> mixin_lists; // mixin indices of mutations
+    std::vector<std::string> mixin_names;
+    std::vector<std::vector<uint32_t>> types;
+    std::vector<std::string> message_names;
+    std::unordered_map<std::string, message_handler> handlers;
+    uint32_t num_objects = 0;
+};
+
+replayer::replayer()
+    : _data(new data)
+{}
+
+replayer::~replayer() = default;
+
+namespace
+{
+struct stream_reader
+{
+    stream_reader(std::istream& i) : in(i) {}
+
+    std::istream& in;
+    bool ok = true;
+
+    uint32_t varint()
+    {
+        uint64_t ret = 0;
+        int shift = 0;
+        for (;;)
+        {
+            int c = in.get();
+            if (c == EOF || shift > 35)
+            {
+                ok = false;
+                return 0;
+            }
+            ret |= uint64_t(c & 0x7f) << shift;
+            if (!(c & 0x80)) break;
+            shift += 7;
+        }
+        return uint32_t(ret);
+    }
+
+    std::string string()
+    {
+        auto len = varint();
+        std::string ret;
+
+        // read in blocks so a bad length fails at the end of the stream instead of allocating it
+        char block[256];
+        while (ok && len)
+        {
+            auto n = std::min(len, uint32_t(sizeof(block)));
+            if (!in.read(block, n)) ok = false;
+            else ret.append(block, n);
+            len -= n;
+        }
+        return ret;
+    }
+
+    // fails unless the condition is met
+    void check(bool condition)
+    {
+        ok = ok && condition;
+    }
+};
+
+// the recorder defines everything with consecutive indices
+template <typename T>
+bool define_next(std::vector<T>& vec, uint32_t index, T&& value)
+{
+    if (index != vec.size()) return false;
+    vec.push_back(std::move(value));
+    return true;
+}
+}
+
+bool replayer::load(std::istream& in)
+{
+    _data.reset(new data);
+    auto& d = *_data;
+
+    char header[sizeof(MAGIC) + 1];
+    if (!in.read(header, sizeof(header))) return false;
+    if (memcmp(header, MAGIC, sizeof(MAGIC)) != 0 || header[sizeof(MAGIC)] != char(VERSION)) return false;
+
+    stream_reader r(in);
+
+    // the objects which are alive at each point of the stream
+    // the ops may only reference those
+    std::vector<bool> alive;
+    auto is_alive = [&alive](uint32_t obj) { return obj < alive.size() && alive[obj]; };
+
+    for (;;)
+    {
+        int c = in.get();
+        if (c == EOF) break;
+
+        data::op o = {opcode(c), 0, 0, 0, 0};
+        switch (o.code)
+        {
+        case op_define_mixin:
+        {
+            auto index = r.varint();
+            auto name = r.string();
+            r.check(define_next(d.mixin_names, index, std::move(name)));
+        }
+        break;
+        case op_define_type:
+        {
+            auto index = r.varint();
+            auto num_mixins = r.varint();
+            std::vector<uint32_t> mixins;
+            for (uint32_t i = 0; i < num_mixins && r.ok; ++i)
+            {
+                mixins.push_back(r.varint());
+                r.check(mixins.back() < d.mixin_names.size());
+            }
+            r.check(define_next(d.types, index, std::move(mixins)));
+        }
+        break;
+        case op_define_message:
+        {
+            auto index = r.varint();
+            auto name = r.string();
+            r.check(define_next(d.message_names, index, std::move(name)));
+            // argument sizes are informative only
+            auto num_args = r.varint();
+            for (uint32_t i = 0; i < num_args && r.ok; ++i) r.varint();
+        }
+        break;
+        case op_create:
+            o.a = r.varint();
+            // object ids are never reused
+            r.check(o.a == d.num_objects);
+            d.num_objects = o.a + 1;
+            alive.push_back(true);
+            d.ops.push_back(o);
+            break;
+        case op_destroy:
+            o.a = r.varint();
+            r.check(is_alive(o.a));
+            if (r.ok) alive[o.a] = false;
+            d.ops.push_back(o);
+            break;
+        case op_move:
+            o.a = r.varint();
+            o.b = r.varint();
+            r.check(is_alive(o.a) && is_alive(o.b) && o.a != o.b);
+            d.ops.push_back(o);
+            break;
+        case op_apply_template:
+            o.a = r.varint();
+            o.b = r.varint();
+            r.check(is_alive(o.a) && o.b < d.types.size());
+            d.ops.push_back(o);
+            break;
+        case op_call:
+            o.a = r.varint();
+            o.b = r.varint();
+            r.check(is_alive(o.a) && o.b < d.message_names.size());
+            d.ops.push_back(o);
+            break;
+        case op_mutate:
+            o.a = r.varint();
+            r.check(is_alive(o.a));
+            o.b = uint32_t(d.mixin_lists.size());
+            o.num_added = r.varint();
+            for (uint32_t i = 0; i < o.num_added && r.ok; ++i) d.mixin_lists.push_back(r.varint());
+            o.num_removed = r.varint();
+            for (uint32_t i = 0; i < o.num_removed && r.ok; ++i) d.mixin_lists.push_back(r.varint());
+            for (auto i = o.b; i < d.mixin_lists.size(); ++i)
+            {
+                r.check(d.mixin_lists[i] < d.mixin_names.size());
+            }
+            d.ops.push_back(o);
+            break;
+        default:
+            r.ok = false;
+        }
+
+        if (!r.ok)
+        {
+            _data.reset(new data);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void replayer::set_message_handler(const char* message_name, message_handler handler)
+{
+    _data->handlers[message_name] = std::move(handler);
+}
+
+size_t replayer::num_events() const
+{
+    return _data->ops.size();
+}
+
+replay_stats replayer::run()
+{
+    auto& d = *_data;
+    replay_stats stats;
+
+    auto& dom = internal::domain::instance();
+
+    // resolve everything by name before starting
+    std::vector<mixin_id> mixins;
+    mixins.reserve(d.mixin_names.size());
+    for (auto& name : d.mixin_names)
+    {
+        auto id = dom.get_mixin_id_by_name(name.c_str());
+        if (id == INVALID_MIXIN_ID) ++stats.num_unresolved_mixins;
+        mixins.push_back(id);
+    }
+
+    std::vector<std::unique_ptr<object_type_template>> templates;
+    for (auto& type : d.types)
+    {
+        templates.emplace_back(new object_type_template);
+        for (auto m : type)
+        {
+            if (mixins[m] != INVALID_MIXIN_ID) templates.back()->add(mixins[m]);
+        }
+        templates.back()->create();
+    }
+
+    std::vector<const message_handler*> handlers;
+    for (auto& name : d.message_names)
+    {
+        auto f = d.handlers.find(name);
+        handlers.push_back(f == d.handlers.end() ? nullptr : &f->second);
+    }
+
+    std::vector<std::unique_ptr<object>> objects(d.num_objects);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto& o : d.ops)
+    {
+        switch (o.code)
+        {
+        case op_create:
+            objects[o.a].reset(new object(_allocator));
+            ++stats.num_objects;
+            break;
+        case op_destroy:
+            objects[o.a].reset();
+            break;
+        case op_move:
+            if (objects[o.a]) *objects[o.a] = std::move(*objects[o.b]);
+            else objects[o.a].reset(new object(std::move(*objects[o.b])));
+            break;
+        case op_mutate:
+        {
+            single_object_mutator mutator(*objects[o.a]);
+            auto list = d.mixin_lists.data() + o.b;
+            for (uint32_t i = 0; i < o.num_added; ++i)
+            {
+                if (mixins[list[i]] != INVALID_MIXIN_ID) mutator.add(mixins[list[i]]);
+            }
+            list += o.num_added;
+            for (uint32_t i = 0; i < o.num_removed; ++i)
+            {
+                if (mixins[list[i]] != INVALID_MIXIN_ID) mutator.remove(mixins[list[i]]);
+            }
+            ++stats.num_mutations;
+        }
+        break;
+        case op_apply_template:
+            templates[o.b]->apply_to(*objects[o.a]);
+            ++stats.num_mutations;
+            break;
+        case op_call:
+            if (handlers[o.b])
+            {
+                (*handlers[o.b])(*objects[o.a]);
+                ++stats.num_messages;
+            }
+            else
+            {
+                ++stats.num_skipped_messages;
+            }
+            break;
+        default:
+            I_DYNAMIX_ASSERT(false);
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    stats.seconds = std::chrono::duration<double>(end - start).count();
+
+    return stats;
+}
+
+} // namespace workload
+} // namespace dynamix
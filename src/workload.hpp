@@ -0,0 +1,58 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#pragma once
+
+// internal hooks of the workload recorder
+// they're only compiled with DYNAMIX_RECORD_WORKLOAD and are empty otherwise
+
+#include "dynamix/config.hpp"
+
+namespace dynamix
+{
+
+class object;
+class object_type_info;
+
+namespace internal
+{
+
+#if DYNAMIX_RECORD_WORKLOAD
+
+void record_object_create(const object& obj);
+void record_object_destroy(const object& obj);
+void record_object_move(const object& to, const object& from);
+void record_type_change(const object& obj, const object_type_info* old_type, const object_type_info* new_type);
+void record_template_apply(const object& obj, const object_type_info* type);
+
+// type changes are not recorded while an instance of this is alive in the thread
+// (used when the change is recorded as a different event)
+class record_suppress_scope
+{
+public:
+    record_suppress_scope();
+    ~record_suppress_scope();
+};
+
+#else
+
+inline void record_object_create(const object&) {}
+inline void record_object_destroy(const object&) {}
+inline void record_object_move(const object&, const object&) {}
+inline void record_type_change(const object&, const object_type_info*, const object_type_info*) {}
+inline void record_template_apply(const object&, const object_type_info*) {}
+
+class record_suppress_scope
+{
+public:
+    record_suppress_scope() {}
+};
+
+#endif
+
+}
+}
@@ -0,0 +1,169 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/adaptive_allocator.hpp>
+#include <dynamix/object_domain.hpp>
+
+#include "doctest/doctest.h"
+
+#include <memory>
+#include <vector>
+
+TEST_SUITE_BEGIN("adaptive allocator");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(popular);
+DYNAMIX_DECLARE_MIXIN(rare);
+
+class popular
+{
+public:
+    int val = 0;
+};
+
+class rare
+{
+public:
+    double d[3] = {};
+};
+
+adaptive_allocator::policy test_policy()
+{
+    adaptive_allocator::policy p;
+    p.pool_population = 8;
+    p.heap_population = 2;
+    p.pool_allocation_rate = 0;
+    p.first_chunk_slots = 4;
+    return p;
+}
+
+template <typename Mixin>
+mixin_id id_of()
+{
+    return _dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr)).id;
+}
+
+TEST_CASE("population")
+{
+    adaptive_allocator alloc(test_policy());
+    object_domain d;
+    d.set_allocator(&alloc);
+
+    std::vector<std::unique_ptr<object>> objects;
+    for (int i = 0; i < 20; ++i)
+    {
+        objects.emplace_back(new object(d));
+        mutate(*objects.back()).add<popular>();
+    }
+    object r(d);
+    mutate(r).add<rare>();
+
+    CHECK(alloc.strategy_of(id_of<popular>()) == adaptive_allocator::strategy::pool);
+    CHECK(alloc.strategy_of(id_of<rare>()) == adaptive_allocator::strategy::heap);
+
+    // the 8th and the next ones are pooled
+    auto s = alloc.stats(id_of<popular>());
+    CHECK(s.population == 20);
+    CHECK(s.pooled == 13);
+    CHECK(s.pool_capacity == 16); // 4 + 4 + 8
+    CHECK(s.num_switches == 1);
+
+    CHECK(alloc.stats(id_of<rare>()).population == 1);
+    CHECK(alloc.stats(id_of<rare>()).pooled == 0);
+
+    auto ds = alloc.decisions();
+    REQUIRE(ds.size() == 1);
+    CHECK(ds[0].id == id_of<popular>());
+    CHECK(ds[0].to == adaptive_allocator::strategy::pool);
+    CHECK(ds[0].population == 8);
+
+    // back to the heap when the population drops, and the pool is released once it's empty
+    objects.resize(2);
+    s = alloc.stats(id_of<popular>());
+    CHECK(s.current == adaptive_allocator::strategy::heap);
+    CHECK(s.population == 2);
+    CHECK(s.pooled == 0);
+    CHECK(s.pool_capacity == 0); // released
+    CHECK(alloc.decisions().size() == 2);
+
+    objects.clear();
+    CHECK(alloc.stats(id_of<popular>()).population == 0);
+}
+
+TEST_CASE("migrate")
+{
+    adaptive_allocator alloc(test_policy());
+    object_domain d;
+    d.set_allocator(&alloc);
+
+    std::vector<std::unique_ptr<object>> objects;
+    for (int i = 0; i < 10; ++i)
+    {
+        objects.emplace_back(new object(d));
+        mutate(*objects.back()).add<popular>();
+        objects.back()->get<popular>()->val = i;
+    }
+
+    // the first 7 are on the heap, the last 3 in the pool
+    CHECK(alloc.stats(id_of<popular>()).pooled == 3);
+
+    // leave two pooled ones
+    objects.erase(objects.begin(), objects.begin() + 8);
+    auto s = alloc.stats(id_of<popular>());
+    CHECK(s.current == adaptive_allocator::strategy::heap);
+    CHECK(s.pooled == 2);
+    CHECK(s.pool_capacity == 4); // kept while it has instances
+
+    auto& o = *objects[0];
+    auto old = o.get<popular>();
+    CHECK(alloc.migrate(o) == 1);
+    CHECK(o.get<popular>() != old);
+    CHECK(o.get<popular>()->val == 8);
+    CHECK(object_of(o.get<popular>()) == &o);
+    CHECK(alloc.stats(id_of<popular>()).pooled == 1);
+
+    // already where it should be
+    CHECK(alloc.migrate(o) == 0);
+
+    CHECK(alloc.migrate(*objects[1]) == 1);
+    CHECK(objects[1]->get<popular>()->val == 9);
+    s = alloc.stats(id_of<popular>());
+    CHECK(s.population == 2);
+    CHECK(s.pooled == 0);
+    CHECK(s.pool_capacity == 0);
+}
+
+TEST_CASE("allocation rate")
+{
+    auto p = test_policy();
+    p.pool_population = 1000;
+    p.pool_allocation_rate = 1000;
+    p.rate_window = std::chrono::milliseconds(0);
+    adaptive_allocator alloc(p);
+    object_domain d;
+    d.set_allocator(&alloc);
+
+    // a single mixin which is added and removed many times
+    object o(d);
+    for (int i = 0; i < 64; ++i)
+    {
+        mutate(o).add<rare>();
+        mutate(o).remove<rare>();
+    }
+
+    auto ds = alloc.decisions();
+    REQUIRE(!ds.empty());
+    CHECK(ds[0].id == id_of<rare>());
+    CHECK(ds[0].to == adaptive_allocator::strategy::pool);
+    CHECK(ds[0].population == 1);
+    CHECK(ds[0].allocation_rate >= 1000);
+}
+
+DYNAMIX_DEFINE_MIXIN(popular, none);
+DYNAMIX_DEFINE_MIXIN(rare, none);
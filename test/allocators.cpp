@@ -7,6 +7,7 @@
 //
 #include <dynamix/core.hpp>
 #include <dynamix/allocators.hpp>
+#include <dynamix/object_domain.hpp>
 
 #include <cstring>
 #include <set>
@@ -23,6 +24,7 @@ DYNAMIX_DECLARE_MIXIN(custom_1);
 DYNAMIX_DECLARE_MIXIN(custom_2_a);
 DYNAMIX_DECLARE_MIXIN(custom_2_b);
 DYNAMIX_DECLARE_MIXIN(custom_own_var);
+DYNAMIX_DECLARE_MIXIN(throwing);
 
 template <typename T>
 struct alloc_counter
@@ -44,6 +46,14 @@ size_t alloc_counter<T>::mixin_deallocations;
 
 const object* the_object = nullptr;
 
+// mutations which keep the number of mixins reuse the mixin data and the buffers
+// of removed mixins, except with concurrent mutations, where readers may still use them
+#if DYNAMIX_CONCURRENT_MUTATIONS
+const size_t reuse = 0;
+#else
+const size_t reuse = 1;
+#endif
+
 template <typename T>
 struct custom_allocator : public domain_allocator, public alloc_counter<T>
 {
@@ -188,8 +198,9 @@ TEST_CASE("allocators")
             .remove<custom_2_a>()
             .add<custom_2_b>();
 
-        CHECK(alloc_counter<global_alloc>::data_allocations == 5); // 1 + 4 new objects
-        CHECK(alloc_counter<global_alloc>::data_deallocations == 2); // 1 + 1 changed object
+        // the changed object has the same number of mixins, so it reuses its mixin data
+        CHECK(alloc_counter<global_alloc>::data_allocations == 5 - reuse); // 1 + 3 new objects (+ 1 changed)
+        CHECK(alloc_counter<global_alloc>::data_deallocations == 2 - reuse); // 1 (+ 1 changed)
 
         CHECK(alloc_counter<global_alloc>::mixin_allocations == 6); // 2 + 4
         CHECK(alloc_counter<custom_alloc_1>::mixin_allocations == 3); // 1 + 3
@@ -199,7 +210,7 @@ TEST_CASE("allocators")
         the_object = nullptr;
     }
 
-    CHECK(alloc_counter<global_alloc>::data_deallocations == 5);
+    CHECK(alloc_counter<global_alloc>::data_deallocations == 5 - reuse);
 
     CHECK(alloc_counter<global_alloc>::mixin_allocations == 6); // 2 + 4
     CHECK(alloc_counter<custom_alloc_1>::mixin_allocations == 3); // 1 + 3
@@ -486,8 +497,9 @@ TEST_CASE("object allocator")
             .add<normal_b>();
     }
 
-    CHECK(object_allocator_a::data_allocations == 2);
-    CHECK(object_allocator_a::data_deallocations == 2);
+    // the mixin data is reused when normal_a is swapped for normal_b
+    CHECK(object_allocator_a::data_allocations == 2 - reuse);
+    CHECK(object_allocator_a::data_deallocations == 2 - reuse);
     CHECK(object_allocator_a::mixin_allocations == 4);
     CHECK(object_allocator_a::mixin_deallocations == 4);
     CHECK(alloc_counter<custom_alloc_var>::mixin_allocations == 0);
@@ -526,8 +538,8 @@ TEST_CASE("object allocator")
         the_object = &o2;
     }
 
-    CHECK(object_allocator_a::data_allocations == 3);
-    CHECK(object_allocator_a::data_deallocations == 3);
+    CHECK(object_allocator_a::data_allocations == 3 - reuse);
+    CHECK(object_allocator_a::data_deallocations == 3 - reuse);
     CHECK(object_allocator_a::mixin_allocations == 8);
     CHECK(object_allocator_a::mixin_deallocations == 8);
     CHECK(alloc_counter<custom_alloc_var>::mixin_allocations == 1);
@@ -571,6 +583,97 @@ TEST_CASE("object allocator")
     CHECK(alloc_b.objects.empty());
 }
 
+class reusing_alloc : public custom_allocator<reusing_alloc>
+{
+public:
+    virtual bool can_reuse_mixin_buffer(const mixin_type_info& freed, const mixin_type_info& needed) const override
+    {
+        return _dda.can_reuse_mixin_buffer(freed, needed);
+    }
+};
+
+TEST_CASE("buffer reuse")
+{
+    reusing_alloc alloc;
+    object_domain d;
+    d.set_allocator(&alloc);
+
+    {
+        object o(d);
+        the_object = &o;
+
+        const auto custom_2_allocations = alloc_counter<custom_alloc_2>::mixin_allocations;
+        const auto custom_2_deallocations = alloc_counter<custom_alloc_2>::mixin_deallocations;
+
+        mutate(o).add<normal_a>().add<custom_2_a>();
+        CHECK(reusing_alloc::data_allocations == 1);
+        CHECK(reusing_alloc::mixin_allocations == 1);
+        CHECK(alloc_counter<custom_alloc_2>::mixin_allocations == custom_2_allocations + 1);
+        auto a = o.get<normal_a>();
+
+        // same size and alignment and the allocator allows it
+        mutate(o).remove<normal_a>().add<normal_b>();
+        CHECK(reusing_alloc::data_allocations == 2 - reuse);
+        CHECK(reusing_alloc::mixin_allocations == 2 - reuse);
+        CHECK(reusing_alloc::mixin_deallocations == 1 - reuse);
+        CHECK((static_cast<void*>(o.get<normal_b>()) == static_cast<void*>(a)) == !!reuse);
+        CHECK(object_of(o.get<normal_b>()) == &o);
+
+        // custom_alloc_2 doesn't allow reuse
+        mutate(o).remove<custom_2_a>().add<custom_2_b>();
+        CHECK(alloc_counter<custom_alloc_2>::mixin_allocations == custom_2_allocations + 2);
+        CHECK(alloc_counter<custom_alloc_2>::mixin_deallocations == custom_2_deallocations + 1);
+        CHECK(reusing_alloc::data_allocations == 3 - 2 * reuse);
+
+        // a different number of mixins needs new mixin data
+        mutate(o).remove<normal_b>();
+        CHECK(reusing_alloc::data_allocations == 4 - 2 * reuse);
+        CHECK(reusing_alloc::data_deallocations == 3 - 2 * reuse);
+        CHECK(reusing_alloc::mixin_deallocations == 2 - reuse);
+        CHECK(o.has<custom_2_b>());
+
+        the_object = nullptr;
+    }
+
+    CHECK(reusing_alloc::data_deallocations == reusing_alloc::data_allocations);
+    CHECK(reusing_alloc::mixin_allocations == reusing_alloc::mixin_deallocations);
+}
+
+// buffers are only kept for reuse without concurrent mutations
+#if DYNAMIX_USE_EXCEPTIONS && !DYNAMIX_CONCURRENT_MUTATIONS
+struct construction_error {};
+
+TEST_CASE("buffer reuse with a throwing constructor")
+{
+    reusing_alloc alloc;
+    object_domain d;
+    d.set_allocator(&alloc);
+
+    const auto mixin_deallocations = reusing_alloc::mixin_deallocations;
+
+    {
+        object o(d);
+        the_object = &o;
+
+        mutate(o).add<normal_a>().add<normal_b>();
+        const auto mixin_allocations = reusing_alloc::mixin_allocations;
+
+        // the buffers of both removed mixins are kept, one of them is taken by the throwing one
+        // and the other one must still be deallocated
+        single_object_mutator m(o);
+        m.remove<normal_a>().remove<normal_b>().add<throwing>();
+        CHECK_THROWS_AS(m.apply(), construction_error);
+        m.cancel(); // or the destructor will apply it again
+        CHECK(reusing_alloc::mixin_allocations == mixin_allocations);
+        CHECK(reusing_alloc::mixin_deallocations == mixin_deallocations + 1);
+
+        the_object = nullptr;
+    }
+
+    CHECK(reusing_alloc::mixin_allocations == reusing_alloc::mixin_deallocations);
+}
+#endif
+
 class normal_a {};
 class normal_b {};
 class custom_2_a {
@@ -579,6 +682,16 @@ public:
     custom_2_a(custom_2_a&&) = delete;
 };
 class custom_2_b {};
+class throwing
+{
+public:
+    throwing()
+    {
+#if DYNAMIX_USE_EXCEPTIONS && !DYNAMIX_CONCURRENT_MUTATIONS
+        throw construction_error();
+#endif
+    }
+};
 
 DYNAMIX_DEFINE_MIXIN(normal_a, dynamix::none);
 DYNAMIX_DEFINE_MIXIN(normal_b, dynamix::none);
@@ -586,6 +699,7 @@ DYNAMIX_DEFINE_MIXIN(custom_1, dynamix::allocator<custom_alloc_1>() & get_i_msg)
 DYNAMIX_DEFINE_MIXIN(custom_2_a, dynamix::allocator<custom_alloc_2>());
 DYNAMIX_DEFINE_MIXIN(custom_2_b, dynamix::allocator<custom_alloc_2>());
 DYNAMIX_DEFINE_MIXIN(custom_own_var, the_allocator & get_x_msg);
+DYNAMIX_DEFINE_MIXIN(throwing, dynamix::none);
 
 DYNAMIX_DEFINE_MESSAGE(get_i);
 DYNAMIX_DEFINE_MESSAGE(get_x);
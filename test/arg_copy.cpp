@@ -6,6 +6,7 @@
 // https://opensource.org/licenses/MIT
 //
 #include <dynamix/core.hpp>
+#include <dynamix/declare_message_variadic.hpp>
 
 #include "doctest/doctest.h"
 
@@ -80,6 +81,8 @@ DYNAMIX_CONST_MESSAGE_0(int, getb);
 DYNAMIX_CONST_MESSAGE_0(int, getc);
 
 DYNAMIX_MULTICAST_MESSAGE_2(void, multi, track_copy, cp, track_ref&, ref);
+DYNAMIX_MULTICAST_MESSAGE_1(void, multi_cref, track_copy, cp);
+DYNAMIX_MULTICAST_MESSAGE_V(multi_v, void(track_copy));
 
 DYNAMIX_DECLARE_MIXIN(a);
 DYNAMIX_DECLARE_MIXIN(b);
@@ -185,12 +188,41 @@ TEST_CASE("multi")
     multi(o, c, r);
 
     CHECK(track_copy::defaults == 1);
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(track_copy::copies == 3); // for each method, the callers pass a const reference
+    CHECK(track_copy::moves == 0);
+#else
     CHECK(track_copy::copies == 4); // for each multicast + 1 for the msg call
     CHECK(track_copy::moves == 3); // for each caller
+#endif
     CHECK(track_ref::defaults == 1);
     CHECK(track_ref::copies == 0);
     CHECK(track_ref::moves == 0);
 
+    // methods which take a const reference
+    multi_cref(o, c);
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(track_copy::copies == 3); // no change
+    CHECK(track_copy::moves == 0);
+#endif
+    CHECK(geta(o) == COPY + 1);
+    CHECK(getc(o) == COPY + 1);
+
+    // and temporaries are not copied either
+    multi_cref(o, track_copy());
+    CHECK(track_copy::defaults == 2);
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(track_copy::copies == 3);
+    CHECK(track_copy::moves == 0);
+#endif
+
+    // variadic message macros
+    multi_v(o, c);
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(track_copy::copies == 6); // for each method
+    CHECK(track_copy::moves == 0);
+#endif
+
     reset_tracks();
 }
 
@@ -218,6 +250,16 @@ public:
         member = cp.val + ref.val;
     }
 
+    void multi_cref(const track_copy& cp)
+    {
+        member = cp.val + 1;
+    }
+
+    void multi_v(track_copy cp)
+    {
+        member = cp.val;
+    }
+
     int geta() const
     {
         return member;
@@ -226,7 +268,7 @@ public:
     int member = 80;
 };
 
-DYNAMIX_DEFINE_MIXIN(a, uni_msg & uni_ret_msg & multi_msg & geta_msg);
+DYNAMIX_DEFINE_MIXIN(a, uni_msg & uni_ret_msg & multi_msg & multi_cref_msg & multi_v_msg & geta_msg);
 
 class b
 {
@@ -236,6 +278,16 @@ public:
         member = cp.val + ref.val;
     }
 
+    void multi_cref(const track_copy& cp)
+    {
+        member = cp.val + 1;
+    }
+
+    void multi_v(track_copy cp)
+    {
+        member = cp.val;
+    }
+
     int getb() const
     {
         return member;
@@ -244,7 +296,7 @@ public:
     int member = 120;
 };
 
-DYNAMIX_DEFINE_MIXIN(b, multi_msg & getb_msg);
+DYNAMIX_DEFINE_MIXIN(b, multi_msg & multi_cref_msg & multi_v_msg & getb_msg);
 
 class c
 {
@@ -254,6 +306,16 @@ public:
         member = cp.val + ref.val;
     }
 
+    void multi_cref(const track_copy& cp)
+    {
+        member = cp.val + 1;
+    }
+
+    void multi_v(track_copy cp)
+    {
+        member = cp.val;
+    }
+
     int getc() const
     {
         return member;
@@ -262,7 +324,7 @@ public:
     int member = 560;
 };
 
-DYNAMIX_DEFINE_MIXIN(c, multi_msg & getc_msg);
+DYNAMIX_DEFINE_MIXIN(c, multi_msg & multi_cref_msg & multi_v_msg & getc_msg);
 
 DYNAMIX_DEFINE_MESSAGE(uni);
 DYNAMIX_DEFINE_MESSAGE(uni_ret);
@@ -270,3 +332,5 @@ DYNAMIX_DEFINE_MESSAGE(geta);
 DYNAMIX_DEFINE_MESSAGE(getb);
 DYNAMIX_DEFINE_MESSAGE(getc);
 DYNAMIX_DEFINE_MESSAGE(multi);
+DYNAMIX_DEFINE_MESSAGE(multi_cref);
+DYNAMIX_DEFINE_MESSAGE(multi_v);
@@ -0,0 +1,160 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/concurrent_mutations.hpp>
+#include <dynamix/combinators.hpp>
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// the library needs to be built with concurrent mutations for this test to be relevant
+
+#if DYNAMIX_CONCURRENT_MUTATIONS
+
+TEST_SUITE_BEGIN("concurrent mutations");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(base);
+DYNAMIX_DECLARE_MIXIN(extra1);
+DYNAMIX_DECLARE_MIXIN(extra2);
+
+DYNAMIX_CONST_MESSAGE_0(int, value);
+DYNAMIX_CONST_MULTICAST_MESSAGE_0(int, check);
+
+const int MAGIC = 0x5AFE;
+std::atomic<int> num_destroyed = {0};
+
+// writes garbage when destroyed so that readers of destroyed mixins would notice
+struct checked
+{
+    ~checked()
+    {
+        magic = 0;
+        ++num_destroyed;
+    }
+
+    int check() const { return magic == MAGIC ? 1 : 1000; }
+    int magic = MAGIC;
+};
+
+class base : public checked
+{
+public:
+    int value() const { return check(); }
+};
+
+class extra1 : public checked
+{
+};
+
+class extra2 : public checked
+{
+};
+
+TEST_CASE("retire")
+{
+    object o;
+    mutate(o).add<base>().add<extra1>();
+    CHECK(reclaim() == 0);
+    num_destroyed = 0;
+
+    {
+        read_scope scope;
+        const extra1* e = o.get<extra1>();
+        REQUIRE(e);
+
+        mutate(o).remove<extra1>();
+        CHECK(!o.has<extra1>());
+
+        // the mixin is still alive as we may be reading it
+        CHECK(num_destroyed == 0);
+        CHECK(e->check() == 1);
+        CHECK(reclaim() > 0);
+    }
+
+    CHECK(reclaim() == 0);
+    CHECK(num_destroyed == 1);
+    CHECK(_dynamix_get_mixin_type_info((extra1*)nullptr).num_mixins == 0);
+
+    // clearing also retires
+    {
+        read_scope scope;
+        o.clear();
+        CHECK(num_destroyed == 1);
+    }
+    CHECK(reclaim() == 0);
+    CHECK(num_destroyed == 2);
+}
+
+TEST_CASE("readers and a writer")
+{
+    const int num_objects = 16;
+    const int num_readers = 3;
+    const int num_mutations = 2000;
+
+    std::vector<object> objects(num_objects);
+    for (auto& o : objects)
+    {
+        mutate(o).add<base>();
+    }
+
+    std::atomic<bool> done = {false};
+    std::atomic<int> num_bad = {0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < num_readers; ++r)
+    {
+        readers.emplace_back([&]()
+        {
+            while (!done)
+            {
+                for (auto& o : objects)
+                {
+                    // base is always there, the others come and go
+                    if (value(o) != 1) ++num_bad;
+                    int sum = check<combinators::sum>(o);
+                    if (sum < 1 || sum > 3) ++num_bad;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < num_mutations; ++i)
+    {
+        auto& o = objects[i % num_objects];
+        switch (i % 4)
+        {
+        case 0: mutate(o).add<extra1>(); break;
+        case 1: mutate(o).add<extra2>(); break;
+        case 2: mutate(o).remove<extra1>(); break;
+        case 3: mutate(o).remove<extra2>(); break;
+        }
+    }
+
+    done = true;
+    for (auto& t : readers)
+    {
+        t.join();
+    }
+
+    CHECK(num_bad == 0);
+    CHECK(reclaim() == 0);
+}
+
+DYNAMIX_DEFINE_MIXIN(base, value_msg & check_msg);
+DYNAMIX_DEFINE_MIXIN(extra1, check_msg);
+DYNAMIX_DEFINE_MIXIN(extra2, check_msg);
+
+DYNAMIX_DEFINE_MESSAGE(value);
+DYNAMIX_DEFINE_MESSAGE(check);
+
+#endif
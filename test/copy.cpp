@@ -5,7 +5,11 @@
 // See accompanying file LICENSE.txt or copy at
 // https://opensource.org/licenses/MIT
 //
+#define DYNAMIX_DOUBLE_BUFFERED_MIXINS 1
 #include <dynamix/core.hpp>
+#include <dynamix/object_domain.hpp>
+#include <dynamix/object_type_info.hpp>
+#include <dynamix/double_buffer.hpp>
 
 #include "doctest/doctest.h"
 
@@ -56,6 +60,15 @@ public:
 DYNAMIX_DECLARE_MIXIN(no_copy);
 DYNAMIX_DEFINE_MIXIN(no_copy, none);
 
+class buffered
+{
+public:
+    int i = 0;
+};
+
+DYNAMIX_DECLARE_MIXIN(buffered);
+DYNAMIX_DEFINE_MIXIN(buffered, double_buffered());
+
 TEST_CASE("obj_copy")
 {
     object osrc1;
@@ -167,6 +180,80 @@ TEST_CASE("obj_copy_fail")
 #endif
 }
 
+TEST_CASE("trivial assign")
+{
+    auto& trivial_info = _dynamix_get_mixin_type_info((trivial_copy*)nullptr);
+    auto& special_info = _dynamix_get_mixin_type_info((special_copy*)nullptr);
+    CHECK(trivial_info.trivially_copy_assignable);
+    CHECK(trivial_info.trivially_move_assignable);
+    CHECK(!special_info.trivially_copy_assignable);
+
+    object_domain d;
+    object src(d), target(d);
+    mutate(src).add<trivial_copy>().add<special_copy>();
+    mutate(target).add<trivial_copy>().add<special_copy>().add<no_copy>();
+
+    src.get<trivial_copy>()->i = 3;
+    src.get<special_copy>()->i = 4;
+    for (int i = 0; i < 3; ++i)
+    {
+        target.copy_matching_from(src);
+    }
+    CHECK(target.get<trivial_copy>()->i == 3);
+    CHECK(target.get<special_copy>()->i == 6);
+    CHECK(target.get<special_copy>()->a == 3);
+
+    // the other mixins of the target are left as they are
+    src.clear();
+    mutate(src).add<special_copy>();
+    src.get<special_copy>()->i = 10;
+    target.get<trivial_copy>()->i = 5;
+    target.copy_matching_from(src);
+    CHECK(target.get<trivial_copy>()->i == 5);
+    CHECK(target.get<special_copy>()->i == 12);
+}
+
+TEST_CASE("double-buffered assign")
+{
+    CHECK(_dynamix_get_mixin_type_info((buffered*)nullptr).trivially_copy_assignable);
+
+    object a, b;
+    mutate(a).add<buffered>();
+    mutate(b).add<buffered>().add<trivial_copy>();
+
+    // different values in the two instances
+    a.get<buffered>()->i = 1;
+    swap_buffers();
+    a.get<buffered>()->i = 2;
+    const object& ca = a;
+    const object& cb = b;
+    CHECK(ca.get<buffered>()->i == 1);
+
+    // both instances are copied and keep their objects
+    b.copy_matching_from(a);
+    CHECK(b.get<buffered>()->i == 2);
+    CHECK(cb.get<buffered>()->i == 1);
+    CHECK(object_of(b.get<buffered>()) == &b);
+    CHECK(object_of(cb.get<buffered>()) == &b);
+
+    b.get<buffered>()->i = 0;
+    b.move_matching_from(a);
+    CHECK(b.get<buffered>()->i == 2);
+    CHECK(cb.get<buffered>()->i == 1);
+    CHECK(object_of(b.get<buffered>()) == &b);
+    CHECK(object_of(cb.get<buffered>()) == &b);
+
+    object c;
+    mutate(c).add<buffered>();
+    c.copy_from(b);
+    CHECK(c.get<buffered>()->i == 2);
+    CHECK(static_cast<const object&>(c).get<buffered>()->i == 1);
+    CHECK(object_of(c.get<buffered>()) == &c);
+    CHECK(object_of(static_cast<const object&>(c).get<buffered>()) == &c);
+    CHECK(object_of(b.get<buffered>()) == &b);
+    CHECK(object_of(cb.get<buffered>()) == &b);
+}
+
 #if DYNAMIX_OBJECT_IMPLICIT_COPY
 TEST_CASE("obj_copy_ctor")
 {
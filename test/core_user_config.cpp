@@ -8,9 +8,11 @@
 
 // run the code tests with custom user configuratble definitions
 
+#include <dynamix/config.hpp>
+
 #if defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
 #   undef DYNAMIX_USE_LEGACY_MESSAGE_MACROS
-#else
+#elif !DYNAMIX_CONCURRENT_MUTATIONS // the legacy macros don't support it
 #   define DYNAMIX_USE_LEGACY_MESSAGE_MACROS
 #endif
 
@@ -0,0 +1,178 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_DOUBLE_BUFFERED_MIXINS 1
+#define DYNAMIX_MEMOS 1
+#include <dynamix/core.hpp>
+#include <dynamix/double_buffer.hpp>
+#include <dynamix/memo.hpp>
+
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <vector>
+
+TEST_SUITE_BEGIN("double buffered");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(cell);
+DYNAMIX_DECLARE_MIXIN(link);
+DYNAMIX_DECLARE_MIXIN(aligned);
+
+DYNAMIX_CONST_MESSAGE_0(int, value);
+DYNAMIX_MESSAGE_1(void, set_value, int, v);
+DYNAMIX_MESSAGE_0(void, step);
+
+class link
+{
+public:
+    object* next = nullptr;
+};
+
+class cell
+{
+public:
+    int value() const { return val; }
+    void set_value(int v) { val = v; }
+    void step()
+    {
+        // the value of the other object is read from its read instance
+        val = ::value(*dm_this->get<link>()->next);
+    }
+    int val = 0;
+};
+
+class alignas(32) aligned
+{
+public:
+    char c;
+};
+
+TEST_CASE("read and write")
+{
+    object o;
+    mutate(o).add<cell>();
+
+    CHECK(value(o) == 0);
+    set_value(o, 5);
+    CHECK(value(o) == 0); // not swapped yet
+
+    const object& co = o;
+    CHECK(co.get<cell>() != o.get<cell>());
+    CHECK(co.get<cell>()->val == 0);
+    CHECK(o.get<cell>()->val == 5);
+    CHECK(object_of(co.get<cell>()) == &o);
+    CHECK(object_of(o.get<cell>()) == &o);
+
+    const uint32_t epoch = buffer_epoch();
+    swap_buffers();
+    CHECK(buffer_epoch() == epoch + 1);
+
+    CHECK(value(o) == 5);
+    CHECK(co.get<cell>()->val == 5);
+    CHECK(o.get<cell>()->val == 0); // the state from two swaps ago
+
+    swap_buffers();
+    CHECK(value(o) == 0);
+}
+
+TEST_CASE("step")
+{
+    // each cell takes the value of the next one in a ring
+    // the result doesn't depend on the order of the calls
+    std::vector<object> ring(4);
+    for (size_t i = 0; i < ring.size(); ++i)
+    {
+        mutate(ring[i]).add<cell>().add<link>();
+        ring[i].get<link>()->next = &ring[(i + 1) % ring.size()];
+
+        // both instances
+        set_value(ring[i], int(i));
+        swap_buffers();
+        set_value(ring[i], int(i));
+        swap_buffers();
+    }
+
+    for (auto i = ring.rbegin(); i != ring.rend(); ++i)
+    {
+        step(*i);
+    }
+    swap_buffers();
+
+    CHECK(value(ring[0]) == 1);
+    CHECK(value(ring[1]) == 2);
+    CHECK(value(ring[2]) == 3);
+    CHECK(value(ring[3]) == 0);
+
+    for (auto& o : ring)
+    {
+        step(o);
+    }
+    swap_buffers();
+
+    CHECK(value(ring[0]) == 2);
+    CHECK(value(ring[3]) == 1);
+}
+
+TEST_CASE("copy and move")
+{
+    object o;
+    mutate(o).add<cell>().add<aligned>();
+    set_value(o, 1);
+    swap_buffers();
+    set_value(o, 2);
+
+    auto check_instances = [](const object& obj)
+    {
+        const object& cobj = obj;
+        auto& mobj = const_cast<object&>(obj);
+        CHECK(object_of(cobj.get<cell>()) == &obj);
+        CHECK(object_of(mobj.get<cell>()) == &obj);
+        CHECK(object_of(cobj.get<aligned>()) == &obj);
+        CHECK(object_of(mobj.get<aligned>()) == &obj);
+        CHECK(reinterpret_cast<uintptr_t>(cobj.get<aligned>()) % 32 == 0);
+        CHECK(reinterpret_cast<uintptr_t>(mobj.get<aligned>()) % 32 == 0);
+        CHECK(value(obj) == 1);
+        CHECK(mobj.get<cell>()->val == 2);
+    };
+
+    check_instances(o);
+
+    object c = o.copy();
+    check_instances(c);
+
+    object m = std::move(o);
+    check_instances(m);
+
+    // mutations move the mixin data
+    mutate(m).remove<aligned>();
+    check_instances(c);
+    CHECK(value(m) == 1);
+    CHECK(object_of(m.get<cell>()) == &m);
+}
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+TEST_CASE("memo")
+{
+    object o;
+    mutate(o).add<cell>();
+    set_value(o, 3);
+
+    CHECK(memo(o, value_msg) == 0);
+    swap_buffers();
+    CHECK(memo(o, value_msg) == 3);
+}
+#endif
+
+DYNAMIX_DEFINE_MIXIN(cell, double_buffered() & pure(value_msg) & set_value_msg & step_msg);
+DYNAMIX_DEFINE_MIXIN(link, none);
+DYNAMIX_DEFINE_MIXIN(aligned, double_buffered());
+
+DYNAMIX_DEFINE_MESSAGE(value);
+DYNAMIX_DEFINE_MESSAGE(set_value);
+DYNAMIX_DEFINE_MESSAGE(step);
@@ -0,0 +1,130 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/object_type_info.hpp>
+#include <dynamix/exception.hpp>
+
+#include "doctest/doctest.h"
+
+#include <string>
+
+TEST_SUITE_BEGIN("facts");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(car);
+DYNAMIX_DECLARE_MIXIN(turbo);
+DYNAMIX_DECLARE_MIXIN(trailer);
+DYNAMIX_DECLARE_MIXIN(plane);
+DYNAMIX_DECLARE_MIXIN(boat);
+
+DYNAMIX_FACT(float, max_speed);
+DYNAMIX_FACT(std::string, kind);
+DYNAMIX_FACT(int, wheels);
+
+DYNAMIX_MESSAGE_0(int, get_wheels);
+
+TEST_CASE("values")
+{
+    object o;
+    CHECK(!has_fact(o, max_speed_fact));
+    CHECK(!get_fact(o, kind_fact));
+    CHECK(get_fact(o, max_speed_fact, 1.f) == 1.f);
+
+    mutate(o).add<car>();
+    CHECK(has_fact(o, max_speed_fact));
+    CHECK(*get_fact(o, max_speed_fact) == 100.f);
+    CHECK(*get_fact(o, kind_fact) == "car");
+    CHECK(get_fact(o, wheels_fact, 0) == 4);
+    CHECK(get_wheels(o) == 4);
+
+    CHECK(o.implements(max_speed_fact));
+    CHECK(o.type_info().num_implementers(max_speed_fact) == 1);
+
+    // same values for all objects of the type
+    object o2;
+    mutate(o2).add<car>();
+    CHECK(get_fact(o, kind_fact) == get_fact(o2, kind_fact));
+
+    mutate(o).remove<car>();
+    CHECK(!has_fact(o, wheels_fact));
+    CHECK(!o.implements(wheels_fact));
+}
+
+TEST_CASE("priority and bid")
+{
+    object o;
+    mutate(o).add<car>().add<turbo>();
+
+    // higher bid
+    CHECK(*get_fact(o, max_speed_fact) == 200.f);
+    // not provided by turbo
+    CHECK(*get_fact(o, kind_fact) == "car");
+    CHECK(o.type_info().num_implementers(max_speed_fact) == 2);
+
+    mutate(o).add<trailer>();
+    // higher priority, despite the lower bid
+    CHECK(*get_fact(o, max_speed_fact) == 80.f);
+    // lower bid
+    CHECK(*get_fact(o, wheels_fact) == 4);
+
+    mutate(o).remove<car>();
+    CHECK(*get_fact(o, max_speed_fact) == 80.f);
+    CHECK(*get_fact(o, wheels_fact) == 6);
+    CHECK(*get_fact(o, kind_fact) == "trailer");
+}
+
+#if DYNAMIX_USE_EXCEPTIONS
+TEST_CASE("clash")
+{
+    object o;
+    mutate(o).add<plane>();
+    CHECK(*get_fact(o, kind_fact) == "plane");
+
+    // same priority and bid
+    single_object_mutator clash(o);
+    clash.add<boat>();
+    CHECK_THROWS_AS(clash.apply(), fact_clash);
+    CHECK(o.has<plane>());
+    CHECK(!o.has<boat>());
+
+    // a higher priority provider resolves the clash
+    single_object_mutator safe(o);
+    safe.add<boat>();
+    safe.add<trailer>();
+    CHECK_NOTHROW(safe.apply());
+    CHECK(*get_fact(o, kind_fact) == "trailer");
+}
+#endif
+
+class car
+{
+public:
+    int get_wheels() { return get_fact(*dm_this, wheels_fact, 0); }
+};
+
+class turbo {};
+class trailer {};
+class plane {};
+class boat {};
+
+DYNAMIX_DEFINE_MIXIN(car, get_wheels_msg
+    & fact(max_speed_fact, 100.f)
+    & fact(kind_fact, "car")
+    & fact(wheels_fact, 4));
+DYNAMIX_DEFINE_MIXIN(turbo, bid(1, fact(max_speed_fact, 200.f)));
+DYNAMIX_DEFINE_MIXIN(trailer, priority(1, fact(max_speed_fact, 80.f))
+    & priority(1, fact(kind_fact, "trailer"))
+    & bid(-1, fact(wheels_fact, 6)));
+DYNAMIX_DEFINE_MIXIN(plane, fact(kind_fact, "plane"));
+DYNAMIX_DEFINE_MIXIN(boat, fact(kind_fact, "boat"));
+
+DYNAMIX_DEFINE_FACT(max_speed);
+DYNAMIX_DEFINE_FACT(kind);
+DYNAMIX_DEFINE_FACT(wheels);
+DYNAMIX_DEFINE_MESSAGE(get_wheels);
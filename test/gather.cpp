@@ -0,0 +1,127 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_DOUBLE_BUFFERED_MIXINS 1
+#include <dynamix/core.hpp>
+#include <dynamix/gather.hpp>
+#include <dynamix/double_buffer.hpp>
+
+#include "doctest/doctest.h"
+
+#include <vector>
+
+TEST_SUITE_BEGIN("gather");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(transform);
+DYNAMIX_DECLARE_MIXIN(velocity);
+DYNAMIX_DECLARE_MIXIN(tag);
+DYNAMIX_DECLARE_MIXIN(buffered);
+
+class transform
+{
+public:
+    int pos = 0;
+};
+
+class velocity
+{
+public:
+    int val = 1;
+};
+
+class tag {};
+
+class buffered
+{
+public:
+    int val = 0;
+};
+
+TEST_CASE("skip")
+{
+    // runs of types, including empty objects
+    std::vector<object> objects(40);
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        auto& o = objects[i];
+        if (i % 4 == 1) continue;
+        mutate(o).add<transform>();
+        if (i < 20) mutate(o).add<velocity>();
+        if (i % 8 == 0) mutate(o).add<tag>();
+        o.get<transform>()->pos = int(i);
+    }
+
+    std::vector<transform*> transforms;
+    std::vector<const velocity*> velocities;
+    CHECK(gather(objects, transforms, velocities) == 15);
+    CHECK(transforms.size() == 15);
+    CHECK(velocities.size() == 15);
+
+    for (size_t i = 0; i < transforms.size(); ++i)
+    {
+        auto& o = *object_of(transforms[i]);
+        CHECK(o.get<velocity>() == velocities[i]);
+        transforms[i]->pos += velocities[i]->val * 100;
+    }
+
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (i % 4 == 1) continue;
+        CHECK(objects[i].get<transform>()->pos == int(i < 20 ? i + 100 : i));
+    }
+
+    // the pointers are appended
+    CHECK(gather(objects, transforms) == 30);
+    CHECK(transforms.size() == 45);
+}
+
+TEST_CASE("null")
+{
+    object a, b, c;
+    mutate(a).add<transform>().add<velocity>();
+    mutate(b).add<velocity>();
+
+    // from a range of pointers to const objects
+    std::vector<const object*> objects = {&a, &b, &c};
+    std::vector<const transform*> transforms;
+    std::vector<const velocity*> velocities;
+    CHECK(gather(objects, gather_missing::null, transforms, velocities) == 1);
+
+    CHECK(transforms == std::vector<const transform*>({a.get<transform>(), nullptr, nullptr}));
+    CHECK(velocities == std::vector<const velocity*>({a.get<velocity>(), b.get<velocity>(), nullptr}));
+}
+
+TEST_CASE("double buffered")
+{
+    object objects[2];
+    for (auto& o : objects)
+    {
+        mutate(o).add<buffered>();
+    }
+
+    std::vector<buffered*> write;
+    std::vector<const buffered*> read;
+    gather(objects, write, read);
+    REQUIRE(write.size() == 2);
+    REQUIRE(read.size() == 2);
+
+    const object& co = objects[0];
+    CHECK(write[0] == objects[0].get<buffered>());
+    CHECK(read[0] == co.get<buffered>());
+    CHECK(write[0] != read[0]);
+
+    write[1]->val = 5;
+    swap_buffers();
+    CHECK(static_cast<const object&>(objects[1]).get<buffered>()->val == 5);
+}
+
+DYNAMIX_DEFINE_MIXIN(transform, none);
+DYNAMIX_DEFINE_MIXIN(velocity, none);
+DYNAMIX_DEFINE_MIXIN(tag, none);
+DYNAMIX_DEFINE_MIXIN(buffered, double_buffered());
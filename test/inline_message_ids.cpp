@@ -0,0 +1,78 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_INLINE_MESSAGE_IDS 1
+#include <dynamix/core.hpp>
+#include <dynamix/combinators.hpp>
+
+#include "doctest/doctest.h"
+
+TEST_SUITE_BEGIN("inline message ids");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(a);
+DYNAMIX_DECLARE_MIXIN(b);
+
+DYNAMIX_MESSAGE_1(int, uni, int, i);
+DYNAMIX_MULTICAST_MESSAGE_1(void, multi, int&, i);
+DYNAMIX_CONST_MULTICAST_MESSAGE_0(int, multi_ret);
+
+template <typename Message>
+feature_id cached_id(Message*)
+{
+    return internal::message_id_cache<Message>::id.load();
+}
+
+TEST_CASE("ids")
+{
+    // filled by the registration
+    CHECK(cached_id(uni_msg) == _dynamix_get_mixin_feature_fast(uni_msg).id);
+    CHECK(cached_id(multi_msg) == _dynamix_get_mixin_feature_fast(multi_msg).id);
+    CHECK(cached_id(multi_ret_msg) == _dynamix_get_mixin_feature_fast(multi_ret_msg).id);
+
+    object o;
+    mutate(o).add<a>().add<b>();
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    // filled on first use (the legacy message callers don't use the cache)
+    internal::message_id_cache<std::remove_pointer<decltype(uni_msg)>::type>::reset();
+    CHECK(cached_id(uni_msg) == INVALID_FEATURE_ID);
+    CHECK(uni(o, 3) == 4);
+    CHECK(cached_id(uni_msg) == _dynamix_get_mixin_feature_fast(uni_msg).id);
+#else
+    CHECK(uni(o, 3) == 4);
+#endif
+
+    int i = 0;
+    multi(o, i);
+    CHECK(i == 3);
+
+    CHECK(multi_ret<combinators::sum>(o) == 3);
+}
+
+class a
+{
+public:
+    int uni(int i) { return i + 1; }
+    void multi(int& i) { i += 1; }
+    int multi_ret() const { return 1; }
+};
+
+class b
+{
+public:
+    void multi(int& i) { i += 2; }
+    int multi_ret() const { return 2; }
+};
+
+DYNAMIX_DEFINE_MIXIN(a, uni_msg & multi_msg & multi_ret_msg);
+DYNAMIX_DEFINE_MIXIN(b, multi_msg & multi_ret_msg);
+
+DYNAMIX_DEFINE_MESSAGE(uni);
+DYNAMIX_DEFINE_MESSAGE(multi);
+DYNAMIX_DEFINE_MESSAGE(multi_ret);
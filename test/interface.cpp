@@ -0,0 +1,140 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/interface.hpp>
+#include <dynamix/exception.hpp>
+
+#include "doctest/doctest.h"
+
+#include <string>
+
+TEST_SUITE_BEGIN("interface");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(sprite);
+DYNAMIX_DECLARE_MIXIN(overlay);
+DYNAMIX_DECLARE_MIXIN(sound);
+
+DYNAMIX_MESSAGE_1(void, draw, std::string&, out);
+DYNAMIX_CONST_MESSAGE_0(int, layer);
+DYNAMIX_MESSAGE_1(void, set_layer, int, l);
+DYNAMIX_CONST_MESSAGE_0(int, volume);
+
+typedef interface<decltype(draw_msg), decltype(layer_msg), dynamix_msg_set_layer> renderable;
+typedef interface<decltype(layer_msg)> layered;
+
+TEST_CASE("calls")
+{
+    object o;
+    mutate(o).add<sprite>();
+
+    renderable r(o);
+    CHECK(&r.get_object() == &o);
+    CHECK(r.implemented());
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    std::string out;
+    r.call(draw_msg, out);
+    CHECK(out == "sprite");
+    CHECK(r.call(layer_msg) == 1);
+    r.call(set_layer_msg, 5);
+    CHECK(r.call(layer_msg) == 5);
+    CHECK(layer(o) == 5);
+#endif
+
+    // the table is built once per type and interface
+    CHECK(o.type_info()._interface_tables[renderable::id()].load() != nullptr);
+    CHECK(renderable::id() != layered::id());
+    CHECK(o.type_info()._interface_tables[layered::id()].load() == nullptr);
+
+    object o2;
+    mutate(o2).add<sprite>();
+    renderable r2(o2);
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(r2.call(layer_msg) == 1);
+#endif
+
+    layered l(o);
+    CHECK(o.type_info()._interface_tables[layered::id()].load() != nullptr);
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(l.call(layer_msg) == 5);
+#endif
+}
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+TEST_CASE("bids and types")
+{
+    object o;
+    mutate(o).add<sprite>().add<overlay>();
+
+    // the top bid is called
+    renderable r(o);
+    std::string out;
+    r.call(draw_msg, out);
+    CHECK(out == "overlay");
+    CHECK(r.call(layer_msg) == 1);
+
+    // after a mutation a new view is needed
+    mutate(o).remove<overlay>();
+    renderable r2(o);
+    out.clear();
+    r2.call(draw_msg, out);
+    CHECK(out == "sprite");
+}
+#endif
+
+TEST_CASE("not implemented")
+{
+    object o;
+    mutate(o).add<sound>();
+
+    renderable r(o);
+    CHECK(!r.implemented());
+    CHECK(!r.implements(draw_msg));
+    CHECK(r.implements(layer_msg)); // default implementation
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(r.call(layer_msg) == 0);
+#if DYNAMIX_USE_EXCEPTIONS
+    CHECK_THROWS_AS(r.call(set_layer_msg, 3), bad_message_call);
+#endif
+#endif
+}
+
+class sprite
+{
+public:
+    void draw(std::string& out) { out += "sprite"; }
+    int layer() const { return l; }
+    void set_layer(int n) { l = n; }
+    int l = 1;
+};
+
+class overlay
+{
+public:
+    void draw(std::string& out) { out += "overlay"; }
+};
+
+class sound
+{
+public:
+    int volume() const { return 10; }
+};
+
+DYNAMIX_DEFINE_MIXIN(sprite, draw_msg & layer_msg & set_layer_msg);
+DYNAMIX_DEFINE_MIXIN(overlay, bid(1, draw_msg));
+DYNAMIX_DEFINE_MIXIN(sound, volume_msg);
+
+DYNAMIX_DEFINE_MESSAGE(draw);
+DYNAMIX_DEFINE_MESSAGE_0_WITH_DEFAULT_IMPL(int, layer)
+{
+    return 0;
+}
+DYNAMIX_DEFINE_MESSAGE(set_layer);
+DYNAMIX_DEFINE_MESSAGE(volume);
@@ -0,0 +1,137 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+
+// the mixins in this module are registered on first use
+#define DYNAMIX_LAZY_MIXIN_REGISTRATION 1
+
+#include <dynamix/core.hpp>
+#include <dynamix/domain.hpp>
+
+#include "doctest/doctest.h"
+
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("lazy registration");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(used);
+DYNAMIX_DECLARE_MIXIN(preloaded);
+DYNAMIX_DECLARE_MIXIN(ping);
+DYNAMIX_DECLARE_MIXIN(pong);
+DYNAMIX_DECLARE_MIXIN(threaded);
+DYNAMIX_DECLARE_MIXIN(by_name);
+
+DYNAMIX_CONST_MESSAGE_0(int, value);
+
+class used
+{
+public:
+    int value() const { return 1; }
+};
+
+class preloaded {};
+class ping {};
+class pong {};
+
+class threaded
+{
+public:
+    int value() const { return 2; }
+};
+
+class by_name {};
+
+// checks the registration without registering
+template <typename Mixin>
+bool is_registered()
+{
+    return internal::mixin_type_info_instance<Mixin>::info().registered;
+}
+
+TEST_CASE("first use")
+{
+    CHECK(!is_registered<used>());
+    CHECK(!is_registered<preloaded>());
+
+    object o;
+    mutate(o).add<used>();
+    CHECK(is_registered<used>());
+    CHECK(o.has<used>());
+    CHECK(value(o) == 1);
+
+    CHECK(!is_registered<preloaded>());
+    preload<preloaded>();
+    CHECK(is_registered<preloaded>());
+}
+
+TEST_CASE("siblings")
+{
+    CHECK(!is_registered<ping>());
+    CHECK(!is_registered<pong>());
+
+    // they require each other
+    object o;
+    mutate(o).add<ping>();
+    CHECK(is_registered<ping>());
+    CHECK(is_registered<pong>());
+    CHECK(o.has<ping>());
+    CHECK(o.has<pong>());
+}
+
+TEST_CASE("threads")
+{
+    CHECK(!is_registered<threaded>());
+
+    const int num_threads = 4;
+    std::vector<int> values(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back([i, &values]()
+        {
+            object o;
+            mutate(o).add<threaded>();
+            values[i] = value(o);
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    for (auto v : values)
+    {
+        CHECK(v == 2);
+    }
+
+    CHECK(is_registered<threaded>());
+}
+
+TEST_CASE("by name")
+{
+    CHECK(!is_registered<by_name>());
+
+    object o;
+    single_object_mutator m(o);
+    CHECK(m.add("lazy_by_name"));
+    m.apply();
+    CHECK(is_registered<by_name>());
+    CHECK(o.has<by_name>());
+}
+
+DYNAMIX_DEFINE_MIXIN(used, value_msg);
+DYNAMIX_DEFINE_MIXIN(preloaded, none);
+DYNAMIX_DEFINE_MIXIN(ping, requires_sibling<pong>());
+DYNAMIX_DEFINE_MIXIN(pong, requires_sibling<ping>());
+DYNAMIX_DEFINE_MIXIN(threaded, value_msg);
+DYNAMIX_DEFINE_MIXIN(by_name, mixin_name("lazy_by_name") & none);
+
+DYNAMIX_DEFINE_MESSAGE(value);
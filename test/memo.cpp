@@ -0,0 +1,172 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_MEMOS 1
+#include <dynamix/core.hpp>
+#include <dynamix/combinators.hpp>
+#include <dynamix/memo.hpp>
+
+#include "doctest/doctest.h"
+
+TEST_SUITE_BEGIN("memo");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(body);
+DYNAMIX_DECLARE_MIXIN(cargo);
+DYNAMIX_DECLARE_MIXIN(impure);
+
+DYNAMIX_CONST_MESSAGE_0(int, volume);
+DYNAMIX_CONST_MULTICAST_MESSAGE_0(int, mass);
+DYNAMIX_MESSAGE_1(void, set_size, int, size);
+DYNAMIX_CONST_MESSAGE_0(int, num_computed);
+
+// counts the calls of the pure methods
+int computed = 0;
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+TEST_CASE("unicast")
+{
+    object o;
+    mutate(o).add<body>();
+    computed = 0;
+
+    CHECK(memo(o, volume_msg) == 8);
+    CHECK(memo(o, volume_msg) == 8);
+    CHECK(computed == 1);
+
+    // const messages don't invalidate
+    CHECK(num_computed(o) == 1);
+    CHECK(memo(o, volume_msg) == 8);
+    CHECK(computed == 1);
+
+    // non-const messages do
+    set_size(o, 3);
+    CHECK(memo(o, volume_msg) == 27);
+    CHECK(memo(o, volume_msg) == 27);
+    CHECK(computed == 2);
+
+    invalidate_memos(o);
+    CHECK(memo(o, volume_msg) == 27);
+    CHECK(computed == 3);
+
+    invalidate_memo(o, volume_msg);
+    CHECK(memo(o, volume_msg) == 27);
+    CHECK(computed == 4);
+
+    // other objects have their own results
+    object o2;
+    mutate(o2).add<body>();
+    CHECK(memo(o2, volume_msg) == 8);
+    CHECK(computed == 5);
+    CHECK(memo(o, volume_msg) == 27);
+    CHECK(computed == 5);
+}
+
+TEST_CASE("multicast")
+{
+    object o;
+    mutate(o).add<body>().add<cargo>();
+    computed = 0;
+
+    CHECK(memo<combinators::sum>(o, mass_msg) == 15);
+    CHECK(memo<combinators::sum>(o, mass_msg) == 15);
+    CHECK(computed == 2);
+
+    // different combinators have different results
+    CHECK(memo<combinators::boolean_and>(o, mass_msg));
+    CHECK(computed == 4);
+    CHECK(memo<combinators::sum>(o, mass_msg) == 15);
+    CHECK(computed == 4);
+
+    // mutations invalidate
+    mutate(o).remove<cargo>();
+    CHECK(memo<combinators::sum>(o, mass_msg) == 10);
+    CHECK(computed == 5);
+
+    // the results are moved with the object
+    object o2 = std::move(o);
+    CHECK(!internal::find_memo_table(o));
+    CHECK(memo<combinators::sum>(o2, mass_msg) == 10);
+    CHECK(computed == 5);
+}
+
+TEST_CASE("not pure")
+{
+    object o;
+    mutate(o).add<body>().add<impure>();
+    computed = 0;
+
+    // a mixin doesn't mark its implementation as pure, so nothing is stored
+    CHECK(memo<combinators::sum>(o, mass_msg) == 11);
+    CHECK(memo<combinators::sum>(o, mass_msg) == 11);
+    CHECK(computed == 4);
+    CHECK(!internal::find_memo_table(o));
+
+    // the unicast is still pure
+    CHECK(memo(o, volume_msg) == 8);
+    CHECK(memo(o, volume_msg) == 8);
+    CHECK(computed == 5);
+}
+#endif
+
+class body
+{
+public:
+    int volume() const
+    {
+        ++computed;
+        return size * size * size;
+    }
+
+    int mass() const
+    {
+        ++computed;
+        return 10;
+    }
+
+    void set_size(int s)
+    {
+        size = s;
+    }
+
+    int num_computed() const
+    {
+        return computed;
+    }
+
+    int size = 2;
+};
+
+class cargo
+{
+public:
+    int mass() const
+    {
+        ++computed;
+        return 5;
+    }
+};
+
+class impure
+{
+public:
+    int mass() const
+    {
+        ++computed;
+        return 1;
+    }
+};
+
+DYNAMIX_DEFINE_MIXIN(body, pure(volume_msg) & pure(mass_msg) & set_size_msg & num_computed_msg);
+DYNAMIX_DEFINE_MIXIN(cargo, pure(mass_msg));
+DYNAMIX_DEFINE_MIXIN(impure, mass_msg);
+
+DYNAMIX_DEFINE_MESSAGE(volume);
+DYNAMIX_DEFINE_MESSAGE(mass);
+DYNAMIX_DEFINE_MESSAGE(set_size);
+DYNAMIX_DEFINE_MESSAGE(num_computed);
@@ -0,0 +1,184 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/memory_arena.hpp>
+#include <dynamix/teardown.hpp>
+#include <dynamix/object_domain.hpp>
+#include <dynamix/object_type_info.hpp>
+
+#include "doctest/doctest.h"
+
+#include <vector>
+
+TEST_SUITE_BEGIN("memory arena");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(a);
+DYNAMIX_DECLARE_MIXIN(b);
+DYNAMIX_DECLARE_MIXIN(c);
+
+DYNAMIX_MESSAGE_0(int, get);
+DYNAMIX_MULTICAST_MESSAGE_1(void, collect, std::vector<int>&, out);
+
+class a
+{
+public:
+    int get() { return 1; }
+    void collect(std::vector<int>& out) { out.push_back(1); }
+};
+
+class b
+{
+public:
+    int get() { return 2; }
+    void collect(std::vector<int>& out) { out.push_back(2); }
+    double d[3] = {};
+};
+
+class c
+{
+public:
+    void collect(std::vector<int>& out) { out.push_back(3); }
+};
+
+bool is_aligned(const void* ptr, size_t alignment)
+{
+    return uintptr_t(ptr) % alignment == 0;
+}
+
+uintptr_t addr(const void* ptr)
+{
+    return uintptr_t(ptr);
+}
+
+TEST_CASE("arena")
+{
+    memory_arena arena(1024);
+    CHECK(arena.num_blocks() == 0);
+
+    auto p1 = arena.allocate(10);
+    auto p2 = arena.allocate(10, 64);
+    CHECK(is_aligned(p1, sizeof(void*)));
+    CHECK(is_aligned(p2, 64));
+    CHECK(addr(p2) >= addr(p1) + 10);
+    CHECK(arena.num_blocks() == 1);
+
+    // big allocations get a block of their own
+    auto big = arena.allocate(5000, 128);
+    CHECK(is_aligned(big, 128));
+    CHECK(arena.num_blocks() == 2);
+
+    // and the current block is still used
+    auto p3 = arena.allocate(10);
+    CHECK(addr(p3) >= addr(p2) + 10);
+    CHECK(addr(p3) < addr(p1) + 1024);
+    CHECK(arena.num_blocks() == 2);
+
+    arena.allocate(1000);
+    CHECK(arena.num_blocks() == 3);
+    CHECK(arena.reserved_size() >= 5000 + 2 * 1024);
+
+    arena.release();
+    CHECK(arena.num_blocks() == 0);
+    CHECK(arena.reserved_size() == 0);
+}
+
+TEST_CASE("huge pages")
+{
+    memory_arena arena(1000, true);
+
+    auto p = static_cast<char*>(arena.allocate(100, 64));
+    CHECK(is_aligned(p, 64));
+    p[0] = p[99] = 1;
+
+    if (arena.uses_huge_pages())
+    {
+        CHECK(is_aligned(p, memory_arena::HUGE_PAGE_SIZE));
+        CHECK(arena.reserved_size() == memory_arena::HUGE_PAGE_SIZE);
+    }
+}
+
+TEST_CASE("arena allocator")
+{
+    arena_allocator alloc(4096);
+    object_domain d;
+    d.set_allocator(&alloc);
+
+    std::vector<object> objects;
+    for (int i = 0; i < 10; ++i)
+    {
+        objects.emplace_back(d);
+        mutate(objects.back()).add<a>().add<b>();
+        CHECK(get(objects.back()) == 2);
+    }
+
+    CHECK(alloc.arena().num_blocks() == 1);
+
+#if !DYNAMIX_CONCURRENT_MUTATIONS
+    // buffers of the same size are reused
+    auto aptr = addr(objects[0].get<a>());
+    mutate(objects[0]).remove<a>().add<c>();
+    CHECK(addr(objects[0].get<c>()) == aptr);
+#endif
+
+    teardown_options options;
+    options.release_memory = false;
+    teardown(objects.data(), objects.size(), options);
+
+    for (auto& o : objects)
+    {
+        CHECK(o.empty());
+    }
+
+    alloc.reset();
+    CHECK(alloc.arena().num_blocks() == 0);
+}
+
+TEST_CASE("type info arena")
+{
+    object_domain d;
+    d.use_type_info_arena();
+
+    object o1(d), o2(d), o3(d);
+    mutate(o1).add<a>().add<c>();
+    mutate(o2).add<b>().add<c>();
+    mutate(o3).add<a>();
+
+    CHECK(d.num_type_infos() == 3);
+
+    for (auto o : {&o1, &o2, &o3})
+    {
+        CHECK(is_aligned(o->type_info()._call_table, memory_arena::CACHE_LINE_SIZE));
+    }
+
+    CHECK(get(o1) == 1);
+    CHECK(get(o2) == 2);
+
+    std::vector<int> out;
+    collect(o1, out);
+    collect(o2, out);
+    collect(o3, out);
+    CHECK(out == std::vector<int>({1, 3, 2, 3, 1}));
+
+    o3.clear();
+    d.garbage_collect_type_infos();
+    CHECK(d.num_type_infos() == 2);
+    CHECK(get(o1) == 1);
+
+    mutate(o3).add<b>();
+    CHECK(is_aligned(o3.type_info()._call_table, memory_arena::CACHE_LINE_SIZE));
+    CHECK(get(o3) == 2);
+}
+
+DYNAMIX_DEFINE_MIXIN(a, get_msg & collect_msg);
+DYNAMIX_DEFINE_MIXIN(b, priority(1, get_msg) & collect_msg);
+DYNAMIX_DEFINE_MIXIN(c, collect_msg);
+
+DYNAMIX_DEFINE_MESSAGE(get);
+DYNAMIX_DEFINE_MESSAGE(collect);
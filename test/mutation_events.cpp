@@ -0,0 +1,179 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/mutation_events.hpp>
+#include <dynamix/object_domain.hpp>
+#include <dynamix/object_type_info.hpp>
+#include <dynamix/common_mutation_rules.hpp>
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("mutation events");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(a);
+DYNAMIX_DECLARE_MIXIN(b);
+DYNAMIX_DECLARE_MIXIN(c);
+
+class a {};
+class b {};
+class c {};
+
+mixin_id id_of(const mixin_type_info& info) { return info.id; }
+#define ID(m) id_of(_dynamix_get_mixin_type_info((m*)nullptr))
+
+TEST_CASE("events")
+{
+    std::vector<mutation_event> events;
+    auto sub = mutation_events::add_subscriber([&events](const std::vector<mutation_event>& batch)
+    {
+        events.insert(events.end(), batch.begin(), batch.end());
+    });
+
+    size_t num_other = 0;
+    auto other = mutation_events::add_subscriber([&num_other](const std::vector<mutation_event>& batch)
+    {
+        num_other += batch.size();
+    });
+
+    {
+        object o;
+        mutate(o).add<a>();
+        CHECK(mutation_events::dispatch() == 0); // not enabled
+    }
+
+    mutation_events::enable();
+    CHECK(mutation_events::is_enabled());
+
+    object_domain d;
+    d.add_mutation_rule(std::make_shared<mandatory_mixin<c>>());
+
+    {
+        object o(d);
+        mutate(o).add<a>(); // c is added by the rule
+        auto& type_ac = o.type_info();
+
+        mutate(o).remove<a>().add<b>();
+        auto& type_bc = o.type_info();
+
+        mutate(o).add<b>(); // no change
+
+        object moved = std::move(o);
+
+        CHECK(mutation_events::dispatch() == 4);
+        REQUIRE(events.size() == 4);
+        CHECK(num_other == 4);
+
+        auto& e0 = events[0];
+        CHECK(e0.obj == &o);
+        CHECK(e0.old_type == &object_type_info::null());
+        CHECK(e0.new_type == &type_ac);
+        CHECK(e0.added.count() == 2);
+        CHECK(e0.added[ID(a)]);
+        CHECK(e0.added[ID(c)]);
+        CHECK(e0.removed.none());
+
+        auto& e1 = events[1];
+        CHECK(e1.obj == &o);
+        CHECK(e1.old_type == &type_ac);
+        CHECK(e1.new_type == &type_bc);
+        CHECK(e1.added.count() == 1);
+        CHECK(e1.added[ID(b)]);
+        CHECK(e1.removed.count() == 1);
+        CHECK(e1.removed[ID(a)]);
+
+        // move
+        CHECK(events[2].obj == &o);
+        CHECK(events[2].new_type == &object_type_info::null());
+        CHECK(events[2].removed.count() == 2);
+        CHECK(events[3].obj == &moved);
+        CHECK(events[3].new_type == &type_bc);
+        CHECK(events[3].added.count() == 2);
+
+        events.clear();
+    }
+
+    // destruction of moved
+    CHECK(mutation_events::dispatch() == 1);
+    REQUIRE(events.size() == 1);
+    CHECK(events[0].new_type == &object_type_info::null());
+    CHECK(events[0].removed[ID(b)]);
+    CHECK(events[0].removed[ID(c)]);
+    events.clear();
+
+    mutation_events::remove_subscriber(other);
+    mutation_events::disable();
+
+    {
+        object o;
+        mutate(o).add<a>();
+    }
+    CHECK(mutation_events::dispatch() == 0);
+    CHECK(events.empty());
+    CHECK(num_other == 5);
+
+    mutation_events::remove_subscriber(sub);
+}
+
+TEST_CASE("threads")
+{
+    std::atomic<size_t> num_events = {0};
+    auto sub = mutation_events::add_subscriber([&num_events](const std::vector<mutation_event>& batch)
+    {
+        num_events += batch.size();
+    });
+
+    mutation_events::enable();
+
+    const int num_threads = 4;
+    const int num_mutations = 1000;
+    std::atomic<int> num_done = {0};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back([&num_done]()
+        {
+            object_domain d;
+            object o(d);
+            for (int j = 0; j < num_mutations; ++j)
+            {
+                if (j % 2) mutate(o).remove<a>().add<b>();
+                else mutate(o).remove<b>().add<a>();
+            }
+            o.clear();
+            ++num_done;
+        });
+    }
+
+    // dispatch while the threads are mutating
+    while (num_done != num_threads)
+    {
+        mutation_events::dispatch();
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    mutation_events::dispatch();
+    CHECK(num_events == num_threads * (num_mutations + 1));
+
+    mutation_events::disable();
+    mutation_events::remove_subscriber(sub);
+}
+
+DYNAMIX_DEFINE_MIXIN(a, none);
+DYNAMIX_DEFINE_MIXIN(b, none);
+DYNAMIX_DEFINE_MIXIN(c, none);
@@ -0,0 +1,277 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/object_domain.hpp>
+#include <dynamix/object_type_info.hpp>
+#include <dynamix/object_type_template.hpp>
+#include <dynamix/same_type_mutator.hpp>
+#include <dynamix/allocators.hpp>
+#include <dynamix/exception.hpp>
+#include <dynamix/common_mutation_rules.hpp>
+
+#include "doctest/doctest.h"
+
+TEST_SUITE_BEGIN("object domains");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(a);
+DYNAMIX_DECLARE_MIXIN(b);
+
+DYNAMIX_CONST_MESSAGE_0(int, get);
+
+class a
+{
+public:
+    int get() const { return val; }
+    int val = 1;
+};
+
+class b
+{
+};
+
+TEST_CASE("separate types")
+{
+    object_domain d1, d2;
+
+    object g;
+    object o1(d1), o2(d2);
+    CHECK(&g.domain() == &object_domain::global());
+    CHECK(&o1.domain() == &d1);
+    CHECK(&o2.domain() == &d2);
+
+    mutate(g).add<a>();
+    mutate(o1).add<a>();
+    mutate(o2).add<a>().add<b>();
+
+    // same mixins, different types
+    CHECK(&g.type_info() != &o1.type_info());
+    CHECK(o1.type_info().has(_dynamix_get_mixin_type_info((a*)nullptr).id));
+    CHECK(d1.num_type_infos() == 1);
+    CHECK(d2.num_type_infos() == 1);
+
+    // messages are shared
+    CHECK(get(g) == 1);
+    CHECK(get(o1) == 1);
+    CHECK(get(o2) == 1);
+
+    object o3(d1);
+    mutate(o3).add<a>();
+    CHECK(&o3.type_info() == &o1.type_info());
+
+    o1.clear();
+    o3.clear();
+    d1.garbage_collect_type_infos();
+    CHECK(d1.num_type_infos() == 0);
+    CHECK(d2.num_type_infos() == 1);
+}
+
+TEST_CASE("rules")
+{
+    object_domain d;
+    auto id = d.add_mutation_rule(std::make_shared<mandatory_mixin<b>>());
+
+    object o(d), g;
+    mutate(o).add<a>();
+    mutate(g).add<a>();
+
+    CHECK(o.has<b>());
+    CHECK(!g.has<b>());
+
+    d.remove_mutation_rule(id);
+    mutate(o).remove<b>();
+    CHECK(!o.has<b>());
+}
+
+TEST_CASE("mutators")
+{
+    object_domain d;
+
+    object_type_template t(d);
+    t.add<a>();
+    t.create();
+
+    object o(t);
+    CHECK(&o.domain() == &d);
+    CHECK(o.has<a>());
+
+    object o2(d);
+    same_type_mutator stm;
+    stm.add<b>();
+    stm.apply_to(o2);
+    CHECK(o2.has<b>());
+
+#if DYNAMIX_USE_EXCEPTIONS
+    // empty objects have the same type in all domains, but can't be mutated by other ones
+    object g;
+    CHECK_THROWS_AS(t.apply_to(g), bad_mutation_source);
+    CHECK_THROWS_AS(stm.apply_to(g), bad_mutation_source);
+    CHECK(g.empty());
+#endif
+}
+
+TEST_CASE("move and copy")
+{
+    object_domain d;
+
+    object o(d);
+    mutate(o).add<a>();
+    o.get<a>()->val = 5;
+
+    object moved = std::move(o);
+    CHECK(&moved.domain() == &d);
+    CHECK(get(moved) == 5);
+
+    object copy = moved.copy();
+    CHECK(&copy.domain() == &d);
+    CHECK(&copy.type_info() == &moved.type_info());
+    CHECK(get(copy) == 5);
+
+    // copy assignment keeps the domain of the target with an equivalent type
+    object g;
+    g.copy_from(moved);
+    CHECK(&g.domain() == &object_domain::global());
+    CHECK(&g.type_info() != &moved.type_info());
+    CHECK(get(g) == 5);
+
+    g.get<a>()->val = 6;
+    moved.copy_from(g);
+    CHECK(get(moved) == 6);
+    CHECK(&moved.domain() == &d);
+}
+
+TEST_CASE("type index")
+{
+    object_domain d;
+    auto& a_info = _dynamix_get_mixin_type_info((a*)nullptr);
+    auto& b_info = _dynamix_get_mixin_type_info((b*)nullptr);
+
+    CHECK(d.types_with_mixin(a_info).empty());
+    CHECK(d.types_implementing(get_msg).empty());
+
+    object oa(d), ob(d), oab(d);
+    mutate(oa).add<a>();
+    mutate(ob).add<b>();
+    mutate(oab).add<a>().add<b>();
+
+    auto with_a = d.types_with<a>();
+    CHECK(with_a.size() == 2);
+    CHECK(with_a[0] == &oa.type_info());
+    CHECK(with_a[1] == &oab.type_info());
+
+    auto with_b = d.types_with_mixin(b_info.id);
+    CHECK(with_b.size() == 2);
+    CHECK(with_b[0] == &ob.type_info());
+    CHECK(with_b[1] == &oab.type_info());
+
+    CHECK(d.types_implementing(get_msg) == with_a);
+
+    // other domains are not indexed
+    CHECK(object_domain::global().types_with_mixin(b_info).empty());
+
+    mutate(oa).remove<a>();
+    d.garbage_collect_type_infos();
+    with_a = d.types_with_mixin(a_info);
+    CHECK(with_a.size() == 1);
+    CHECK(with_a[0] == &oab.type_info());
+    CHECK(d.types_implementing(get_msg) == with_a);
+    CHECK(d.types_with_mixin(b_info).size() == 2);
+}
+
+TEST_CASE("shared call tables")
+{
+    object_domain d;
+
+    object oa(d), ob(d), oab(d);
+    mutate(oa).add<a>();
+    mutate(ob).add<b>();
+    mutate(oab).add<b>().add<a>();
+
+    // b implements no messages, so it's after a and the types with a share a call table
+    auto& ta = oa.type_info();
+    auto& tab = oab.type_info();
+    CHECK(&ta != &tab);
+    CHECK(tab.mixin_index(_dynamix_get_mixin_type_info((a*)nullptr).id) == object_type_info::MIXIN_INDEX_OFFSET);
+    CHECK(ta._call_table == tab._call_table);
+    CHECK(ob.type_info()._call_table != ta._call_table);
+
+    // not with types from other domains
+    object g;
+    mutate(g).add<a>();
+    CHECK(g.type_info()._call_table != ta._call_table);
+
+    oab.get<a>()->val = 3;
+    CHECK(get(oa) == 1);
+    CHECK(get(oab) == 3);
+
+    // the table outlives the type which created it
+    oa.clear();
+    d.garbage_collect_type_infos();
+    CHECK(d.num_type_infos() == 2);
+    CHECK(get(oab) == 3);
+
+    mutate(oa).add<a>();
+    CHECK(oa.type_info()._call_table == oab.type_info()._call_table);
+    CHECK(get(oa) == 1);
+}
+
+size_t num_data_allocations = 0;
+size_t num_mixin_allocations = 0;
+
+struct counting_allocator : public domain_allocator
+{
+    virtual char* alloc_mixin_data(size_t count, const object* obj) override
+    {
+        ++num_data_allocations;
+        return _dda.alloc_mixin_data(count, obj);
+    }
+
+    virtual void dealloc_mixin_data(char* ptr, size_t count, const object* obj) override
+    {
+        _dda.dealloc_mixin_data(ptr, count, obj);
+    }
+
+    virtual std::pair<char*, size_t> alloc_mixin(const mixin_type_info& info, const object* obj) override
+    {
+        ++num_mixin_allocations;
+        return _dda.alloc_mixin(info, obj);
+    }
+
+    virtual void dealloc_mixin(char* ptr, size_t offset, const mixin_type_info& info, const object* obj) override
+    {
+        _dda.dealloc_mixin(ptr, offset, info, obj);
+    }
+
+    internal::default_allocator _dda;
+};
+
+TEST_CASE("allocator")
+{
+    counting_allocator alloc;
+    object_domain d;
+    d.set_allocator(&alloc);
+    CHECK(d.allocator() == &alloc);
+    CHECK(object_domain::global().allocator() != &alloc);
+
+    {
+        object o(d);
+        mutate(o).add<a>().add<b>();
+
+        object g;
+        mutate(g).add<a>().add<b>();
+    }
+
+    CHECK(num_data_allocations == 1);
+    CHECK(num_mixin_allocations == 2);
+}
+
+DYNAMIX_DEFINE_MIXIN(a, get_msg);
+DYNAMIX_DEFINE_MIXIN(b, none);
+
+DYNAMIX_DEFINE_MESSAGE(get);
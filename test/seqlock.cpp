@@ -0,0 +1,138 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_SEQLOCKED_MIXINS 1
+#include <dynamix/core.hpp>
+#include <dynamix/seqlock.hpp>
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <thread>
+
+TEST_SUITE_BEGIN("seqlock");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(transform);
+DYNAMIX_DECLARE_MIXIN(health);
+DYNAMIX_DECLARE_MIXIN(plain);
+
+DYNAMIX_MESSAGE_1(void, set_pos, int, p);
+DYNAMIX_CONST_MESSAGE_0(int, pos);
+DYNAMIX_MULTICAST_MESSAGE_1(void, damage, int, d);
+
+// the state of the mixins is always consistent when x == y
+class transform
+{
+public:
+    void set_pos(int p)
+    {
+        x = p;
+        y = p;
+    }
+    int pos() const { return x; }
+    void damage(int d) { set_pos(x - d); }
+    int x = 0;
+    int y = 0;
+};
+
+class health
+{
+public:
+    void damage(int d) { hp -= d; }
+    int hp = 100;
+};
+
+class plain
+{
+public:
+    char c = 0;
+};
+
+TEST_CASE("counter")
+{
+    object o;
+    mutate(o).add<transform>().add<health>().add<plain>();
+
+    auto& info = _dynamix_get_mixin_type_info(static_cast<transform*>(nullptr));
+    CHECK(info.seqlock_offset >= sizeof(transform));
+    CHECK(o.type_info()._has_seqlocked_mixins);
+
+    auto counter = internal::seqlock_of(o, info);
+    CHECK(counter->load() == 0);
+
+    set_pos(o, 5);
+    CHECK(counter->load() == 2);
+
+    // const messages don't write
+    CHECK(pos(o) == 5);
+    CHECK(counter->load() == 2);
+
+    damage(o, 1);
+    CHECK(counter->load() == 4);
+
+    write_consistent<transform>(o, [](transform& t) { t.set_pos(3); });
+    CHECK(counter->load() == 6);
+
+    int x = 0;
+    CHECK(read_consistent<transform>(o, [&x](const transform& t) { x = t.x; }));
+    CHECK(x == 3);
+
+    // mutations don't write the mixins which stay
+    mutate(o).remove<plain>();
+    CHECK(counter->load() == 6);
+    CHECK(pos(o) == 3);
+
+    object empty;
+    CHECK(!read_consistent<transform>(empty, [](const transform&) {}));
+}
+
+TEST_CASE("threads")
+{
+    object o;
+    mutate(o).add<transform>();
+
+    const int A_LOT = 100000;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]()
+    {
+        for (int i = 1; i <= A_LOT; ++i)
+        {
+            set_pos(o, i);
+        }
+        done = true;
+    });
+
+    int torn = 0;
+    int last = 0;
+    while (!done)
+    {
+        int x = 0, y = 0;
+        CHECK(read_consistent<transform>(o, [&](const transform& t)
+        {
+            x = reinterpret_cast<const volatile int&>(t.x);
+            y = reinterpret_cast<const volatile int&>(t.y);
+        }));
+        if (x != y) ++torn;
+        CHECK(x >= last);
+        last = x;
+    }
+
+    writer.join();
+    CHECK(torn == 0);
+    CHECK(pos(o) == A_LOT);
+}
+
+DYNAMIX_DEFINE_MIXIN(transform, seqlocked() & set_pos_msg & pos_msg & damage_msg);
+DYNAMIX_DEFINE_MIXIN(health, damage_msg);
+DYNAMIX_DEFINE_MIXIN(plain, none);
+
+DYNAMIX_DEFINE_MESSAGE(set_pos);
+DYNAMIX_DEFINE_MESSAGE(pos);
+DYNAMIX_DEFINE_MESSAGE(damage);
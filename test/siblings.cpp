@@ -0,0 +1,127 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/sibling.hpp>
+#include <dynamix/object_type_template.hpp>
+
+#include "doctest/doctest.h"
+
+TEST_SUITE_BEGIN("siblings");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(transform);
+DYNAMIX_DECLARE_MIXIN(physics);
+DYNAMIX_DECLARE_MIXIN(render);
+DYNAMIX_DECLARE_MIXIN(body);
+DYNAMIX_DECLARE_MIXIN(other);
+
+DYNAMIX_MESSAGE_0(int, step);
+DYNAMIX_CONST_MESSAGE_0(int, draw);
+
+TEST_CASE("required siblings are added")
+{
+    object o;
+    mutate(o).add<physics>();
+    CHECK(o.has<physics>());
+    CHECK(o.has<transform>());
+
+    // transitive: body requires physics which requires transform
+    object b;
+    mutate(b).add<other>().add<body>();
+    CHECK(b.has<body>());
+    CHECK(b.has<physics>());
+    CHECK(b.has<transform>());
+    CHECK(b.has<other>());
+
+    // siblings are kept while the mixin stays
+    mutate(o).remove<transform>();
+    CHECK(o.has<transform>());
+
+    // and can be removed with it
+    mutate(o).remove<transform>().remove<physics>();
+    CHECK(!o.has<transform>());
+    CHECK(!o.has<physics>());
+
+    object_type_template tmpl;
+    tmpl.add<render>();
+    tmpl.create();
+    object t;
+    tmpl.apply_to(t);
+    CHECK(t.has<transform>());
+}
+
+TEST_CASE("sibling access")
+{
+    object o;
+    mutate(o).add<render>().add<other>().add<physics>();
+
+    // physics moves the transform, render reads it
+    CHECK(step(o) == 1);
+    CHECK(step(o) == 2);
+    CHECK(draw(o) == 2);
+
+    // the table is per type, so a different layout of the same mixins must work
+    object p;
+    mutate(p).add<physics>();
+    CHECK(step(p) == 1);
+
+    // copies get their own siblings
+    object c = o.copy();
+    CHECK(step(c) == 3);
+    CHECK(draw(o) == 2);
+
+    // moved objects keep them
+    object m(std::move(o));
+    CHECK(draw(m) == 2);
+}
+
+class transform
+{
+public:
+    int x = 0;
+};
+
+class physics
+{
+public:
+    int step()
+    {
+        auto t = sibling<transform>(this);
+        CHECK(t == dm_this->get<transform>());
+        return ++t->x;
+    }
+};
+
+class render
+{
+public:
+    int draw() const
+    {
+        const transform* t = sibling<transform>(this);
+        CHECK(t == dm_this->get<transform>());
+        return t->x;
+    }
+};
+
+class body
+{
+};
+
+class other
+{
+};
+
+DYNAMIX_DEFINE_MIXIN(transform, none);
+DYNAMIX_DEFINE_MIXIN(physics, step_msg & requires_sibling<transform>());
+DYNAMIX_DEFINE_MIXIN(render, draw_msg & requires_sibling<transform>());
+DYNAMIX_DEFINE_MIXIN(body, requires_sibling<physics>());
+DYNAMIX_DEFINE_MIXIN(other, none);
+
+DYNAMIX_DEFINE_MESSAGE(step);
+DYNAMIX_DEFINE_MESSAGE(draw);
@@ -0,0 +1,222 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/teardown.hpp>
+#include <dynamix/object_domain.hpp>
+#include <dynamix/object_type_info.hpp>
+#include <dynamix/allocators.hpp>
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("teardown");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(pod);
+DYNAMIX_DECLARE_MIXIN(counted);
+DYNAMIX_DECLARE_MIXIN(resource);
+
+std::atomic<int> num_counted_destroyed = {0};
+std::atomic<int> num_resources_destroyed = {0};
+
+class pod
+{
+public:
+    int i = 0;
+};
+
+class counted
+{
+public:
+    ~counted() { ++num_counted_destroyed; }
+};
+
+class resource
+{
+public:
+    ~resource() { ++num_resources_destroyed; }
+};
+
+template <typename Mixin>
+size_t num_mixins()
+{
+    return _dynamix_get_mixin_type_info(static_cast<Mixin*>(nullptr)).num_mixins;
+}
+
+void reset_counters()
+{
+    num_counted_destroyed = 0;
+    num_resources_destroyed = 0;
+}
+
+TEST_CASE("traits")
+{
+    CHECK(_dynamix_get_mixin_type_info((pod*)nullptr).trivially_destructible);
+    CHECK(!_dynamix_get_mixin_type_info((pod*)nullptr).destroy_on_teardown);
+    CHECK(!_dynamix_get_mixin_type_info((counted*)nullptr).trivially_destructible);
+    CHECK(_dynamix_get_mixin_type_info((resource*)nullptr).destroy_on_teardown);
+}
+
+TEST_CASE("teardown")
+{
+    reset_counters();
+
+    std::vector<object> objects(10);
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (i % 2) mutate(objects[i]).add<pod>().add<counted>();
+        else mutate(objects[i]).add<pod>().add<resource>();
+    }
+    objects.emplace_back(); // an empty one
+
+    auto& type = objects[0].type_info();
+    CHECK(type.num_objects == 5);
+    CHECK(num_mixins<pod>() == 10);
+
+    teardown(objects.data(), objects.size());
+
+    for (auto& o : objects)
+    {
+        CHECK(o.empty());
+    }
+
+    CHECK(num_counted_destroyed == 5);
+    CHECK(num_resources_destroyed == 5);
+    CHECK(type.num_objects == 0);
+    CHECK(num_mixins<pod>() == 0);
+    CHECK(num_mixins<counted>() == 0);
+    CHECK(num_mixins<resource>() == 0);
+
+    // they can be used afterwards
+    mutate(objects[0]).add<counted>();
+    CHECK(objects[0].has<counted>());
+}
+
+TEST_CASE("skip destructors")
+{
+    reset_counters();
+
+    object a, b;
+    mutate(a).add<counted>().add<resource>();
+    mutate(b).add<counted>();
+
+    object* objects[] = {&a, &b};
+    teardown_options options;
+    options.call_destructors = false;
+    teardown(objects, 2, options);
+
+    CHECK(a.empty());
+    CHECK(b.empty());
+    CHECK(num_counted_destroyed == 0);
+    CHECK(num_resources_destroyed == 1);
+    CHECK(num_mixins<counted>() == 0);
+}
+
+TEST_CASE("parallel")
+{
+    reset_counters();
+
+    std::vector<object> objects(100);
+    for (auto& o : objects)
+    {
+        mutate(o).add<counted>();
+    }
+
+    size_t num_calls = 0;
+    teardown_options options;
+    options.num_tasks = 4;
+    options.parallel_for = [&num_calls](size_t num_tasks, const std::function<void(size_t)>& task)
+    {
+        ++num_calls;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < num_tasks; ++i)
+        {
+            threads.emplace_back(task, i);
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+    };
+
+    teardown(objects.data(), objects.size(), options);
+    CHECK(num_calls == 1);
+    CHECK(num_counted_destroyed == 100);
+    CHECK(num_mixins<counted>() == 0);
+}
+
+// keeps all memory until it's destroyed
+struct arena_allocator : public domain_allocator
+{
+    virtual char* alloc_mixin_data(size_t count, const object*) override
+    {
+        return alloc(count * mixin_data_size);
+    }
+
+    virtual void dealloc_mixin_data(char*, size_t, const object*) override
+    {
+        ++num_deallocations;
+    }
+
+    virtual std::pair<char*, size_t> alloc_mixin(const mixin_type_info& info, const object*) override
+    {
+        auto buf = alloc(mem_size_for_mixin(info.size, info.alignment));
+        return std::make_pair(buf, mixin_offset(buf, info.alignment));
+    }
+
+    virtual void dealloc_mixin(char*, size_t, const mixin_type_info&, const object*) override
+    {
+        ++num_deallocations;
+    }
+
+    char* alloc(size_t size)
+    {
+        buffers.emplace_back(new char[size]);
+        return buffers.back().get();
+    }
+
+    std::vector<std::unique_ptr<char[]>> buffers;
+    int num_deallocations = 0;
+};
+
+TEST_CASE("keep memory")
+{
+    reset_counters();
+
+    arena_allocator alloc;
+    object_domain d;
+    d.set_allocator(&alloc);
+
+    std::vector<object> objects;
+    for (int i = 0; i < 5; ++i)
+    {
+        objects.emplace_back(d);
+        mutate(objects.back()).add<pod>().add<counted>();
+    }
+
+    teardown_options options;
+    options.release_memory = false;
+    teardown(objects.data(), objects.size(), options);
+
+    CHECK(num_counted_destroyed == 5);
+    CHECK(alloc.num_deallocations == 0);
+    CHECK(alloc.buffers.size() == 15);
+
+    for (auto& o : objects)
+    {
+        CHECK(o.empty());
+    }
+}
+
+DYNAMIX_DEFINE_MIXIN(pod, none);
+DYNAMIX_DEFINE_MIXIN(counted, none);
+DYNAMIX_DEFINE_MIXIN(resource, destroy_on_teardown());
@@ -0,0 +1,205 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#include <dynamix/core.hpp>
+#include <dynamix/tick_scheduler.hpp>
+#include <dynamix/mutation_events.hpp>
+
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <vector>
+
+TEST_SUITE_BEGIN("tick scheduler");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(unit);
+DYNAMIX_DECLARE_MIXIN(distant);
+DYNAMIX_DECLARE_MIXIN(far_away);
+DYNAMIX_DECLARE_MIXIN(observer);
+
+DYNAMIX_MESSAGE_1(void, update, int, dt);
+DYNAMIX_MULTICAST_MESSAGE_1(void, observe, std::vector<int>&, out);
+DYNAMIX_CONST_MESSAGE_0(int, elapsed);
+
+TEST_CASE("periods")
+{
+    tick_scheduler s;
+    s.set_mixin_period<distant>(4);
+    s.set_mixin_period<far_away>(16);
+
+    std::vector<object> objects(32);
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        auto& o = objects[i];
+        if (i < 8) mutate(o).add<unit>();
+        else if (i < 24) mutate(o).add<unit>().add<distant>();
+        else mutate(o).add<unit>().add<distant>().add<far_away>();
+        s.add(o);
+    }
+
+    CHECK(s.num_objects() == 32);
+    CHECK(s.period(objects[0]) == 1);
+    CHECK(s.period(objects[8]) == 4);
+    CHECK(s.period(objects[30]) == 4); // the smallest period of its mixins
+    CHECK(s.periods() == std::vector<uint32_t>({1, 4}));
+
+    s.set_period(objects[31], 16);
+    CHECK(s.period(objects[31]) == 16);
+
+    // 8 objects every frame, 16+7 every 4, 1 every 16
+    for (int f = 0; f < 16; ++f)
+    {
+        auto due = s.num_due();
+        CHECK(due >= 13);
+        CHECK(due <= 15);
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+        s.tick(update_msg, 1);
+#else
+        s.advance();
+#endif
+    }
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    for (auto& o : objects)
+    {
+        CHECK(elapsed(o) == 16 / int(s.period(o)));
+    }
+#endif
+
+    s.clear_period(objects[31]);
+    CHECK(s.period(objects[31]) == 4);
+
+    s.remove(objects[0]);
+    CHECK(!s.has(objects[0]));
+    CHECK(s.num_objects() == 31);
+}
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+TEST_CASE("dispatch period")
+{
+    tick_scheduler s;
+    s.set_mixin_period<distant>(4);
+
+    std::vector<object> objects(8);
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        auto& o = objects[i];
+        if (i % 2) mutate(o).add<unit>();
+        else mutate(o).add<unit>().add<distant>();
+        s.add(o);
+    }
+
+    for (int f = 0; f < 8; ++f)
+    {
+        // objects ticked every 4 frames get 4 times the time step
+        for (auto p : s.periods())
+        {
+            s.dispatch_period(p, update_msg, int(p));
+        }
+        s.advance();
+    }
+
+    for (auto& o : objects)
+    {
+        CHECK(elapsed(o) == 8);
+    }
+}
+
+TEST_CASE("multicast and types")
+{
+    tick_scheduler s(2);
+
+    std::vector<object> objects(6);
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        auto& o = objects[i];
+        if (i % 3 == 0) mutate(o).add<observer>();
+        else if (i % 3 == 1) mutate(o).add<observer>().add<unit>();
+        else mutate(o).add<distant>(); // doesn't implement observe
+        s.add(o);
+    }
+
+    std::vector<int> out;
+    s.tick(observe_msg, out);
+    s.tick(observe_msg, out);
+    // 2 objects with observer and 2 with observer and unit
+    CHECK(out.size() == 6);
+
+    std::sort(out.begin(), out.end());
+    CHECK(std::count(out.begin(), out.end(), 1) == 4);
+    CHECK(std::count(out.begin(), out.end(), 2) == 2);
+}
+#endif
+
+TEST_CASE("rebucket on mutation")
+{
+    tick_scheduler s;
+    s.set_mixin_period<distant>(8);
+
+    object a, b;
+    mutate(a).add<unit>();
+    mutate(b).add<unit>();
+    s.add(a);
+    s.add(b, 1);
+
+    mutation_events::enable();
+    mutation_events::dispatch();
+    auto sub = mutation_events::add_subscriber([&s](const std::vector<mutation_event>& e) { s.on_mutations(e); });
+
+    mutate(a).add<distant>();
+    mutate(b).add<distant>();
+    mutation_events::dispatch();
+
+    CHECK(s.period(a) == 8);
+    CHECK(s.period(b) == 1); // explicit
+
+    {
+        object c;
+        mutate(c).add<unit>();
+        s.add(c);
+        CHECK(s.num_objects() == 3);
+    }
+
+    // destroyed objects are removed
+    mutation_events::dispatch();
+    CHECK(s.num_objects() == 2);
+
+    s.set_mixin_period<distant>(0);
+    CHECK(s.period(a) == 1);
+
+    mutation_events::remove_subscriber(sub);
+    mutation_events::disable();
+}
+
+class unit
+{
+public:
+    void update(int dt) { time += dt; }
+    int elapsed() const { return time; }
+    void observe(std::vector<int>& out) { out.push_back(2); }
+    int time = 0;
+};
+
+class distant {};
+class far_away {};
+
+class observer
+{
+public:
+    void observe(std::vector<int>& out) { out.push_back(1); }
+};
+
+DYNAMIX_DEFINE_MIXIN(unit, update_msg & elapsed_msg & observe_msg);
+DYNAMIX_DEFINE_MIXIN(distant, none);
+DYNAMIX_DEFINE_MIXIN(far_away, none);
+DYNAMIX_DEFINE_MIXIN(observer, observe_msg);
+
+DYNAMIX_DEFINE_MESSAGE(update);
+DYNAMIX_DEFINE_MESSAGE(observe);
+DYNAMIX_DEFINE_MESSAGE(elapsed);
@@ -0,0 +1,143 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_TRACE_MESSAGES 1
+#include <dynamix/core.hpp>
+#include <dynamix/trace.hpp>
+
+#include "doctest/doctest.h"
+
+#include <sstream>
+#include <string>
+
+TEST_SUITE_BEGIN("trace");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(counter);
+DYNAMIX_DECLARE_MIXIN(other);
+
+DYNAMIX_MESSAGE_0(int, tick);
+DYNAMIX_MULTICAST_MESSAGE_0(void, notify);
+
+static size_t count_occurences(const std::string& str, const std::string& sub)
+{
+    size_t count = 0;
+    for (auto pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+TEST_CASE("disabled")
+{
+    trace::clear();
+    CHECK(!trace::is_enabled());
+
+    object o;
+    mutate(o).add<counter>();
+    tick(o);
+
+    std::ostringstream sout;
+    trace::write_chrome_trace(sout);
+    CHECK(sout.str().find("\"ph\"") == std::string::npos);
+}
+
+TEST_CASE("events")
+{
+    trace::clear();
+    trace::enable();
+    trace::set_message_sample_rate(2);
+
+    {
+        object o;
+        mutate(o)
+            .add<counter>()
+            .add<other>();
+
+        for (int i = 0; i < 10; ++i)
+        {
+            tick(o);
+        }
+        for (int i = 0; i < 10; ++i)
+        {
+            notify(o);
+        }
+
+        mutate(o).remove<other>();
+
+        trace::scope user_scope("user", "test", "detail");
+    }
+
+    trace::enable(false);
+
+    std::ostringstream sout;
+    trace::write_chrome_trace(sout);
+    auto json = sout.str();
+
+    CHECK(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") == 0);
+    CHECK(count_occurences(json, "\"name\":\"user\",\"cat\":\"test\"") == 1);
+    CHECK(count_occurences(json, "\"args\":{\"detail\":\"detail\"}") == 1);
+
+#if DYNAMIX_TRACE
+    // the type with counter only was created in the previous test
+    CHECK(count_occurences(json, "\"name\":\"create_type_info\"") == 1);
+    CHECK(count_occurences(json, "\"name\":\"fill_call_table\"") == 1);
+    CHECK(count_occurences(json, "\"name\":\"apply_mutation_rules\"") == 2);
+    CHECK(count_occurences(json, "\"name\":\"change_type\"") == 2);
+    CHECK(count_occurences(json, "\"name\":\"clear\"") == 1);
+    CHECK(count_occurences(json, "\"name\":\"alloc_mixin\",\"cat\":\"allocator\"") == 2);
+    CHECK(count_occurences(json, "\"name\":\"dealloc_mixin\",\"cat\":\"allocator\"") == 2);
+    CHECK(count_occurences(json, "\"args\":{\"detail\":\"counter\"}") == 4);
+#endif
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    // the legacy message macros don't record message events
+    CHECK(count_occurences(json, "\"cat\":\"message\"") == 10);
+    CHECK(count_occurences(json, "\"name\":\"tick\"") == 5);
+    CHECK(count_occurences(json, "\"name\":\"notify\"") == 5);
+#endif
+
+    trace::clear();
+    std::ostringstream sout2;
+    trace::write_chrome_trace(sout2);
+    CHECK(sout2.str().find("\"ph\"") == std::string::npos);
+
+    // events after a clear are kept
+    trace::enable();
+    {
+        trace::scope user_scope("after clear", "test");
+    }
+    trace::enable(false);
+    std::ostringstream sout3;
+    trace::write_chrome_trace(sout3);
+    CHECK(count_occurences(sout3.str(), "\"ph\"") == 1);
+    CHECK(count_occurences(sout3.str(), "\"name\":\"after clear\"") == 1);
+
+    trace::set_message_sample_rate(64);
+}
+
+class counter
+{
+public:
+    int tick() { return ++ticks; }
+    void notify() {}
+    int ticks = 0;
+};
+
+class other
+{
+public:
+    void notify() {}
+};
+
+DYNAMIX_DEFINE_MIXIN(counter, tick_msg & notify_msg);
+DYNAMIX_DEFINE_MIXIN(other, notify_msg);
+
+DYNAMIX_DEFINE_MESSAGE(tick);
+DYNAMIX_DEFINE_MESSAGE(notify);
@@ -0,0 +1,134 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_NO_MESSAGE_MACROS
+#include <dynamix/core.hpp>
+#include <dynamix/declare_message_variadic.hpp>
+#include <dynamix/combinators.hpp>
+
+#include "doctest/doctest.h"
+
+#include <string>
+#include <utility>
+
+TEST_SUITE_BEGIN("variadic msg macros");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(counter);
+DYNAMIX_DECLARE_MIXIN(namer);
+
+DYNAMIX_MESSAGE_V(count, void());
+DYNAMIX_CONST_MESSAGE_V(get_count, int());
+DYNAMIX_MESSAGE_V(set_name, void(const std::string&));
+DYNAMIX_CONST_MESSAGE_V(get_name, const std::string&());
+DYNAMIX_CONST_MESSAGE_V(min_max, std::pair<int, int>(int, int));
+DYNAMIX_MULTICAST_MESSAGE_V(add, void(int));
+DYNAMIX_CONST_MULTICAST_MESSAGE_V(weight, int(int));
+DYNAMIX_MESSAGE_V_OVERLOAD(scale_int, scale, int(int));
+DYNAMIX_MESSAGE_V_OVERLOAD(scale_str, scale, std::string(const std::string&, int));
+
+TEST_CASE("variadic unicast")
+{
+    object o;
+    mutate(o).add<counter>().add<namer>();
+
+    CHECK(o.implements(count_msg));
+    CHECK(o.implements(get_count_msg));
+
+    count(o);
+    count(&o);
+    CHECK(get_count(o) == 2);
+
+    const object& co = o;
+    CHECK(get_count(co) == 2);
+    CHECK(get_count(&co) == 2);
+
+    set_name(o, "foo");
+    CHECK(get_name(o) == "foo");
+
+    // the returned reference is the mixin member
+    const std::string& name = get_name(o);
+    set_name(o, "bar");
+    CHECK(name == "bar");
+
+    auto mm = min_max(o, 5, 3);
+    CHECK(mm.first == 3);
+    CHECK(mm.second == 5);
+
+    CHECK(scale(o, 3) == 6);
+    CHECK(scale(o, "ab", 3) == "ababab");
+}
+
+TEST_CASE("variadic multicast")
+{
+    object o;
+    mutate(o).add<counter>().add<namer>();
+
+    add(o, 3);
+    add(&o, 2);
+    CHECK(get_count(o) == 5);
+    CHECK(get_name(o) == "xx");
+
+    CHECK(weight<combinators::sum>(o, 1) == 1 + 5 + 2);
+
+    combinators::sum<int> sum;
+    call_with_combinator(weight_msg, o, sum, 2);
+    CHECK(sum.result() == 2 + 5 + 2);
+
+    // a double is converted to the int argument
+    CHECK(weight<combinators::sum>(o, 1.5) == 1 + 5 + 2);
+}
+
+class counter
+{
+public:
+    void count() { ++_count; }
+    int get_count() const { return _count; }
+    void add(int n) { _count += n; }
+    int weight(int base) const { return base + _count; }
+
+    std::pair<int, int> min_max(int a, int b) const
+    {
+        return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+    }
+
+private:
+    int _count = 0;
+};
+
+class namer
+{
+public:
+    void set_name(const std::string& n) { name = n; }
+    const std::string& get_name() const { return name; }
+    void add(int) { name += 'x'; }
+    int weight(int) const { return 2; }
+
+    int scale(int i) { return i * 2; }
+    std::string scale(const std::string& s, int n)
+    {
+        std::string ret;
+        for (int i = 0; i < n; ++i) ret += s;
+        return ret;
+    }
+
+    std::string name;
+};
+
+DYNAMIX_DEFINE_MIXIN(counter, count_msg & get_count_msg & min_max_msg & add_msg & weight_msg);
+DYNAMIX_DEFINE_MIXIN(namer, set_name_msg & get_name_msg & add_msg & weight_msg & scale_int_msg & scale_str_msg);
+
+DYNAMIX_DEFINE_MESSAGE(count);
+DYNAMIX_DEFINE_MESSAGE(get_count);
+DYNAMIX_DEFINE_MESSAGE(set_name);
+DYNAMIX_DEFINE_MESSAGE(get_name);
+DYNAMIX_DEFINE_MESSAGE(min_max);
+DYNAMIX_DEFINE_MESSAGE(add);
+DYNAMIX_DEFINE_MESSAGE(weight);
+DYNAMIX_DEFINE_MESSAGE(scale_int);
+DYNAMIX_DEFINE_MESSAGE(scale_str);
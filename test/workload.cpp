@@ -0,0 +1,223 @@
+// DynaMix
+// Copyright (c) 2013-2020 Borislav Stanimirov, Zahary Karadjov
+//
+// Distributed under the MIT Software License
+// See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/MIT
+//
+#define DYNAMIX_RECORD_MESSAGES 1
+#include <dynamix/core.hpp>
+#include <dynamix/object_type_template.hpp>
+#include <dynamix/allocators.hpp>
+#include <dynamix/workload.hpp>
+
+#include "doctest/doctest.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_SUITE_BEGIN("workload");
+
+using namespace dynamix;
+
+DYNAMIX_DECLARE_MIXIN(physics);
+DYNAMIX_DECLARE_MIXIN(render);
+DYNAMIX_DECLARE_MIXIN(ai);
+
+DYNAMIX_MULTICAST_MESSAGE_1(void, update, float, dt);
+DYNAMIX_CONST_MESSAGE_0(int, layer);
+
+class counting_allocator : public object_allocator
+{
+public:
+    virtual char* alloc_mixin_data(size_t count, const object*) override
+    {
+        ++allocations;
+        return new char[mixin_data_size * count];
+    }
+
+    virtual void dealloc_mixin_data(char* ptr, size_t, const object*) override
+    {
+        delete[] ptr;
+    }
+
+    virtual std::pair<char*, size_t> alloc_mixin(const mixin_type_info& info, const object*) override
+    {
+        size_t size = mem_size_for_mixin(info.size, info.alignment);
+        char* buffer = new char[size];
+        return std::make_pair(buffer, mixin_offset(buffer, info.alignment));
+    }
+
+    virtual void dealloc_mixin(char* ptr, size_t, const mixin_type_info&, const object*) override
+    {
+        delete[] ptr;
+    }
+
+    virtual object_allocator* on_move(object&, object&) noexcept override { return this; }
+
+    int allocations = 0;
+};
+
+TEST_CASE("record and replay")
+{
+    std::stringstream stream;
+
+    // existing objects are implicitly created on first use
+    object existing;
+    mutate(existing).add<ai>();
+
+    object_type_template tmpl;
+    tmpl.add<physics>();
+    tmpl.add<render>();
+    tmpl.create();
+
+    workload::start_recording(stream);
+    CHECK(workload::is_recording());
+
+    {
+        std::vector<object> objects(3);
+        mutate(objects[0]).add<physics>();
+        mutate(objects[1]).add<physics>().add<render>();
+        tmpl.apply_to(objects[2]);
+
+        for (auto& o : objects)
+        {
+            update(o, 0.5f);
+        }
+        layer(objects[1]);
+
+        mutate(objects[1]).remove<render>().add<ai>();
+        update(existing, 1);
+
+        object moved(std::move(objects[0]));
+        update(moved, 2);
+    }
+
+    workload::stop_recording();
+    CHECK(!workload::is_recording());
+
+    // not recorded
+    update(existing, 1);
+
+    workload::replayer replayer;
+    REQUIRE(replayer.load(stream));
+#if DYNAMIX_RECORD_WORKLOAD || !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(replayer.num_events() > 0);
+#endif
+
+    std::vector<std::string> updated;
+    replayer.set_message_handler("update", [&updated](object& o) {
+        std::string mixins;
+        if (o.has<physics>()) mixins += "p";
+        if (o.has<render>()) mixins += "r";
+        if (o.has<ai>()) mixins += "a";
+        updated.push_back(mixins);
+        update(o, 0);
+    });
+
+    auto stats = replayer.run();
+    CHECK(stats.num_unresolved_mixins == 0);
+
+#if !defined(DYNAMIX_USE_LEGACY_MESSAGE_MACROS)
+    CHECK(stats.num_objects == 5); // 3 + moved + existing
+    // the template and 4 mutations (including the existing object)
+    // or without DYNAMIX_RECORD_WORKLOAD the implicit creation of each object with its type on first use
+    CHECK(stats.num_mutations == 5);
+    CHECK(stats.num_messages == 5);
+    CHECK(stats.num_skipped_messages == 1); // layer
+
+    std::vector<std::string> expected = {"p", "pr", "pr", "a", "p"};
+#else
+    // the legacy message macros don't record message calls
+    // so the existing object is never referenced
+#if DYNAMIX_RECORD_WORKLOAD
+    CHECK(stats.num_objects == 4);
+    CHECK(stats.num_mutations == 4);
+#else
+    CHECK(stats.num_objects == 0);
+    CHECK(stats.num_mutations == 0);
+#endif
+    CHECK(stats.num_messages == 0);
+
+    std::vector<std::string> expected;
+#endif
+    CHECK(updated == expected);
+
+    // replay again with a different allocator
+    counting_allocator alloc;
+    replayer.set_object_allocator(&alloc);
+    updated.clear();
+    stats = replayer.run();
+    CHECK(stats.num_messages == expected.size());
+    CHECK(updated == expected);
+    CHECK((alloc.allocations > 0) == (stats.num_objects > 0));
+}
+
+TEST_CASE("invalid stream")
+{
+    std::stringstream stream("not a recording");
+    workload::replayer replayer;
+    CHECK(!replayer.load(stream));
+    CHECK(replayer.num_events() == 0);
+}
+
+// header and records of a stream
+static std::string recording(std::initializer_list<int> records)
+{
+    std::string ret = {'D', 'M', 'X', 'W', 1};
+    for (auto r : records) ret += char(r);
+    return ret;
+}
+
+TEST_CASE("malformed stream")
+{
+    // opcodes: 1 define mixin, 2 define type, 3 define message, 4 create, 5 destroy,
+    // 6 move, 7 mutate, 8 apply template, 9 call
+    auto loads = [](std::initializer_list<int> records)
+    {
+        std::stringstream stream(recording(records));
+        workload::replayer replayer;
+        return replayer.load(stream);
+    };
+
+    CHECK(loads({4, 0, 1, 0, 1, 'a', 7, 0, 1, 0, 0, 5, 0}));
+
+    CHECK(!loads({4, 1})); // not the next object
+    CHECK(!loads({5, 0})); // never created
+    CHECK(!loads({4, 0, 5, 0, 5, 0})); // destroyed twice
+    CHECK(!loads({4, 0, 6, 0, 3})); // moved from an unknown object
+    CHECK(!loads({4, 0, 7, 0, 1, 2, 0})); // unknown mixin
+    CHECK(!loads({1, 0, 1, 'a', 2, 0, 1, 1})); // type with an unknown mixin
+    CHECK(!loads({1, 2, 1, 'a'})); // not the next mixin
+    CHECK(!loads({4, 0, 8, 0, 0})); // unknown type
+    CHECK(!loads({4, 0, 9, 0, 0})); // unknown message
+    CHECK(!loads({1, 0, 100, 'a'})); // name longer than the stream
+    CHECK(!loads({4, 0, 7, 0, 0x80})); // truncated
+}
+
+class physics
+{
+public:
+    void update(float) {}
+};
+
+class render
+{
+public:
+    void update(float) {}
+    int layer() const { return 1; }
+};
+
+class ai
+{
+public:
+    void update(float) {}
+};
+
+DYNAMIX_DEFINE_MIXIN(physics, update_msg);
+DYNAMIX_DEFINE_MIXIN(render, update_msg & layer_msg);
+DYNAMIX_DEFINE_MIXIN(ai, update_msg);
+
+DYNAMIX_DEFINE_MESSAGE(update);
+DYNAMIX_DEFINE_MESSAGE(layer);
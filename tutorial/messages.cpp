@@ -136,6 +136,13 @@ one)
 
 DYNAMIX_CONST_MULTICAST_MESSAGE_1(void, trace, ostream&, out);
 
+/*`
+Arguments of multicast messages which are declared by value (except scalars)
+are passed by const reference to all of the mixins which handle the message, so
+they are not copied for each of them. Methods which take them by const reference
+don't copy them at all.
+*/
+
 /*`
 The last type of message there is meant for overloaded methods. For these we
 need message overloads.